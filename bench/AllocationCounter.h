@@ -0,0 +1,56 @@
+#pragma once
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+/**
+ * @brief Counting replacement of the global operator new / delete.
+ * @details
+ * Shared by the benchmark harness (allocs/op) and the zero-allocation test.
+ * Heap calls are counted process-wide and per calling thread, so a caller can
+ * ignore allocations made by other threads. Replacing the global allocator is
+ * a whole-program decision: include this header in exactly one translation
+ * unit of a benchmark or test executable. It lives under bench/ so the src/
+ * header glob never attaches it to the engine or library targets.
+ */
+namespace OrderEngine {
+namespace AllocationCounter {
+
+    inline std::atomic<uint64_t> gAllocations{0};
+    inline thread_local uint64_t tAllocations = 0;
+    inline thread_local uint64_t tDeallocations = 0;
+
+    // Heap allocations made so far by the whole process
+    inline uint64_t processAllocations() { return gAllocations.load(std::memory_order_relaxed); }
+
+    // Heap allocations / deallocations made so far by the calling thread
+    inline uint64_t threadAllocations() { return tAllocations; }
+    inline uint64_t threadDeallocations() { return tDeallocations; }
+
+} // namespace AllocationCounter
+} // namespace OrderEngine
+
+// Kept out of line: inlined into callers, malloc / free would pair with new / delete expressions there
+[[gnu::noinline]] void* operator new(std::size_t size) {
+    OrderEngine::AllocationCounter::gAllocations.fetch_add(1, std::memory_order_relaxed);
+    ++OrderEngine::AllocationCounter::tAllocations;
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) { return ::operator new(size); }
+
+// Every form pairs with its own new form; only the scalar pair touches malloc / free
+[[gnu::noinline]] void operator delete(void* ptr) noexcept {
+    if (ptr) ++OrderEngine::AllocationCounter::tDeallocations;
+    std::free(ptr);
+}
+void operator delete[](void* ptr) noexcept { ::operator delete(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { ::operator delete(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { ::operator delete[](ptr); }
+
+#endif // ALLOCATION_COUNTER_H
@@ -0,0 +1,124 @@
+#pragma once
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include "AllocationCounter.h"
+#include "../src/PerfCounters.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+/**
+ * @brief Minimal self-contained micro-benchmark harness.
+ * @details
+ * Each .cpp under bench/ builds into its own executable (see BUILD_BENCHMARKS in
+ * CMakeLists.txt). A benchmark body is a callable run `iterations` times after
+ * a short warm-up; results are printed as one aligned line per case.
+ * Heap allocations are counted by the global allocator of AllocationCounter.h,
+ * so this header must be included by exactly one translation unit of an executable.
+ * With BENCH_PERF set in the environment every case also prints hardware
+ * counters per operation (see src/PerfCounters.h).
+ */
+namespace Bench {
+
+    // Heap allocations made so far by the whole process
+    inline uint64_t allocationCount() { return OrderEngine::AllocationCounter::processAllocations(); }
+
+    // Keeps the compiler from optimising a computed value away
+    template<typename T> inline void doNotOptimize(T const& value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    struct Result {
+        std::string name;
+        uint64_t iterations;
+        double ns_per_op;
+        double allocs_per_op;
+    };
+
+    inline void printHeader(const char* title) {
+        std::printf("\n%s\n%-48s %14s %12s %12s\n", title, "benchmark", "iterations", "ns/op", "allocs/op");
+    }
+
+    inline void printResult(const Result& result) {
+        std::printf("%-48s %14llu %12.1f %12.2f\n", result.name.c_str(),
+                    static_cast<unsigned long long>(result.iterations), result.ns_per_op, result.allocs_per_op);
+    }
+
+    // Counter totals of the timed part when BENCH_PERF is set, otherwise null
+    inline OrderEngine::PerfTotals* perfTotals(OrderEngine::PerfTotals& totals) {
+        static const bool requested = std::getenv("BENCH_PERF") != nullptr;
+        return requested ? &totals : nullptr;
+    }
+
+    inline void printPerf(const OrderEngine::PerfTotals& totals, uint64_t operations) {
+        if (totals.operations() == 0 || operations == 0) return;
+        const auto& group = OrderEngine::PerfCounterGroup::forThisThread();
+        std::printf("%48s", "per op:");
+        for (size_t i = 0; i < OrderEngine::PERF_EVENT_COUNT; ++i) {
+            auto event = static_cast<OrderEngine::PerfEvent>(i);
+            if (!group.available(event)) continue;
+            std::printf("  %s %.1f", OrderEngine::perfEventName(event),
+                        static_cast<double>(totals.total(event)) / static_cast<double>(operations));
+        }
+        std::printf("\n");
+    }
+
+    template<typename Fn> Result run(const std::string& name, uint64_t iterations, Fn&& fn) {
+        uint64_t warmup = iterations / 10 + 1;
+        for (uint64_t i = 0; i < warmup; ++i) fn();
+
+        OrderEngine::PerfTotals perf;
+        uint64_t allocsBefore = allocationCount();
+        auto start = std::chrono::steady_clock::now();
+        {
+            OrderEngine::ScopedPerfSample counters(perfTotals(perf));
+            for (uint64_t i = 0; i < iterations; ++i) fn();
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        uint64_t allocs = allocationCount() - allocsBefore;
+
+        Result result{name, iterations,
+            std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(iterations),
+            static_cast<double>(allocs) / static_cast<double>(iterations)};
+        printResult(result);
+        printPerf(perf, iterations);
+        return result;
+    }
+
+    /**
+     * @brief Time operations that need fresh state, e.g. removing orders that must exist first.
+     * @details `setup()` runs untimed before every round, `body()` performs `opsPerRound`
+     * operations and is the only part timed and allocation-counted.
+     */
+    template<typename Setup, typename Body>
+    Result runRounds(const std::string& name, uint64_t rounds, uint64_t opsPerRound, Setup&& setup, Body&& body) {
+        std::chrono::steady_clock::duration elapsed{};
+        uint64_t allocs = 0;
+        OrderEngine::PerfTotals perf;
+        for (uint64_t round = 0; round < rounds; ++round) {
+            setup();
+            uint64_t allocsBefore = allocationCount();
+            auto start = std::chrono::steady_clock::now();
+            {
+                OrderEngine::ScopedPerfSample counters(perfTotals(perf));
+                body();
+            }
+            elapsed += std::chrono::steady_clock::now() - start;
+            allocs += allocationCount() - allocsBefore;
+        }
+
+        double ops = static_cast<double>(rounds * opsPerRound);
+        Result result{name, rounds * opsPerRound,
+            std::chrono::duration<double, std::nano>(elapsed).count() / ops,
+            static_cast<double>(allocs) / ops};
+        printResult(result);
+        printPerf(perf, rounds * opsPerRound);
+        return result;
+    }
+
+} // namespace Bench
+
+#endif // BENCH_HARNESS_H
@@ -0,0 +1,23 @@
+#include "BenchHarness.h"
+#include "../src/Clock.h"
+#include <memory>
+
+using namespace OrderEngine;
+
+// Cost of one timestamp from each Clock, called through the interface as OrderBook does
+int main() {
+    const uint64_t iterations = 5000000;
+    const std::pair<const char*, std::shared_ptr<Clock>> clocks[] = {
+        {"SystemClock (high_resolution_clock::now)", std::make_shared<SystemClock>()},
+        {"TscClock", std::make_shared<TscClock>()},
+        {"CoarseClock (100 us refresh)", std::make_shared<CoarseClock>()},
+        {"ManualClock", std::make_shared<ManualClock>()},
+    };
+
+    Bench::printHeader("Clock::now through the interface");
+    for (const auto& entry : clocks) {
+        const Clock& clock = *entry.second;
+        Bench::run(entry.first, iterations, [&] { Bench::doNotOptimize(clock.now()); });
+    }
+    return 0;
+}
@@ -0,0 +1,134 @@
+#include "BenchHarness.h"
+#include "../src/DepthTracker.h"
+#include <iomanip>
+#include <sstream>
+
+using namespace OrderEngine;
+using OrderPtr = std::shared_ptr<Order>;
+using Depth = DeepDepth;
+
+// ========== Reference iostream implementation (pre FormatBuffer) ==========
+
+namespace Legacy {
+    std::string levelToString(const DepthLevel& level) {
+        std::ostringstream oss;
+        oss << "$" << std::fixed << std::setprecision(2) << (level.price / 100.0)
+            << " | " << level.quantity << " shares | " << level.order_count << " orders";
+        return oss.str();
+    }
+
+    std::string toString(const Depth& depth) {
+        std::ostringstream oss;
+        oss << "\n=== Market Depth ===\n";
+        oss << "BIDS (" << depth.bid_count() << " levels):\n";
+        for (size_t i = 0; i < depth.bid_count(); ++i) {
+            oss << "  [" << i << "] " << levelToString(depth.bid_levels()[i]) << "\n";
+        }
+        oss << "ASKS (" << depth.ask_count() << " levels):\n";
+        for (size_t i = 0; i < depth.ask_count(); ++i) {
+            oss << "  [" << i << "] " << levelToString(depth.ask_levels()[i]) << "\n";
+        }
+        oss << "Spread: $" << std::fixed << std::setprecision(2) << (depth.spread() / 100.0);
+        oss << ", Mid: $" << (depth.mid_price() / 100.0) << "\n";
+        return oss.str();
+    }
+
+    std::string formatMarketDepth(const Depth& depth, size_t max_levels = 10) {
+        const auto& bids = depth.bid_levels();
+        const auto& asks = depth.ask_levels();
+        std::ostringstream oss;
+        oss << "\n" << std::string(60, '=') << "\n";
+        oss << std::setw(30) << "MARKET DEPTH" << std::setw(30) << "\n";
+        oss << std::string(60, '=') << "\n";
+        oss << std::left << std::setw(15) << "BID SIZE" << std::setw(10) << "BID"
+            << std::setw(10) << "ASK" << std::setw(15) << "ASK SIZE" << std::setw(10) << "ORDERS" << "\n";
+        oss << std::string(60, '-') << "\n";
+        size_t max_display = std::min(max_levels, std::max(depth.bid_count(), depth.ask_count()));
+        for (size_t i = 0; i < max_display; ++i) {
+            if (i < depth.bid_count()) {
+                oss << std::right << std::setw(10) << bids[i].quantity
+                    << "(" << std::setw(2) << bids[i].order_count << ")";
+                oss << std::setw(10) << std::fixed << std::setprecision(2) << (bids[i].price / 100.0);
+            } else {
+                oss << std::setw(15) << " " << std::setw(10) << " ";
+            }
+            if (i < depth.ask_count()) {
+                oss << std::setw(10) << std::fixed << std::setprecision(2) << (asks[i].price / 100.0);
+                oss << std::setw(10) << asks[i].quantity << "(" << std::setw(2) << asks[i].order_count << ")";
+            } else {
+                oss << std::setw(10) << " " << std::setw(15) << " ";
+            }
+            oss << "\n";
+        }
+        oss << std::string(60, '=') << "\n";
+        return oss.str();
+    }
+}
+
+// Builds a depth snapshot with `bid_levels` bid and `ask_levels` ask levels
+static Depth makeDepth(size_t bid_levels, size_t ask_levels) {
+    OrderTracker<OrderPtr> bids(true);
+    OrderTracker<OrderPtr> asks(false);
+    OrderId id = 1;
+    for (size_t i = 0; i < bid_levels; ++i) {
+        for (size_t n = 0; n <= i % 3; ++n) {
+            bids.addOrder(std::make_shared<Order>(id++, "INFY", OrderSide::BUY, 100 + 37 * i, 150000 - 5 * i));
+        }
+    }
+    for (size_t i = 0; i < ask_levels; ++i) {
+        asks.addOrder(std::make_shared<Order>(id++, "INFY", OrderSide::SELL, 2500 + 11 * i, 150005 + 5 * i));
+    }
+    Depth depth;
+    depth.update_from_tracker(bids, asks);
+    return depth;
+}
+
+static bool verifyIdentical(const Depth& depth) {
+    FormatBuffer out;
+    depth.format_to(out);
+    bool same = out.view() == Legacy::toString(depth);
+    out.clear();
+    depth.format_market_depth_to(out);
+    same = same && out.view() == Legacy::formatMarketDepth(depth);
+    return same;
+}
+
+int main() {
+    const Depth full = makeDepth(10, 10);
+    const Depth asksOnly = makeDepth(0, 7);
+
+    if (!verifyIdentical(full) || !verifyIdentical(asksOnly)) {
+        std::fprintf(stderr, "FormatBuffer output differs from the iostream reference\n");
+        return 1;
+    }
+
+    const uint64_t iterations = 200000;
+    FormatBuffer buffer(4096);
+
+    Bench::printHeader("Depth text formatting (10x10 levels)");
+    Bench::run("legacy DepthLevel::ToString", iterations, [&] {
+        Bench::doNotOptimize(Legacy::levelToString(full.bid_levels()[0]));
+    });
+    Bench::run("FormatBuffer DepthLevel::format_to", iterations, [&] {
+        buffer.clear();
+        full.bid_levels()[0].format_to(buffer);
+        Bench::doNotOptimize(buffer.data());
+    });
+    Bench::run("legacy to_string", iterations, [&] {
+        Bench::doNotOptimize(Legacy::toString(full));
+    });
+    Bench::run("FormatBuffer format_to", iterations, [&] {
+        buffer.clear();
+        full.format_to(buffer);
+        Bench::doNotOptimize(buffer.data());
+    });
+    Bench::run("legacy format_market_depth", iterations, [&] {
+        Bench::doNotOptimize(Legacy::formatMarketDepth(full));
+    });
+    Bench::run("FormatBuffer format_market_depth_to", iterations, [&] {
+        buffer.clear();
+        full.format_market_depth_to(buffer);
+        Bench::doNotOptimize(buffer.data());
+    });
+    return 0;
+}
@@ -0,0 +1,133 @@
+#include "BenchHarness.h"
+#include "../src/FixParser.h"
+#include <map>
+#include <random>
+
+using namespace OrderEngine;
+
+// ========== Reference tag map implementation ==========
+
+namespace Legacy {
+    // Split every field into a map of owned strings, then convert the ones needed
+    bool parse(const char* data, size_t size, Fix::OrderMessage& message, size_t& consumed,
+               std::map<int, std::string>& fields) {
+        fields.clear();
+        size_t pos = 0;
+        unsigned sum = 0;
+        while (pos < size) {
+            size_t equals = std::string_view(data, size).find('=', pos);
+            size_t soh = std::string_view(data, size).find(Fix::SOH, pos);
+            if (equals == std::string_view::npos || soh == std::string_view::npos) return false;
+            int tag = std::stoi(std::string(data + pos, equals - pos));
+            if (tag == 10) {
+                if (static_cast<unsigned>(std::stoi(std::string(data + equals + 1, soh - equals - 1))) != sum % 256)
+                    return false;
+                consumed = soh + 1;
+                break;
+            }
+            for (size_t i = pos; i <= soh; ++i) sum += static_cast<uint8_t>(data[i]);
+            fields[tag] = std::string(data + equals + 1, soh - equals - 1);
+            pos = soh + 1;
+        }
+        if (fields[8] != "FIX.4.4") return false;
+        message.type = static_cast<Fix::MsgType>(fields[35][0]);
+        message.order_id = std::stoull(fields[11]);
+        if (fields.count(41)) message.orig_order_id = std::stoull(fields[41]);
+        message.symbol = fields[55];
+        message.side = fields[54] == "1" ? OrderSide::BUY : OrderSide::SELL;
+        if (fields.count(38)) message.quantity = static_cast<Quantity>(std::stod(fields[38]));
+        if (fields.count(44)) message.price = static_cast<Price>(std::stod(fields[44]) * 100.0 + 0.5);
+        return true;
+    }
+}
+
+// Mixed order entry traffic: 70% new orders, 20% cancels, 10% replaces
+static std::string makeStream(size_t messages) {
+    std::mt19937_64 rng(42);
+    std::string stream;
+    const char* symbols[] = {"INFY", "TCS", "RELIANCE", "HDFCBANK"};
+    for (size_t i = 1; i <= messages; ++i) {
+        const char* symbol = symbols[rng() % 4];
+        OrderSide side = rng() % 2 ? OrderSide::BUY : OrderSide::SELL;
+        Price price = 150000 + static_cast<Price>(rng() % 2000);
+        unsigned kind = rng() % 10;
+        if (kind < 7) {
+            stream += Fix::newOrderSingle(i, i, symbol, side, 1 + rng() % 500, price);
+            continue;
+        }
+        Fix::MessageBuilder builder;
+        builder.field(35, kind < 9 ? "F" : "G").field(49, "CLIENT").field(56, "ENGINE").field(34, i)
+               .field(11, i).field(41, i / 2 + 1).field(55, symbol).field(54, side == OrderSide::BUY ? "1" : "2");
+        if (kind == 9) builder.field(38, 1 + rng() % 500).field(40, "2").price(44, price);
+        stream += builder.finish();
+    }
+    return stream;
+}
+
+template<typename Scanner> static size_t parseAll(const std::string& stream) {
+    size_t parsed = 0;
+    Fix::parseStream<Scanner>(stream.data(), stream.size(),
+                              [&](const Fix::OrderMessage&) { ++parsed; },
+                              [](Fix::ParseStatus, const Fix::OrderMessage&) {});
+    return parsed;
+}
+
+static void printThroughput(const Bench::Result& result, size_t bytes, size_t messages) {
+    double seconds = result.ns_per_op * 1e-9;
+    std::printf("%48s  %.0f MB/s, %.2f M msgs/s, %.1f ns/msg\n", "", static_cast<double>(bytes) / seconds / 1e6,
+                static_cast<double>(messages) / seconds / 1e6, result.ns_per_op / static_cast<double>(messages));
+}
+
+int main() {
+    const size_t messages = 10000;
+    const std::string stream = makeStream(messages);
+
+    // Both paths must decode the same orders
+    std::map<int, std::string> fields;
+    size_t offset = 0, checked = 0;
+    bool same = parseAll<Fix::DelimiterScanner>(stream) == messages &&
+                parseAll<Fix::ScalarDelimiterScanner>(stream) == messages;
+    while (same && offset < stream.size()) {
+        Fix::OrderMessage fast, legacy;
+        size_t fastLength = 0, legacyLength = 0;
+        same = Fix::parse(stream.data() + offset, stream.size() - offset, fast, fastLength) == Fix::ParseStatus::OK &&
+               Legacy::parse(stream.data() + offset, stream.size() - offset, legacy, legacyLength, fields) &&
+               fastLength == legacyLength && fast.type == legacy.type && fast.order_id == legacy.order_id &&
+               fast.orig_order_id == legacy.orig_order_id && fast.side == legacy.side &&
+               fast.quantity == legacy.quantity && fast.price == legacy.price;
+        offset += fastLength;
+        ++checked;
+    }
+    if (!same || checked != messages) {
+        std::fprintf(stderr, "FIX parser disagrees with the tag map reference at message %zu\n", checked);
+        return 1;
+    }
+
+    const uint64_t passes = 50;
+    std::printf("stream: %zu bytes, %.1f bytes/msg\n", stream.size(),
+                static_cast<double>(stream.size()) / static_cast<double>(messages));
+    Bench::printHeader("FIX 4.4 order entry parsing (10000 messages per op)");
+
+    auto legacy = Bench::run("tag map (std::map<int, std::string>)", passes / 5, [&] {
+        size_t at = 0;
+        while (at < stream.size()) {
+            Fix::OrderMessage message;
+            size_t length = 0;
+            if (!Legacy::parse(stream.data() + at, stream.size() - at, message, length, fields)) break;
+            at += length;
+        }
+        Bench::doNotOptimize(at);
+    });
+    printThroughput(legacy, stream.size(), messages);
+
+    auto scalar = Bench::run("zero-copy, scalar scan", passes, [&] {
+        Bench::doNotOptimize(parseAll<Fix::ScalarDelimiterScanner>(stream));
+    });
+    printThroughput(scalar, stream.size(), messages);
+
+    auto simd = Bench::run("zero-copy, SSE2 scan", passes, [&] {
+        Bench::doNotOptimize(parseAll<Fix::DelimiterScanner>(stream));
+    });
+    printThroughput(simd, stream.size(), messages);
+    return 0;
+}
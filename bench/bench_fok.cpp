@@ -0,0 +1,98 @@
+#include "BenchHarness.h"
+#include "../src/OrderBook.h"
+#include <random>
+
+using namespace OrderEngine;
+using OrderPtr = std::shared_ptr<Order>;
+using Book = OrderBook<OrderPtr>;
+
+namespace {
+    constexpr Price BASE_PRICE = 150000;
+    constexpr Price TICK = 5;
+    constexpr Quantity LOT = 100;
+
+    OrderPtr makeOrder(OrderId id, OrderSide side, Quantity qty, Price price,
+                       TimeInForce tif = TimeInForce::GOOD_TILL_CANCELLED) {
+        return std::make_shared<Order>(id, "INFY", side, qty, price, OrderType::LIMIT, tif);
+    }
+
+    // `levels` ask levels of 3 x LOT starting at BASE_PRICE
+    void seedAsks(Book& book, size_t levels, OrderId& nextId) {
+        for (size_t i = 0; i < levels; ++i) {
+            for (int n = 0; n < 3; ++n) {
+                book.addOrder(makeOrder(nextId++, OrderSide::SELL, LOT, BASE_PRICE + static_cast<Price>(i) * TICK));
+            }
+        }
+    }
+}
+
+int main() {
+    const uint64_t iterations = 200000;
+    std::mt19937_64 rng(7);
+
+    for (size_t levels : {10, 100, 1000}) {
+        OrderId nextId = 1;
+        Book book("INFY");
+        seedAsks(book, levels, nextId);
+        const auto& asks = book.asks();
+
+        char title[96];
+        std::snprintf(title, sizeof(title), "FOK feasibility check, %zu ask levels", levels);
+        Bench::printHeader(title);
+
+        // Previous approach: materialise the tentative matches and sum them
+        Bench::run("walk via OrderTracker::matchQuantity", iterations / 10, [&] {
+            Price limit = BASE_PRICE + static_cast<Price>(rng() % levels) * TICK;
+            auto matches = asks.matchQuantity(limit, UINT64_MAX);
+            Quantity available = 0;
+            for (const auto& match : matches) available += match.second;
+            Bench::doNotOptimize(available);
+        });
+        Bench::run("LiquidityIndex quantity_through_price", iterations, [&] {
+            Price limit = BASE_PRICE + static_cast<Price>(rng() % levels) * TICK;
+            Bench::doNotOptimize(asks.quantity_through_price(limit));
+        });
+    }
+
+    // End-to-end FOK-heavy flow: 90% of FOK buys ask for more than is available
+    // through their limit and are killed, 10% fill and their liquidity is replenished.
+    for (size_t levels : {10, 100, 1000}) {
+        OrderId nextId = 1;
+        Book book("INFY");
+        seedAsks(book, levels, nextId);
+
+        char title[96];
+        std::snprintf(title, sizeof(title), "FOK-heavy addOrder flow, %zu ask levels", levels);
+        Bench::printHeader(title);
+
+        // One FOK per round so the refill after a fill stays in the untimed setup;
+        // the timed part is the FOK decision (and the sweep when it fills) only
+        uint64_t fills = 0;
+        OrderPtr fok;
+        bool refill = false;
+        Bench::runRounds("addOrder FOK (90% killed)", iterations, 1,
+            [&] {
+                if (refill) {
+                    // Put back what was taken, one lot at a time from the best price
+                    for (Quantity left = fok->quantity(); left > 0; left -= std::min(left, LOT)) {
+                        Price price = BASE_PRICE;
+                        while (book.asks().quantity_at_price(price) >= 3 * LOT) price += TICK;
+                        book.addOrder(makeOrder(nextId++, OrderSide::SELL, std::min(left, LOT), price));
+                    }
+                }
+                size_t depth = 1 + rng() % std::min<size_t>(levels, 20);
+                Price limit = BASE_PRICE + static_cast<Price>(depth - 1) * TICK;
+                bool feasible = rng() % 10 == 0;
+                Quantity qty = feasible ? LOT * 3 * depth / 2 : LOT * 3 * depth + 1;
+                fok = makeOrder(nextId++, OrderSide::BUY, qty, limit, TimeInForce::FILL_OR_KILL);
+            },
+            [&] {
+                refill = book.addOrder(fok);
+                if (refill) ++fills;
+            });
+        std::printf("  filled %llu FOK orders, book total %llu\n",
+                    static_cast<unsigned long long>(fills),
+                    static_cast<unsigned long long>(book.asks().total_quantity()));
+    }
+    return 0;
+}
@@ -0,0 +1,48 @@
+#include "BenchHarness.h"
+#include "../src/OrderBook.h"
+#include "../src/OrderFlowGenerator.h"
+
+using namespace OrderEngine;
+using OrderPtr = std::shared_ptr<Order>;
+using Book = OrderBook<OrderPtr>;
+
+namespace {
+    constexpr size_t EVENTS = 200000;
+
+    // Replay a pre-generated flow (generation stays outside the timed region)
+    void replay(const char* name, const OrderFlowConfig& config) {
+        auto events = OrderFlowGenerator(config).generate(EVENTS);
+        std::vector<std::unique_ptr<Book>> books;
+        Bench::runRounds(name, 5, EVENTS,
+            [&] {
+                books.clear();
+                for (const auto& symbol : config.symbols) books.push_back(std::make_unique<Book>(symbol));
+            },
+            [&] {
+                for (const auto& event : events) applyFlowEvent(*books[event.symbol_index], event);
+            });
+    }
+}
+
+int main() {
+    Bench::printHeader("OrderBook driven by synthetic flow (per event)");
+
+    OrderFlowConfig config;
+    config.seed = 2024;
+    replay("poisson, 1 symbol", config);
+
+    config.arrivals = OrderFlowConfig::Arrivals::HAWKES;
+    replay("hawkes, 1 symbol", config);
+
+    config.symbols = {"INFY", "TCS", "WIPRO", "HDFC", "RELIANCE", "ITC", "SBIN", "LT"};
+    replay("hawkes, 8 symbols, zipf 1.0", config);
+
+    config.cancel_weight = 0.60;
+    config.add_weight = 0.35;
+    config.market_weight = 0.02;
+    replay("hawkes, 8 symbols, cancel heavy", config);
+
+    config.distance_exponent = 1.5;
+    replay("hawkes, 8 symbols, deep book", config);
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include "BenchHarness.h"
+#include "../src/OrderTracker.h"
+#include <algorithm>
+#include <random>
+
+using namespace OrderEngine;
+using OrderPtr = std::shared_ptr<Order>;
+using Tracker = OrderTracker<OrderPtr>;
+
+namespace {
+    constexpr Price BASE_PRICE = 150000;
+    constexpr Price TICK = 5;
+    constexpr Quantity LOT = 100;
+    constexpr uint64_t OPS_PER_ROUND = 1000;
+
+    OrderPtr makeOrder(OrderId id, Quantity qty, Price price) {
+        return std::make_shared<Order>(id, "INFY", OrderSide::SELL, qty, price);
+    }
+
+    // Ask side of `levels` levels with `perLevel` orders of LOT each, ids from 1
+    struct SeededBook {
+        Tracker tracker{false};
+        std::vector<OrderPtr> orders;
+
+        SeededBook(size_t levels, size_t perLevel) {
+            orders.reserve(levels * perLevel);
+            OrderId id = 1;
+            for (size_t level = 0; level < levels; ++level) {
+                for (size_t n = 0; n < perLevel; ++n) {
+                    auto order = makeOrder(id++, LOT, BASE_PRICE + static_cast<Price>(level) * TICK);
+                    tracker.addOrder(order);
+                    orders.push_back(order);
+                }
+            }
+        }
+    };
+
+    void benchShape(size_t levels, size_t perLevel) {
+        char title[96];
+        std::snprintf(title, sizeof(title), "OrderTracker, %zu levels x %zu orders/level", levels, perLevel);
+        Bench::printHeader(title);
+
+        std::mt19937_64 rng(levels * 1000 + perLevel);
+        auto randomPrice = [&] { return BASE_PRICE + static_cast<Price>(rng() % levels) * TICK; };
+        const uint64_t rounds = 20;
+        const Quantity bookQty = static_cast<Quantity>(levels * perLevel) * LOT;
+
+        // addOrder: new orders joining existing levels
+        {
+            SeededBook book(levels, perLevel);
+            OrderId nextId = levels * perLevel + 1;
+            std::vector<OrderPtr> batch;
+            Bench::runRounds("addOrder (existing level)", rounds, OPS_PER_ROUND,
+                [&] {
+                    for (const auto& order : batch) book.tracker.remove_order(order);
+                    batch.clear();
+                    for (uint64_t i = 0; i < OPS_PER_ROUND; ++i) batch.push_back(makeOrder(nextId++, LOT, randomPrice()));
+                },
+                [&] {
+                    for (const auto& order : batch) book.tracker.addOrder(order);
+                });
+        }
+
+        // remove_order: cancel random resting orders, re-seeded every round
+        {
+            uint64_t ops = std::min<uint64_t>(OPS_PER_ROUND, levels * perLevel);
+            std::unique_ptr<SeededBook> book;
+            std::vector<OrderPtr> victims;
+            Bench::runRounds("remove_order (random)", rounds, ops,
+                [&] {
+                    book = std::make_unique<SeededBook>(levels, perLevel);
+                    victims = book->orders;
+                    std::shuffle(victims.begin(), victims.end(), rng);
+                    victims.resize(ops);
+                },
+                [&] {
+                    for (const auto& order : victims) book->tracker.remove_order(order);
+                });
+        }
+
+        SeededBook book(levels, perLevel);
+        std::vector<size_t> picks(4096);
+        for (auto& pick : picks) pick = rng() % book.orders.size();
+        size_t cursor = 0;
+
+        Bench::run("update_order_quantity", 200000, [&] {
+            const auto& order = book.orders[picks[cursor++ & 4095]];
+            book.tracker.update_order_quantity(order, order->open_quantity() == LOT ? LOT - 1 : LOT);
+        });
+
+        Bench::run("best_level", 1000000, [&] {
+            Bench::doNotOptimize(book.tracker.best_level());
+        });
+
+        Bench::run("matchQuantity (one order)", 100000, [&] {
+            Bench::doNotOptimize(book.tracker.matchQuantity(BASE_PRICE, LOT / 2));
+        });
+
+        Bench::run("matchQuantity (half the book)", std::max<uint64_t>(100, 2000000 / (levels * perLevel)), [&] {
+            Bench::doNotOptimize(book.tracker.matchQuantity(BASE_PRICE + static_cast<Price>(levels) * TICK, bookQty / 2));
+        });
+
+        // PriceLevel::fill_quantity: sweep a whole level, rebuilt every round
+        {
+            std::unique_ptr<PriceLevel<OrderPtr>> level;
+            Bench::runRounds("PriceLevel::fill_quantity (whole level)", 200, 1,
+                [&] {
+                    level = std::make_unique<PriceLevel<OrderPtr>>(BASE_PRICE);
+                    for (size_t n = 0; n < perLevel; ++n) level->add_order(makeOrder(n + 1, LOT, BASE_PRICE));
+                },
+                [&] {
+                    Bench::doNotOptimize(level->fill_quantity(static_cast<Quantity>(perLevel) * LOT));
+                });
+        }
+    }
+}
+
+int main() {
+    for (size_t levels : {10, 100, 1000}) {
+        for (size_t perLevel : {1, 10, 50}) {
+            benchShape(levels, perLevel);
+        }
+    }
+    return 0;
+}
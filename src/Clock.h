@@ -0,0 +1,127 @@
+#pragma once
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include "OrderTypes.h"
+#include "Tsc.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+namespace OrderEngine {
+
+    /**
+     * @brief Source of order and trade timestamps, injected into OrderBook.
+     * @details
+     * Every accepted order and every fill is stamped, so the clock sits on the hot
+     * path: pick the implementation for the deployment.
+     * - TscClock    : one RDTSC and a multiply-add (default)
+     * - CoarseClock : a relaxed load of a value refreshed by a background thread
+     * - ManualClock : set by the caller, for simulation and deterministic tests
+     * - SystemClock : high_resolution_clock::now(), a vDSO call per stamp
+     * All return Timestamp on the high_resolution_clock epoch, so stamps from
+     * different clocks stay comparable.
+     */
+    class Clock {
+    public:
+        virtual ~Clock() = default;
+        virtual Timestamp now() const = 0;
+
+        static Timestamp fromNanoseconds(int64_t ns) {
+            return Timestamp(std::chrono::duration_cast<Timestamp::duration>(std::chrono::nanoseconds(ns)));
+        }
+
+        static int64_t toNanoseconds(Timestamp timestamp) {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count();
+        }
+    };
+
+    class SystemClock : public Clock {
+    public:
+        Timestamp now() const override { return std::chrono::high_resolution_clock::now(); }
+    };
+
+    /**
+     * @brief Invariant-TSC clock anchored to the wall clock once, at construction.
+     * @details
+     * Tick rate comes from Tsc::ticks_per_ns() (calibrated once per process, ~10 ms).
+     * The two clocks are not re-synchronised, so expect drift of a few ppm against
+     * NTP-disciplined wall time over long runs; intervals are what it is good at.
+     */
+    class TscClock : public Clock {
+    private:
+        int64_t base_ns_;
+        uint64_t base_ticks_;
+        double ns_per_tick_;
+
+    public:
+        TscClock() : ns_per_tick_(1.0 / Tsc::ticks_per_ns()) {
+            base_ticks_ = Tsc::now();
+            base_ns_ = toNanoseconds(std::chrono::high_resolution_clock::now());
+        }
+
+        Timestamp now() const override {
+            auto elapsed = static_cast<int64_t>(static_cast<double>(Tsc::now() - base_ticks_) * ns_per_tick_);
+            return fromNanoseconds(base_ns_ + elapsed);
+        }
+    };
+
+    /**
+     * @brief Cached wall clock refreshed every `resolution` by its own thread.
+     * @details Readers only load an atomic; stamps taken within one refresh
+     * interval are equal, so ordering within it comes from the book sequence.
+     */
+    class CoarseClock : public Clock {
+    private:
+        std::atomic<int64_t> now_ns_;
+        std::atomic<bool> running_{true};
+        std::thread refresher_;
+
+    public:
+        explicit CoarseClock(std::chrono::microseconds resolution = std::chrono::microseconds(100))
+            : now_ns_(toNanoseconds(std::chrono::high_resolution_clock::now())) {
+            refresher_ = std::thread([this, resolution] {
+                while (running_.load(std::memory_order_relaxed)) {
+                    std::this_thread::sleep_for(resolution);
+                    now_ns_.store(toNanoseconds(std::chrono::high_resolution_clock::now()), std::memory_order_relaxed);
+                }
+            });
+        }
+
+        ~CoarseClock() override {
+            running_.store(false, std::memory_order_relaxed);
+            refresher_.join();
+        }
+
+        CoarseClock(const CoarseClock&) = delete;
+        CoarseClock& operator=(const CoarseClock&) = delete;
+
+        Timestamp now() const override { return fromNanoseconds(now_ns_.load(std::memory_order_relaxed)); }
+    };
+
+    /**
+     * @brief Clock that only moves when told to; safe to drive from another thread.
+     */
+    class ManualClock : public Clock {
+    private:
+        std::atomic<int64_t> now_ns_;
+
+    public:
+        explicit ManualClock(int64_t start_ns = 0) : now_ns_(start_ns) {}
+
+        Timestamp now() const override { return fromNanoseconds(now_ns_.load(std::memory_order_relaxed)); }
+
+        void set(int64_t ns) { now_ns_.store(ns, std::memory_order_relaxed); }
+        void advance(int64_t ns) { now_ns_.fetch_add(ns, std::memory_order_relaxed); }
+    };
+
+    // Process-wide TscClock shared by books that were not given a clock
+    inline std::shared_ptr<Clock> defaultClock() {
+        static const std::shared_ptr<Clock> clock = std::make_shared<TscClock>();
+        return clock;
+    }
+
+} // namespace OrderEngine
+
+#endif // CLOCK_H
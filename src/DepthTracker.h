@@ -4,8 +4,10 @@
 
 #include "OrderTypes.h"
 #include "OrderTracker.h"
-#include <sstream>
-#include <iomanip>
+#include "Listeners.h"
+#include "FormatBuffer.h"
+#include <array>
+#include <unordered_map>
 
 namespace OrderEngine {
 
@@ -46,11 +48,158 @@ namespace OrderEngine {
             return !(*this == other);
         }
         
+        // Appends "$150.25 | 300 shares | 2 orders"
+        void format_to(FormatBuffer& out) const {
+            out.append('$').append_price(price)
+               .append(" | ").append_uint(quantity)
+               .append(" shares | ").append_uint(order_count)
+               .append(" orders");
+        }
+
         std::string ToString() const {
-            std::ostringstream oss;
-            oss << "$" << std::fixed << std::setprecision(2) << (price / 100.0) 
-                << " | " << quantity << " shares | " << order_count << " orders";
-            return oss.str();
+            FormatBuffer out(64);
+            format_to(out);
+            return out.str();
+        }
+    };
+
+    /**
+     * @brief Market depth aggregated into coarser price buckets (tick grouping).
+     * @details
+     * Each bucket spans `bucket_width` price units (e.g. 5 ticks of 5 paisa = 25).
+     * Bids are grouped down to the bucket floor and asks up to the bucket ceiling,
+     * so a grouped level never advertises a better price than the liquidity in it.
+     * Bucket totals are maintained from level deltas in O(1); the sorted top
+     * MAX_LEVELS view is rebuilt lazily on the first read after a change.
+     *
+     * BUCKET WIDTH 50:
+     * ┌──────────────┬─────────────┐      ┌──────────────┬─────────────┐
+     * │ Bid Level    │ Qty         │      │ Bid Bucket   │ Qty         │
+     * ├──────────────┼─────────────┤  =>  ├──────────────┼─────────────┤
+     * │ 15040, 15010 │ 300, 200    │      │ 15000        │ 500         │
+     * │ 14990        │ 100         │      │ 14950        │ 100         │
+     * └──────────────┴─────────────┘      └──────────────┴─────────────┘
+     */
+    template<size_t MAX_LEVELS = 10> class GroupedDepth {
+    public:
+        using DepthArray = std::array<DepthLevel, MAX_LEVELS>;
+        using BucketMap = std::unordered_map<Price, DepthLevel>;
+
+    private:
+        Price bucket_width_;
+        BucketMap bid_buckets_;         // Bucket price -> aggregated bid level
+        BucketMap ask_buckets_;         // Bucket price -> aggregated ask level
+
+        // Sorted view, rebuilt on read when dirty_
+        mutable DepthArray bid_levels_;
+        mutable DepthArray ask_levels_;
+        mutable size_t bid_count_;
+        mutable size_t ask_count_;
+        mutable bool dirty_;
+
+    public:
+        explicit GroupedDepth(Price bucket_width) 
+            : bucket_width_(bucket_width > 0 ? bucket_width : 1),
+              bid_count_(0), ask_count_(0), dirty_(false) {}
+
+        Price bucket_width() const { return bucket_width_; }
+
+        // Bucket a level price falls into (bids round down, asks round up)
+        Price bucket_price(bool is_bid, Price price) const {
+            Price floor = (price / bucket_width_) * bucket_width_;
+            if (is_bid || floor == price) return floor;
+            return floor + bucket_width_;
+        }
+
+        /**
+         * @brief Apply one level delta to its bucket. O(1) average.
+         * @details Same arguments as LevelChangeListener::on_level_change.
+         */
+        void apply_level_change(bool is_bid, Price price, Quantity old_qty, Quantity new_qty,
+                                size_t old_count, size_t new_count) {
+            auto& buckets = is_bid ? bid_buckets_ : ask_buckets_;
+            Price key = bucket_price(is_bid, price);
+            
+            DepthLevel& bucket = buckets[key];
+            bucket.price = key;
+            bucket.quantity = bucket.quantity + new_qty - old_qty;
+            bucket.order_count = bucket.order_count + new_count - old_count;
+            
+            if (bucket.quantity == 0 && bucket.order_count == 0) {
+                buckets.erase(key);
+            }
+            dirty_ = true;
+        }
+
+        // Seed buckets from the full ladder (used when a grouping is added mid-session)
+        template<typename OrderPtr>
+        void rebuild_from_tracker(const OrderTracker<OrderPtr>& tracker) {
+            bool is_bid = tracker.is_buy_side();
+            (is_bid ? bid_buckets_ : ask_buckets_).clear();
+            for (const auto& [price, price_level] : tracker.price_levels()) {
+                apply_level_change(is_bid, price, 0, price_level->total_quantity(),
+                                   0, price_level->order_count());
+            }
+            dirty_ = true;
+        }
+
+        // Direct bucket lookup, O(1) average
+        const DepthLevel& bucket_at(bool is_bid, Price bucket) const {
+            static DepthLevel empty_level;
+            const auto& buckets = is_bid ? bid_buckets_ : ask_buckets_;
+            auto it = buckets.find(bucket);
+            return it != buckets.end() ? it->second : empty_level;
+        }
+
+        // Sorted top MAX_LEVELS buckets
+        const DepthArray& bid_levels() const { refresh(); return bid_levels_; }
+        const DepthArray& ask_levels() const { refresh(); return ask_levels_; }
+        size_t bid_count() const { refresh(); return bid_count_; }
+        size_t ask_count() const { refresh(); return ask_count_; }
+
+        // Total number of non-empty buckets per side (not capped by MAX_LEVELS)
+        size_t bid_bucket_count() const { return bid_buckets_.size(); }
+        size_t ask_bucket_count() const { return ask_buckets_.size(); }
+
+        // Heap bytes of both bucket maps (the sorted view lives inline)
+        size_t memory_bytes() const { return hash_map_bytes(bid_buckets_) + hash_map_bytes(ask_buckets_); }
+
+        void clear() {
+            bid_buckets_.clear();
+            ask_buckets_.clear();
+            dirty_ = true;
+        }
+
+    private:
+        void refresh() const {
+            if (!dirty_) return;
+            select_top_levels(bid_buckets_, true, bid_levels_, bid_count_);
+            select_top_levels(ask_buckets_, false, ask_levels_, ask_count_);
+            dirty_ = false;
+        }
+
+        // Insertion-select the best MAX_LEVELS buckets, no allocation
+        static void select_top_levels(const BucketMap& buckets, bool is_bid,
+                                      DepthArray& levels, size_t& count) {
+            count = 0;
+            for (const auto& [price, bucket] : buckets) {
+                size_t pos = count;
+                while (pos > 0 && (is_bid ? price > levels[pos - 1].price 
+                                          : price < levels[pos - 1].price)) {
+                    --pos;
+                }
+                if (pos >= MAX_LEVELS) continue;
+                
+                size_t last = std::min(count, MAX_LEVELS - 1);
+                for (size_t i = last; i > pos; --i) {
+                    levels[i] = levels[i - 1];
+                }
+                levels[pos] = bucket;
+                if (count < MAX_LEVELS) ++count;
+            }
+            for (size_t i = count; i < MAX_LEVELS; ++i) {
+                levels[i].clear();
+            }
         }
     };
 
@@ -63,10 +212,14 @@ namespace OrderEngine {
      * detects changes between updates. It provides various utility functions
      * to access depth information, calculate market quality metrics,
      * and format the depth for display.
+     * 
+     * When registered as a LevelChangeListener on the trackers it also maintains
+     * any number of grouped (tick bucketed) views incrementally from level deltas.
      */
-    template<size_t MAX_LEVELS = 10> class DepthTracker {
+    template<size_t MAX_LEVELS = 10> class DepthTracker : public LevelChangeListener {
     public:
         using DepthArray = std::array<DepthLevel, MAX_LEVELS>;
+        using Grouping = GroupedDepth<MAX_LEVELS>;
         // Depth change information for listeners
         struct DepthChange {
             bool is_bid;
@@ -96,6 +249,9 @@ namespace OrderEngine {
         DepthArray prev_ask_levels_;
         size_t prev_bid_count_;
         size_t prev_ask_count_;
+
+        // Grouped views fed from level deltas
+        std::vector<Grouping> groupings_;
         
     public:
         DepthTracker() : bid_count_(0), ask_count_(0), changed_(false), 
@@ -105,6 +261,8 @@ namespace OrderEngine {
             for (auto& level : ask_levels_) level.clear();
             for (auto& level : prev_bid_levels_) level.clear();
             for (auto& level : prev_ask_levels_) level.clear();
+            // At most every level of both sides changes, so refreshes never grow it
+            changes_.reserve(2 * MAX_LEVELS);
         }
         
         // Update depth from order trackers
@@ -126,6 +284,47 @@ namespace OrderEngine {
             detect_changes();
         }
         
+        // ========== Grouped Views ==========
+
+        /**
+         * @brief Add a grouped view with the given bucket width (price units).
+         * @return Index of the grouping, stable for the lifetime of the tracker.
+         * @details
+         * Only deltas received after this call are applied; call 
+         * rebuild_groupings() to seed a grouping added to a non-empty book.
+         */
+        size_t add_grouping(Price bucket_width) {
+            groupings_.emplace_back(bucket_width);
+            return groupings_.size() - 1;
+        }
+
+        const Grouping& grouping(size_t index) const { return groupings_.at(index); }
+        size_t grouping_count() const { return groupings_.size(); }
+
+        // The tracker itself plus change records and grouped views, for MemoryFootprint::depth
+        size_t memory_bytes() const {
+            size_t bytes = sizeof(*this) + changes_.capacity() * sizeof(DepthChange) +
+                           groupings_.capacity() * sizeof(Grouping);
+            for (const auto& grouping : groupings_) bytes += grouping.memory_bytes();
+            return bytes;
+        }
+
+        template<typename OrderPtr>
+        void rebuild_groupings(const OrderTracker<OrderPtr>& bid_tracker,
+                            const OrderTracker<OrderPtr>& ask_tracker) {
+            for (auto& grouping : groupings_) {
+                grouping.rebuild_from_tracker(bid_tracker);
+                grouping.rebuild_from_tracker(ask_tracker);
+            }
+        }
+
+        void on_level_change(bool is_bid, Price price, Quantity old_qty, Quantity new_qty,
+                            size_t old_count, size_t new_count) override {
+            for (auto& grouping : groupings_) {
+                grouping.apply_level_change(is_bid, price, old_qty, new_qty, old_count, new_count);
+            }
+        }
+        
         // Get depth levels (const access)
         const DepthArray& bid_levels() const { return bid_levels_; }
         const DepthArray& ask_levels() const { return ask_levels_; }
@@ -198,6 +397,8 @@ namespace OrderEngine {
             return bid_count_ == 0 && ask_count_ == 0;
         }
         
+        // Resets the top-N view only: groupings mirror the trackers' levels through deltas,
+        // emptying their buckets here would break the next delta of a level still resting
         void clear() {
             for (auto& level : bid_levels_) level.clear();
             for (auto& level : ask_levels_) level.clear();
@@ -258,69 +459,85 @@ namespace OrderEngine {
         
         // Display/debugging
         std::string to_string() const {
-            std::ostringstream oss;
-            
-            oss << "\n=== Market Depth ===\n";
-            oss << "BIDS (" << bid_count_ << " levels):\n";
+            FormatBuffer out(256 + 64 * (bid_count_ + ask_count_));
+            format_to(out);
+            return out.str();
+        }
+
+        // Appends the to_string() text to a reusable buffer (no allocation once warm)
+        void format_to(FormatBuffer& out) const {
+            out.append("\n=== Market Depth ===\n");
+            out.append("BIDS (").append_uint(bid_count_).append(" levels):\n");
             for (size_t i = 0; i < bid_count_; ++i) {
-                oss << "  [" << i << "] " << bid_levels_[i].to_string() << "\n";
+                out.append("  [").append_uint(i).append("] ");
+                bid_levels_[i].format_to(out);
+                out.append('\n');
             }
             
-            oss << "ASKS (" << ask_count_ << " levels):\n";
+            out.append("ASKS (").append_uint(ask_count_).append(" levels):\n");
             for (size_t i = 0; i < ask_count_; ++i) {
-                oss << "  [" << i << "] " << ask_levels_[i].to_string() << "\n";
+                out.append("  [").append_uint(i).append("] ");
+                ask_levels_[i].format_to(out);
+                out.append('\n');
             }
             
-            oss << "Spread: $" << std::fixed << std::setprecision(2) << (spread() / 100.0);
-            oss << ", Mid: $" << (mid_price() / 100.0) << "\n";
-            
-            return oss.str();
+            out.append("Spread: $").append_price(spread());
+            out.append(", Mid: $").append_price(mid_price()).append('\n');
         }
         
         // Get formatted market depth table
         std::string format_market_depth(size_t max_levels = MAX_LEVELS) const {
-            std::ostringstream oss;
-            
+            FormatBuffer out(256 + 64 * std::min(max_levels, MAX_LEVELS));
+            format_market_depth_to(out, max_levels);
+            return out.str();
+        }
+
+        /**
+         * @brief Appends the format_market_depth() table to a reusable buffer.
+         * @details
+         * Byte-for-byte identical to the original iostream layout, including its
+         * alignment: columns stay left aligned (from the header) until the first
+         * bid row switches the stream to right alignment, so a book without bids
+         * prints its ask columns left aligned.
+         */
+        void format_market_depth_to(FormatBuffer& out, size_t max_levels = MAX_LEVELS) const {
             // Header
-            oss << "\n" << std::string(60, '=') << "\n";
-            oss << std::setw(30) << "MARKET DEPTH" << std::setw(30) << "\n";
-            oss << std::string(60, '=') << "\n";
-            oss << std::left << std::setw(15) << "BID SIZE" 
-                << std::setw(10) << "BID" 
-                << std::setw(10) << "ASK" 
-                << std::setw(15) << "ASK SIZE" 
-                << std::setw(10) << "ORDERS" << "\n";
-            oss << std::string(60, '-') << "\n";
+            out.append('\n').append_repeat('=', 60).append('\n');
+            out.append_padded("MARKET DEPTH", 30).append_padded("\n", 30);
+            out.append_repeat('=', 60).append('\n');
+            out.append_padded("BID SIZE", 15, false)
+               .append_padded("BID", 10, false)
+               .append_padded("ASK", 10, false)
+               .append_padded("ASK SIZE", 15, false)
+               .append_padded("ORDERS", 10, false).append('\n');
+            out.append_repeat('-', 60).append('\n');
             
             size_t max_display = std::min(max_levels, std::max(bid_count_, ask_count_));
+            bool right = bid_count_ > 0;
             
             for (size_t i = 0; i < max_display; ++i) {
                 // Bid side
                 if (i < bid_count_) {
-                    oss << std::right << std::setw(10) << bid_levels_[i].quantity 
-                        << "(" << std::setw(2) << bid_levels_[i].order_count << ")";
-                    oss << std::setw(10) << std::fixed << std::setprecision(2) 
-                        << (bid_levels_[i].price / 100.0);
+                    out.append_uint_padded(bid_levels_[i].quantity, 10, right)
+                       .append('(').append_uint_padded(bid_levels_[i].order_count, 2, right).append(')');
+                    out.append_price_padded(bid_levels_[i].price, 10, right);
                 } else {
-                    oss << std::setw(15) << " " << std::setw(10) << " ";
+                    out.append_repeat(' ', 25);
                 }
                 
                 // Ask side  
                 if (i < ask_count_) {
-                    oss << std::setw(10) << std::fixed << std::setprecision(2) 
-                        << (ask_levels_[i].price / 100.0);
-                    oss << std::setw(10) << ask_levels_[i].quantity 
-                        << "(" << std::setw(2) << ask_levels_[i].order_count << ")";
+                    out.append_price_padded(ask_levels_[i].price, 10, right);
+                    out.append_uint_padded(ask_levels_[i].quantity, 10, right)
+                       .append('(').append_uint_padded(ask_levels_[i].order_count, 2, right).append(')');
                 } else {
-                    oss << std::setw(10) << " " << std::setw(15) << " ";
+                    out.append_repeat(' ', 25);
                 }
                 
-                oss << "\n";
+                out.append('\n');
             }
             
-            oss << std::string(60, '=') << "\n";
-            
-            return oss.str();
+            out.append_repeat('=', 60).append('\n');
         }
 
     private:
@@ -0,0 +1,194 @@
+#pragma once
+#ifndef ENGINE_METRICS_H
+#define ENGINE_METRICS_H
+
+#include "MatchingEngine.h"
+#include "MetricsExporter.h"
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace OrderEngine {
+
+    /**
+     * @brief MetricsExporter collector for a MatchingEngine.
+     * @details
+     * Per book (labels book, shard): order / trade counters and their rates over
+     * the last snapshot, resting orders, levels and memory by component, and,
+     * once MatchingEngine::enableBookLatency() was called, operation latency.
+     * Per shard: requests processed and their rate, ingress / ack queue depth and
+     * service time. Everything is read from atomics or from the memory matchers
+     * publish themselves (refreshed for the next snapshot), so collecting never
+     * takes a book lock while the engine runs; a stopped engine is read directly.
+     * Latency summaries cover everything since start (quantiles 0.5 to 0.999).
+     */
+    class EngineMetrics {
+    private:
+        struct BookCounters {
+            uint64_t added = 0;
+            uint64_t trades = 0;
+        };
+
+        const MatchingEngine* engine_;
+        std::vector<std::string> shard_labels_;
+        std::vector<BookCounters> previous_books_;
+        std::vector<uint64_t> previous_processed_;
+        std::chrono::steady_clock::time_point previous_time_;
+        bool has_previous_ = false;
+
+        static double seconds(uint64_t ticks) { return static_cast<double>(Tsc::to_ns(ticks)) * 1e-9; }
+
+        static void summary(PrometheusText& out, std::string_view name, std::string_view label,
+                            std::string_view value, const LatencyHistogram& histogram) {
+            static constexpr std::pair<const char*, double> QUANTILES[] = {
+                {"0.5", 50.0}, {"0.9", 90.0}, {"0.99", 99.0}, {"0.999", 99.9}};
+            for (const auto& [quantile, percentile] : QUANTILES) {
+                out.sample(name, {{label, value}, {"quantile", quantile}}, seconds(histogram.percentile(percentile)));
+            }
+            std::string base(name);
+            out.sample(base + "_sum", {{label, value}}, seconds(histogram.sum()));
+            out.sample(base + "_count", {{label, value}}, histogram.count());
+        }
+
+    public:
+        explicit EngineMetrics(const MatchingEngine& engine)
+            : engine_(&engine), previous_books_(engine.books()), previous_processed_(engine.threads(), 0) {
+            for (size_t shard = 0; shard < engine.threads(); ++shard) shard_labels_.push_back(std::to_string(shard));
+        }
+
+        void operator()(PrometheusText& out) {
+            const MatchingEngine& engine = *engine_;
+            auto now = std::chrono::steady_clock::now();
+            double elapsed = has_previous_ ? std::chrono::duration<double>(now - previous_time_).count() : 0.0;
+            auto rate = [elapsed](uint64_t current, uint64_t previous) {
+                return elapsed > 0.0 ? static_cast<double>(current - previous) / elapsed : 0.0;
+            };
+
+            // Memory per book: published by the matchers while running, read directly once stopped
+            std::vector<MemoryFootprint> memory(engine.books());
+            bool running = engine.running();
+            for (size_t shard = 0; shard < engine.threads(); ++shard) {
+                const auto& books = engine.plan().books(shard);
+                auto published = engine.publishedMemory(shard);
+                for (size_t i = 0; i < books.size(); ++i) {
+                    if (!running) memory[books[i]] = engine.book(books[i]).memoryFootprint();
+                    else if (published && i < published->size()) memory[books[i]] = (*published)[i];
+                }
+            }
+
+            auto book_label = [&](size_t book) { return engine.book(book).symbol(); };
+            auto shard_label = [&](size_t book) -> const std::string& {
+                return shard_labels_[engine.plan().owner(book)];
+            };
+            auto per_book = [&](std::string_view name, std::string_view type, std::string_view help, auto value) {
+                out.family(name, type, help);
+                for (size_t book = 0; book < engine.books(); ++book) {
+                    out.sample(name, {{"book", book_label(book)}, {"shard", shard_label(book)}}, value(book));
+                }
+            };
+
+            per_book("ome_orders_added_total", "counter", "Orders accepted by the book",
+                     [&](size_t b) { return engine.book(b).stats().total_orders_added.load(std::memory_order_relaxed); });
+            per_book("ome_orders_cancelled_total", "counter", "Orders cancelled",
+                     [&](size_t b) { return engine.book(b).stats().total_orders_cancelled.load(std::memory_order_relaxed); });
+            per_book("ome_orders_replaced_total", "counter", "Orders replaced",
+                     [&](size_t b) { return engine.book(b).stats().total_orders_replaced.load(std::memory_order_relaxed); });
+            per_book("ome_orders_rejected_total", "counter", "Orders rejected",
+                     [&](size_t b) { return engine.book(b).stats().total_rejected.load(std::memory_order_relaxed); });
+            per_book("ome_trades_total", "counter", "Trades executed",
+                     [&](size_t b) { return engine.book(b).stats().total_trades.load(std::memory_order_relaxed); });
+            per_book("ome_traded_volume_total", "counter", "Quantity traded",
+                     [&](size_t b) { return engine.book(b).stats().total_volume.load(std::memory_order_relaxed); });
+
+            std::vector<BookCounters> books(engine.books());
+            for (size_t b = 0; b < engine.books(); ++b) {
+                books[b].added = engine.book(b).stats().total_orders_added.load(std::memory_order_relaxed);
+                books[b].trades = engine.book(b).stats().total_trades.load(std::memory_order_relaxed);
+            }
+            per_book("ome_orders_added_per_second", "gauge", "Orders accepted per second over the last snapshot interval",
+                     [&](size_t b) { return rate(books[b].added, previous_books_[b].added); });
+            per_book("ome_trades_per_second", "gauge", "Trades per second over the last snapshot interval",
+                     [&](size_t b) { return rate(books[b].trades, previous_books_[b].trades); });
+
+            per_book("ome_book_resting_orders", "gauge", "Orders resting in the book",
+                     [&](size_t b) { return static_cast<uint64_t>(memory[b].resting_orders); });
+            per_book("ome_book_price_levels", "gauge", "Non-empty price levels",
+                     [&](size_t b) { return static_cast<uint64_t>(memory[b].levels); });
+            per_book("ome_book_liquidity_index_nodes", "gauge", "Liquidity index nodes in use (prices holding liquidity)",
+                     [&](size_t b) { return static_cast<uint64_t>(memory[b].index_nodes); });
+
+            out.family("ome_book_memory_bytes", "gauge", "Heap bytes held by the book, by component");
+            for (size_t b = 0; b < engine.books(); ++b) {
+                const MemoryFootprint& f = memory[b];
+                const std::pair<const char*, size_t> components[] = {
+                    {"orders", f.orders}, {"price_levels", f.price_levels}, {"order_index", f.order_index},
+                    {"liquidity_index", f.liquidity_index}, {"stop_orders", f.stop_orders},
+                    {"pending_trades", f.pending_trades}, {"depth", f.depth}, {"other", f.other}};
+                for (const auto& [component, bytes] : components) {
+                    out.sample("ome_book_memory_bytes",
+                               {{"book", book_label(b)}, {"shard", shard_label(b)}, {"component", component}},
+                               static_cast<uint64_t>(bytes));
+                }
+            }
+
+            bool book_latency = engine.books() > 0 && engine.book(0).latency();
+            if (book_latency) {
+                out.family("ome_book_operation_seconds", "summary", "Book operation latency under the book lock");
+                for (size_t b = 0; b < engine.books(); ++b) {
+                    const OrderBookLatency* latency = engine.book(b).latency();
+                    const std::pair<const char*, const LatencyHistogram*> ops[] = {
+                        {"add", &latency->add}, {"cancel", &latency->cancel}, {"replace", &latency->replace}};
+                    for (const auto& [op, histogram] : ops) {
+                        static constexpr std::pair<const char*, double> QUANTILES[] = {
+                            {"0.5", 50.0}, {"0.99", 99.0}, {"0.999", 99.9}};
+                        for (const auto& [quantile, percentile] : QUANTILES) {
+                            out.sample("ome_book_operation_seconds",
+                                       {{"book", book_label(b)}, {"op", op}, {"quantile", quantile}},
+                                       seconds(histogram->percentile(percentile)));
+                        }
+                        out.sample("ome_book_operation_seconds_sum", {{"book", book_label(b)}, {"op", op}},
+                                   seconds(histogram->sum()));
+                        out.sample("ome_book_operation_seconds_count", {{"book", book_label(b)}, {"op", op}},
+                                   histogram->count());
+                    }
+                }
+            }
+
+            std::vector<uint64_t> processed(engine.threads());
+            for (size_t shard = 0; shard < engine.threads(); ++shard) processed[shard] = engine.processed(shard);
+            auto per_shard = [&](std::string_view name, std::string_view type, std::string_view help, auto value) {
+                out.family(name, type, help);
+                for (size_t shard = 0; shard < engine.threads(); ++shard) {
+                    out.sample(name, {{"shard", shard_labels_[shard]}}, value(shard));
+                }
+            };
+            per_shard("ome_matcher_requests_total", "counter", "Requests processed by the matcher thread",
+                      [&](size_t s) { return processed[s]; });
+            per_shard("ome_matcher_requests_per_second", "gauge", "Requests per second over the last snapshot interval",
+                      [&](size_t s) { return rate(processed[s], previous_processed_[s]); });
+            per_shard("ome_matcher_ingress_depth", "gauge", "Requests waiting in the ingress queue",
+                      [&](size_t s) { return static_cast<uint64_t>(engine.backlog(s)); });
+            per_shard("ome_matcher_ack_depth", "gauge", "Acks waiting to be polled",
+                      [&](size_t s) { return static_cast<uint64_t>(engine.ackBacklog(s)); });
+            per_shard("ome_matcher_queue_capacity", "gauge", "Slots of each ingress and ack queue",
+                      [&](size_t) { return static_cast<uint64_t>(engine.queueCapacity()); });
+
+            out.family("ome_matcher_service_seconds", "summary", "Time from dequeue to book operation done");
+            for (size_t shard = 0; shard < engine.threads(); ++shard) {
+                summary(out, "ome_matcher_service_seconds", "shard", shard_labels_[shard], engine.serviceLatency(shard));
+            }
+
+            out.family("ome_engine_shared_memory_bytes", "gauge", "Heap bytes of engine queues, not charged to books");
+            out.sample("ome_engine_shared_memory_bytes", {}, static_cast<uint64_t>(engine.sharedMemoryBytes()));
+
+            previous_books_ = std::move(books);
+            previous_processed_ = std::move(processed);
+            previous_time_ = now;
+            has_previous_ = true;
+            engine.requestMemoryRefresh(); // Published by the matchers in time for the next snapshot
+        }
+    };
+
+} // namespace OrderEngine
+
+#endif // ENGINE_METRICS_H
@@ -0,0 +1,103 @@
+#pragma once
+#ifndef FENWICK_TREE_H
+#define FENWICK_TREE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace OrderEngine {
+
+    /**
+     * @brief Binary indexed (Fenwick) tree over a fixed number of slots.
+     * @param T Additive value type. Unsigned types work with wrapping deltas
+     *          (new - old) as long as every slot's true value stays non-negative.
+     * @details
+     * Point update and prefix sum are O(log n); build from a plain array is O(n).
+     * Slots are 0-based in the public API, the tree itself is stored 1-based.
+     *
+     * SLOTS : [ 5 ][ 0 ][ 3 ][ 7 ]
+     * PREFIX:   5    5    8   15      prefix_sum(3) = 8
+     */
+    template<typename T> class FenwickTree {
+    private:
+        std::vector<T> tree_; // tree_[0] unused
+
+        static size_t lowbit(size_t i) { return i & (~i + 1); }
+
+    public:
+        FenwickTree() : tree_(1, T{}) {}
+        explicit FenwickTree(size_t size) : tree_(size + 1, T{}) {}
+
+        size_t size() const { return tree_.size() - 1; }
+
+        // Heap bytes held, by capacity
+        size_t memory_bytes() const { return tree_.capacity() * sizeof(T); }
+
+        void clear() { std::fill(tree_.begin(), tree_.end(), T{}); }
+
+        // Resize to `size` zeroed slots
+        void reset(size_t size) { tree_.assign(size + 1, T{}); }
+
+        // Rebuild from per-slot values in O(n)
+        void build(const std::vector<T>& values) {
+            tree_.assign(values.size() + 1, T{});
+            for (size_t i = 1; i < tree_.size(); ++i) {
+                tree_[i] += values[i - 1];
+                size_t parent = i + lowbit(i);
+                if (parent < tree_.size()) tree_[parent] += tree_[i];
+            }
+        }
+
+        // Append one slot holding `value`, O(log n)
+        void push_back(T value) {
+            size_t i = tree_.size();
+            // Node i covers slots (i - lowbit(i), i]; fold in the already stored part
+            T node = value + prefix_sum(i - 1) - prefix_sum(i - lowbit(i));
+            tree_.push_back(node);
+        }
+
+        void reserve(size_t size) { tree_.reserve(size + 1); }
+
+        // Add `delta` to 0-based `slot`
+        void add(size_t slot, T delta) {
+            for (size_t i = slot + 1; i < tree_.size(); i += lowbit(i)) {
+                tree_[i] += delta;
+            }
+        }
+
+        // Sum of the first `count` slots
+        T prefix_sum(size_t count) const {
+            T sum{};
+            for (size_t i = count < tree_.size() ? count : size(); i > 0; i -= lowbit(i)) {
+                sum += tree_[i];
+            }
+            return sum;
+        }
+
+        /**
+         * @brief Largest `count` such that prefix_sum(count) <= target.
+         * @details Binary descent in O(log n), requires non-negative slot values.
+         * The slot at index `count` (if any) is the first one that pushes the
+         * running sum above `target`.
+         */
+        size_t max_prefix_within(T target) const {
+            size_t n = size();
+            size_t step = 1;
+            while (step * 2 <= n) step *= 2;
+
+            size_t pos = 0;
+            for (; step > 0; step /= 2) {
+                size_t next = pos + step;
+                if (next <= n && !(target < tree_[next])) {
+                    pos = next;
+                    target -= tree_[next];
+                }
+            }
+            return pos;
+        }
+    };
+
+} // namespace OrderEngine
+
+#endif // FENWICK_TREE_H
@@ -0,0 +1,481 @@
+#pragma once
+#ifndef FIX_PARSER_H
+#define FIX_PARSER_H
+
+#include "Order.h"
+#include "OrderTypes.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace OrderEngine {
+namespace Fix {
+
+    /**
+     * FIX 4.4 order entry decoding (NewOrderSingle, OrderCancelRequest,
+     * OrderCancelReplaceRequest).
+     *
+     * A message is parsed in place: string fields come back as views into the
+     * caller's buffer and numeric fields are converted straight into the order
+     * types (Price in paisa, Quantity, OrderSide, OrderType, TimeInForce), with
+     * no copy and no allocation. BeginString, BodyLength and CheckSum are
+     * validated; tags the engine does not use are skipped.
+     *
+     * Delimiters are found with SSE2: every 64-byte block is compared against
+     * SOH and '=' once, giving two bitmasks, and each field boundary is then a
+     * count-trailing-zeros. A tag ends at the first '=' of its field and the
+     * value at the next SOH, so '=' inside a value (e.g. Text) is harmless.
+     *
+     * 8=FIX.4.4|9=120|35=D|49=CLIENT|56=ENGINE|34=7|11=1001|55=INFY|54=1|38=100|40=2|44=1501.25|59=0|...|10=093|
+     * |-- header --|--------------------------- BodyLength bytes -----------------------------------|-trailer-|
+     */
+
+    constexpr char SOH = '\x01';
+    constexpr std::string_view BEGIN_STRING = "8=FIX.4.4\x01";
+    constexpr size_t TRAILER_LENGTH = 7;           // "10=ddd" SOH
+    constexpr size_t MAX_BODY_LENGTH = 1 << 20;
+
+    enum class MsgType : char {
+        NEW_ORDER_SINGLE = 'D',
+        ORDER_CANCEL_REQUEST = 'F',
+        ORDER_CANCEL_REPLACE_REQUEST = 'G'
+    };
+
+    enum class ParseStatus {
+        OK,
+        INCOMPLETE,             // More bytes needed for a full message
+        BAD_BEGIN_STRING,       // Not FIX.4.4 (the stream cannot be resynchronised)
+        BAD_BODY_LENGTH,
+        BAD_CHECKSUM,
+        MALFORMED_FIELD,        // Tag not numeric, missing '=' or empty value
+        MISSING_FIELD,          // Required tag absent (see OrderMessage::error_tag)
+        BAD_VALUE,              // Value out of range or not representable (see error_tag)
+        UNSUPPORTED_MSG_TYPE    // Well-formed, but not an order entry message
+    };
+
+    /**
+     * @brief One decoded order entry message; views point into the parsed buffer.
+     * @details ClOrdID / OrigClOrdID must be numeric to map onto OrderId, the
+     * views keep the text for echoing it back in execution reports.
+     */
+    struct OrderMessage {
+        MsgType type = MsgType::NEW_ORDER_SINGLE;
+        std::string_view sender;            // 49 SenderCompID
+        std::string_view target;            // 56 TargetCompID
+        uint64_t seq_num = 0;               // 34 MsgSeqNum
+        std::string_view cl_ord_id;         // 11
+        std::string_view orig_cl_ord_id;    // 41 (cancel / replace)
+        OrderId order_id = 0;               // 11 as a number
+        OrderId orig_order_id = 0;          // 41 as a number
+        std::string_view symbol;            // 55
+        OrderSide side = OrderSide::BUY;    // 54: 1 buy, 2 sell
+        OrderType order_type = OrderType::LIMIT; // 40: 1 market, 2 limit, 3 stop, 4 stop limit
+        TimeInForce time_in_force = TimeInForce::DAY; // 59: 0 day, 1 GTC, 3 IOC, 4 FOK
+        Quantity quantity = 0;              // 38
+        Price price = 0;                    // 44, paisa
+        Price stop_price = 0;               // 99, paisa
+        uint32_t error_tag = 0;             // Offending tag when parsing failed on a field
+
+        // New order of a NewOrderSingle (copies the symbol, the only owning field of Order)
+        Order toOrder() const {
+            Order order(order_id, Symbol(symbol), side, quantity, price, order_type, time_in_force);
+            order.set_stop_price(stop_price);
+            return order;
+        }
+    };
+
+    // ========== Delimiter Scanning ==========
+
+    /**
+     * @brief Finds SOH and '=' positions of a message front to back, one 64-byte block at a time.
+     * @details Reads never go past `size`: the tail of the last block is scanned byte by byte.
+     */
+    template<bool USE_SIMD> class BasicDelimiterScanner {
+    private:
+        static constexpr size_t BLOCK = 64;
+
+        const char* data_;
+        size_t size_;
+        size_t block_ = SIZE_MAX;
+        uint64_t soh_ = 0;
+        uint64_t eq_ = 0;
+
+        void load(size_t block) {
+            block_ = block;
+            soh_ = eq_ = 0;
+            size_t begin = block * BLOCK;
+            size_t length = size_ - begin < BLOCK ? size_ - begin : BLOCK;
+            size_t i = 0;
+#if defined(__SSE2__)
+            if (USE_SIMD) {
+                const __m128i soh = _mm_set1_epi8(SOH);
+                const __m128i eq = _mm_set1_epi8('=');
+                for (; i + 16 <= length; i += 16) {
+                    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data_ + begin + i));
+                    soh_ |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, soh)))) << i;
+                    eq_ |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, eq)))) << i;
+                }
+            }
+#endif
+            for (; i < length; ++i) {
+                char c = data_[begin + i];
+                soh_ |= static_cast<uint64_t>(c == SOH) << i;
+                eq_ |= static_cast<uint64_t>(c == '=') << i;
+            }
+        }
+
+        size_t next(size_t from, bool soh) {
+            while (from < size_) {
+                size_t block = from / BLOCK;
+                if (block != block_) load(block);
+                uint64_t mask = (soh ? soh_ : eq_) >> (from % BLOCK);
+                if (mask) return from + static_cast<size_t>(__builtin_ctzll(mask));
+                from = (block + 1) * BLOCK;
+            }
+            return size_;
+        }
+
+    public:
+        BasicDelimiterScanner(const char* data, size_t size) : data_(data), size_(size) {}
+
+        // Offset of the first SOH / '=' at or after `from`, or the scanned size if there is none
+        size_t next_soh(size_t from) { return next(from, true); }
+        size_t next_equals(size_t from) { return next(from, false); }
+
+        // Sum of `size` bytes modulo 256, as in the CheckSum field
+        static uint8_t checksum(const char* data, size_t size) {
+            uint64_t sum = 0;
+            size_t i = 0;
+#if defined(__SSE2__)
+            if (USE_SIMD) {
+                const __m128i zero = _mm_setzero_si128();
+                __m128i totals = zero;
+                for (; i + 16 <= size; i += 16) {
+                    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                    totals = _mm_add_epi64(totals, _mm_sad_epu8(bytes, zero));
+                }
+                sum = static_cast<uint64_t>(_mm_cvtsi128_si64(totals)) +
+                      static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(totals, totals)));
+            }
+#endif
+            for (; i < size; ++i) sum += static_cast<uint8_t>(data[i]);
+            return static_cast<uint8_t>(sum);
+        }
+    };
+
+    using DelimiterScanner = BasicDelimiterScanner<true>;
+    using ScalarDelimiterScanner = BasicDelimiterScanner<false>;
+
+    // ========== Value Conversion ==========
+
+    // Unsigned decimal integer, at most 19 digits
+    inline bool parseUnsigned(std::string_view text, uint64_t& value) {
+        if (text.empty() || text.size() > 19) return false;
+        uint64_t result = 0;
+        for (char c : text) {
+            unsigned digit = static_cast<unsigned>(c - '0');
+            if (digit > 9) return false;
+            result = result * 10 + digit;
+        }
+        value = result;
+        return true;
+    }
+
+    /**
+     * @brief Decimal price to paisa ("1501.25" -> 150125, "-0.5" -> -50, "100" -> 10000).
+     * @details Digits beyond the second decimal must be zero, a finer price is not representable.
+     */
+    inline bool parsePrice(std::string_view text, Price& price) {
+        bool negative = !text.empty() && text.front() == '-';
+        if (negative) text.remove_prefix(1);
+        size_t dot = text.find('.');
+        std::string_view whole = text.substr(0, dot);
+        std::string_view fraction = dot == std::string_view::npos ? std::string_view() : text.substr(dot + 1);
+        if (whole.empty() && fraction.empty()) return false;
+
+        uint64_t units = 0;
+        if (!whole.empty() && (whole.size() > 16 || !parseUnsigned(whole, units))) return false;
+        uint64_t cents = 0;
+        for (size_t i = 0; i < fraction.size(); ++i) {
+            unsigned digit = static_cast<unsigned>(fraction[i] - '0');
+            if (digit > 9) return false;
+            if (i < 2) cents = cents * 10 + digit;
+            else if (digit != 0) return false;
+        }
+        if (fraction.size() == 1) cents *= 10;
+        int64_t paisa = static_cast<int64_t>(units * 100 + cents);
+        price = negative ? -paisa : paisa;
+        return true;
+    }
+
+    // Order quantity; FIX allows a decimal form, accepted when the fraction is zero ("100.0")
+    inline bool parseQuantity(std::string_view text, Quantity& quantity) {
+        size_t dot = text.find('.');
+        if (dot != std::string_view::npos) {
+            for (char c : text.substr(dot + 1)) {
+                if (c != '0') return false;
+            }
+            text = text.substr(0, dot);
+        }
+        uint64_t value = 0;
+        if (!parseUnsigned(text, value)) return false;
+        quantity = static_cast<Quantity>(value);
+        return true;
+    }
+
+    // ========== Message Parsing ==========
+
+    /**
+     * @brief Parse one message at the start of `data`.
+     * @param consumed Set to the message length once the frame is known to be
+     *                 intact (any status but INCOMPLETE, BAD_BEGIN_STRING and
+     *                 BAD_BODY_LENGTH), so a stream can skip a rejected message.
+     * @details Views in `message` are valid as long as `data` is.
+     * Scanner selects SIMD (default) or scalar delimiter scanning.
+     */
+    template<typename Scanner = DelimiterScanner>
+    ParseStatus parse(const char* data, size_t size, OrderMessage& message, size_t& consumed) {
+        consumed = 0;
+        message = OrderMessage{};
+        size_t prefix = size < BEGIN_STRING.size() ? size : BEGIN_STRING.size();
+        if (std::string_view(data, prefix) != BEGIN_STRING.substr(0, prefix)) return ParseStatus::BAD_BEGIN_STRING;
+        if (size < BEGIN_STRING.size() + 2) return ParseStatus::INCOMPLETE;
+
+        // 9=<BodyLength> SOH
+        size_t cursor = BEGIN_STRING.size();
+        if (data[cursor] != '9' || data[cursor + 1] != '=') return ParseStatus::BAD_BODY_LENGTH;
+        cursor += 2;
+        uint64_t body_length = 0;
+        size_t digits = 0;
+        for (; cursor < size && data[cursor] != SOH; ++cursor, ++digits) {
+            unsigned digit = static_cast<unsigned>(data[cursor] - '0');
+            if (digit > 9 || digits == 7) return ParseStatus::BAD_BODY_LENGTH;
+            body_length = body_length * 10 + digit;
+        }
+        if (cursor == size) return ParseStatus::INCOMPLETE;
+        if (digits == 0 || body_length > MAX_BODY_LENGTH) return ParseStatus::BAD_BODY_LENGTH;
+        size_t body = cursor + 1;
+        size_t body_end = body + body_length;
+        if (size < body_end + TRAILER_LENGTH) return ParseStatus::INCOMPLETE;
+
+        // 10=<ddd> SOH right after the body, otherwise BodyLength is wrong and the frame unknown
+        const char* trailer = data + body_end;
+        if (trailer[0] != '1' || trailer[1] != '0' || trailer[2] != '=' || trailer[6] != SOH ||
+            (body_length > 0 && data[body_end - 1] != SOH)) {
+            return ParseStatus::BAD_BODY_LENGTH;
+        }
+        consumed = body_end + TRAILER_LENGTH;
+        unsigned expected = 0;
+        for (size_t i = 3; i < 6; ++i) {
+            unsigned digit = static_cast<unsigned>(trailer[i] - '0');
+            if (digit > 9) return ParseStatus::BAD_CHECKSUM;
+            expected = expected * 10 + digit;
+        }
+        if (Scanner::checksum(data, body_end) != expected) return ParseStatus::BAD_CHECKSUM;
+
+        // Body fields
+        enum : uint32_t {
+            SEEN_TYPE = 1, SEEN_CL_ORD_ID = 2, SEEN_ORIG = 4, SEEN_SYMBOL = 8, SEEN_SIDE = 16,
+            SEEN_QTY = 32, SEEN_ORD_TYPE = 64, SEEN_PRICE = 128, SEEN_STOP = 256
+        };
+        uint32_t seen = 0;
+        Scanner scanner(data, body_end);
+        bool first = true;
+        for (size_t field = body; field < body_end;) {
+            size_t equals = scanner.next_equals(field);
+            size_t end = scanner.next_soh(field);
+            if (equals >= end || equals == field || end == equals + 1) return ParseStatus::MALFORMED_FIELD;
+            uint64_t tag = 0;
+            if (!parseUnsigned(std::string_view(data + field, equals - field), tag)) return ParseStatus::MALFORMED_FIELD;
+            std::string_view value(data + equals + 1, end - equals - 1);
+            field = end + 1;
+            message.error_tag = static_cast<uint32_t>(tag);
+
+            if (first && tag != 35) return ParseStatus::MISSING_FIELD;
+            first = false;
+            bool ok = true;
+            switch (tag) {
+                case 35:
+                    if (value.size() != 1 || (value[0] != 'D' && value[0] != 'F' && value[0] != 'G')) {
+                        return ParseStatus::UNSUPPORTED_MSG_TYPE;
+                    }
+                    message.type = static_cast<MsgType>(value[0]);
+                    seen |= SEEN_TYPE;
+                    break;
+                case 49: message.sender = value; break;
+                case 56: message.target = value; break;
+                case 34: ok = parseUnsigned(value, message.seq_num); break;
+                case 11:
+                    message.cl_ord_id = value;
+                    ok = parseUnsigned(value, message.order_id);
+                    seen |= SEEN_CL_ORD_ID;
+                    break;
+                case 41:
+                    message.orig_cl_ord_id = value;
+                    ok = parseUnsigned(value, message.orig_order_id);
+                    seen |= SEEN_ORIG;
+                    break;
+                case 55: message.symbol = value; seen |= SEEN_SYMBOL; break;
+                case 54:
+                    ok = value.size() == 1 && (value[0] == '1' || value[0] == '2');
+                    message.side = value[0] == '1' ? OrderSide::BUY : OrderSide::SELL;
+                    seen |= SEEN_SIDE;
+                    break;
+                case 38: ok = parseQuantity(value, message.quantity) && message.quantity > 0; seen |= SEEN_QTY; break;
+                case 40:
+                    ok = value.size() == 1 && value[0] >= '1' && value[0] <= '4';
+                    if (ok) {
+                        constexpr OrderType TYPES[] = {OrderType::MARKET, OrderType::LIMIT, OrderType::STOP,
+                                                       OrderType::STOP_LIMIT};
+                        message.order_type = TYPES[value[0] - '1'];
+                    }
+                    seen |= SEEN_ORD_TYPE;
+                    break;
+                case 44: ok = parsePrice(value, message.price); seen |= SEEN_PRICE; break;
+                case 99: ok = parsePrice(value, message.stop_price); seen |= SEEN_STOP; break;
+                case 59:
+                    ok = value.size() == 1;
+                    switch (ok ? value[0] : 0) {
+                        case '0': message.time_in_force = TimeInForce::DAY; break;
+                        case '1': message.time_in_force = TimeInForce::GOOD_TILL_CANCELLED; break;
+                        case '3': message.time_in_force = TimeInForce::IMMEDIATE_OR_CANCEL; break;
+                        case '4': message.time_in_force = TimeInForce::FILL_OR_KILL; break;
+                        default: ok = false; break;
+                    }
+                    break;
+                default: break; // Not used by the engine
+            }
+            if (!ok) return ParseStatus::BAD_VALUE;
+        }
+
+        // Required fields per message type
+        auto require = [&](uint32_t flag, uint32_t tag) {
+            if (seen & flag) return true;
+            message.error_tag = tag;
+            return false;
+        };
+        if (!require(SEEN_TYPE, 35) || !require(SEEN_CL_ORD_ID, 11)) return ParseStatus::MISSING_FIELD;
+        bool ok = true;
+        if (message.type == MsgType::ORDER_CANCEL_REQUEST) {
+            ok = require(SEEN_ORIG, 41);
+        }
+        else {
+            ok = (message.type == MsgType::NEW_ORDER_SINGLE || require(SEEN_ORIG, 41)) &&
+                 require(SEEN_SYMBOL, 55) && require(SEEN_SIDE, 54) && require(SEEN_QTY, 38) &&
+                 require(SEEN_ORD_TYPE, 40);
+            bool priced = message.order_type == OrderType::LIMIT || message.order_type == OrderType::STOP_LIMIT;
+            bool stopped = message.order_type == OrderType::STOP || message.order_type == OrderType::STOP_LIMIT;
+            ok = ok && (!priced || require(SEEN_PRICE, 44)) && (!stopped || require(SEEN_STOP, 99));
+        }
+        if (!ok) return ParseStatus::MISSING_FIELD;
+        message.error_tag = 0;
+        return ParseStatus::OK;
+    }
+
+    /**
+     * @brief Parse consecutive messages, calling handler(message) for each good one
+     * and on_error(status, message) for each rejected one.
+     * @return Bytes consumed; stops at an incomplete tail or a broken frame.
+     */
+    template<typename Scanner = DelimiterScanner, typename Handler, typename ErrorHandler>
+    size_t parseStream(const char* data, size_t size, Handler&& handler, ErrorHandler&& on_error) {
+        size_t offset = 0;
+        OrderMessage message;
+        while (offset < size) {
+            size_t consumed = 0;
+            ParseStatus status = parse<Scanner>(data + offset, size - offset, message, consumed);
+            if (status == ParseStatus::OK) handler(message);
+            else if (consumed > 0) on_error(status, message);
+            else {
+                if (status != ParseStatus::INCOMPLETE) on_error(status, message);
+                break;
+            }
+            offset += consumed;
+        }
+        return offset;
+    }
+
+    inline const char* toString(ParseStatus status) {
+        switch (status) {
+            case ParseStatus::OK: return "ok";
+            case ParseStatus::INCOMPLETE: return "incomplete";
+            case ParseStatus::BAD_BEGIN_STRING: return "bad BeginString";
+            case ParseStatus::BAD_BODY_LENGTH: return "bad BodyLength";
+            case ParseStatus::BAD_CHECKSUM: return "bad CheckSum";
+            case ParseStatus::MALFORMED_FIELD: return "malformed field";
+            case ParseStatus::MISSING_FIELD: return "missing required field";
+            case ParseStatus::BAD_VALUE: return "bad value";
+            case ParseStatus::UNSUPPORTED_MSG_TYPE: return "unsupported MsgType";
+        }
+        return "unknown";
+    }
+
+    // ========== Encoding ==========
+
+    /**
+     * @brief Builds FIX 4.4 messages with BodyLength and CheckSum filled in.
+     * @details For tests, benchmarks and load generation, not the hot path:
+     * fields are appended to a std::string.
+     */
+    class MessageBuilder {
+    private:
+        std::string body_;
+
+    public:
+        MessageBuilder& field(uint32_t tag, std::string_view value) {
+            body_.append(std::to_string(tag)).append(1, '=').append(value).append(1, SOH);
+            return *this;
+        }
+
+        MessageBuilder& field(uint32_t tag, uint64_t value) { return field(tag, std::to_string(value)); }
+
+        MessageBuilder& price(uint32_t tag, Price paisa) {
+            std::string text = paisa < 0 ? "-" : "";
+            uint64_t magnitude = static_cast<uint64_t>(paisa < 0 ? -paisa : paisa);
+            text += std::to_string(magnitude / 100);
+            text += '.';
+            text += static_cast<char>('0' + magnitude % 100 / 10);
+            text += static_cast<char>('0' + magnitude % 10);
+            return field(tag, text);
+        }
+
+        // Append the framed message to `out` and start over
+        void finish(std::string& out) {
+            size_t start = out.size();
+            out.append(BEGIN_STRING).append("9=").append(std::to_string(body_.size())).append(1, SOH).append(body_);
+            unsigned sum = ScalarDelimiterScanner::checksum(out.data() + start, out.size() - start);
+            char trailer[] = {'1', '0', '=', static_cast<char>('0' + sum / 100), static_cast<char>('0' + sum / 10 % 10),
+                              static_cast<char>('0' + sum % 10), SOH};
+            out.append(trailer, sizeof(trailer));
+            body_.clear();
+        }
+
+        std::string finish() {
+            std::string out;
+            finish(out);
+            return out;
+        }
+    };
+
+    // NewOrderSingle with the usual header fields
+    inline std::string newOrderSingle(uint64_t seq, OrderId id, std::string_view symbol, OrderSide side,
+                                      Quantity qty, Price price, OrderType type = OrderType::LIMIT,
+                                      std::string_view time_in_force = "0") {
+        MessageBuilder builder;
+        builder.field(35, "D").field(49, "CLIENT").field(56, "ENGINE").field(34, seq)
+               .field(52, "20240102-09:15:00.000").field(11, id).field(55, symbol)
+               .field(54, side == OrderSide::BUY ? "1" : "2").field(38, qty)
+               .field(40, type == OrderType::MARKET ? "1" : "2");
+        if (type != OrderType::MARKET) builder.price(44, price);
+        builder.field(59, time_in_force).field(60, "20240102-09:15:00.000");
+        return builder.finish();
+    }
+
+} // namespace Fix
+} // namespace OrderEngine
+
+#endif // FIX_PARSER_H
@@ -0,0 +1,116 @@
+#pragma once
+#ifndef FORMAT_BUFFER_H
+#define FORMAT_BUFFER_H
+
+#include "OrderTypes.h"
+#include <charconv>
+#include <string>
+#include <string_view>
+
+namespace OrderEngine {
+
+    /**
+     * @brief Reusable character buffer for allocation-free text output.
+     * @details
+     * FormatBuffer appends integers and fixed-point prices with std::to_chars,
+     * never going through iostreams or floating point. Calling clear() keeps the
+     * capacity, so a buffer reused for periodic dumps stops allocating once it has
+     * grown to the size of the largest message.
+     *
+     * Prices are printed as paisa / 100 with exactly two decimals, matching
+     * `std::fixed << std::setprecision(2) << (price / 100.0)`.
+     */
+    class FormatBuffer {
+    private:
+        std::string buffer_;
+
+        // Large enough for any 64-bit integer or price plus sign and decimal point
+        static constexpr size_t SCRATCH_SIZE = 32;
+
+    public:
+        FormatBuffer() = default;
+        explicit FormatBuffer(size_t capacity) { buffer_.reserve(capacity); }
+
+        void clear() { buffer_.clear(); }
+        void reserve(size_t capacity) { buffer_.reserve(capacity); }
+        size_t size() const { return buffer_.size(); }
+        const char* data() const { return buffer_.data(); }
+        std::string_view view() const { return buffer_; }
+        std::string str() const { return buffer_; }
+
+        // ========== Raw Appends ==========
+
+        FormatBuffer& append(char c) {
+            buffer_.push_back(c);
+            return *this;
+        }
+
+        FormatBuffer& append(std::string_view text) {
+            buffer_.append(text.data(), text.size());
+            return *this;
+        }
+
+        FormatBuffer& append_repeat(char c, size_t count) {
+            buffer_.append(count, c);
+            return *this;
+        }
+
+        FormatBuffer& append_uint(uint64_t value) {
+            char scratch[SCRATCH_SIZE];
+            return append(std::string_view(scratch, format_uint(scratch, value)));
+        }
+
+        FormatBuffer& append_price(Price price) {
+            char scratch[SCRATCH_SIZE];
+            return append(std::string_view(scratch, format_price(scratch, price)));
+        }
+
+        // ========== Padded Appends (equivalent of std::setw) ==========
+
+        // Pads `text` with spaces to `width`; never truncates, like std::setw
+        FormatBuffer& append_padded(std::string_view text, size_t width, bool align_right = true) {
+            size_t pad = text.size() < width ? width - text.size() : 0;
+            if (align_right) append_repeat(' ', pad);
+            append(text);
+            if (!align_right) append_repeat(' ', pad);
+            return *this;
+        }
+
+        FormatBuffer& append_uint_padded(uint64_t value, size_t width, bool align_right = true) {
+            char scratch[SCRATCH_SIZE];
+            return append_padded(std::string_view(scratch, format_uint(scratch, value)), width, align_right);
+        }
+
+        FormatBuffer& append_price_padded(Price price, size_t width, bool align_right = true) {
+            char scratch[SCRATCH_SIZE];
+            return append_padded(std::string_view(scratch, format_price(scratch, price)), width, align_right);
+        }
+
+        // ========== Formatting Primitives ==========
+
+        // Writes `value` in decimal, returns the number of characters written
+        static size_t format_uint(char* out, uint64_t value) {
+            auto result = std::to_chars(out, out + SCRATCH_SIZE, value);
+            return static_cast<size_t>(result.ptr - out);
+        }
+
+        // Writes `price` (paisa) as rupees with two decimals, e.g. 15025 -> "150.25"
+        static size_t format_price(char* out, Price price) {
+            char* p = out;
+            uint64_t magnitude = static_cast<uint64_t>(price);
+            if (price < 0) {
+                *p++ = '-';
+                magnitude = 0 - magnitude;
+            }
+            p = std::to_chars(p, out + SCRATCH_SIZE, magnitude / 100).ptr;
+            uint64_t fraction = magnitude % 100;
+            *p++ = '.';
+            *p++ = static_cast<char>('0' + fraction / 10);
+            *p++ = static_cast<char>('0' + fraction % 10);
+            return static_cast<size_t>(p - out);
+        }
+    };
+
+} // namespace OrderEngine
+
+#endif // FORMAT_BUFFER_H
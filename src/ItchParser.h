@@ -0,0 +1,255 @@
+#pragma once
+#ifndef ITCH_PARSER_H
+#define ITCH_PARSER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace OrderEngine {
+namespace Itch {
+
+    /**
+     * NASDAQ TotalView-ITCH 5.0 decoding.
+     *
+     * Messages are read in place: each view below wraps a pointer into the
+     * (usually memory-mapped) input and decodes big-endian fields on access,
+     * nothing is copied or allocated. Only the messages needed to rebuild an
+     * order book are decoded; every other type is reported as skipped.
+     */
+
+    inline uint16_t readU16(const uint8_t* p) { return static_cast<uint16_t>((p[0] << 8) | p[1]); }
+
+    inline uint32_t readU32(const uint8_t* p) {
+        return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+               (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+    }
+
+    inline uint64_t readU48(const uint8_t* p) {
+        return (static_cast<uint64_t>(readU16(p)) << 32) | readU32(p + 2);
+    }
+
+    inline uint64_t readU64(const uint8_t* p) {
+        return (static_cast<uint64_t>(readU32(p)) << 32) | readU32(p + 4);
+    }
+
+    // Space-padded alpha field without the padding
+    inline std::string_view readAlpha(const uint8_t* p, size_t width) {
+        while (width > 0 && p[width - 1] == ' ') --width;
+        return std::string_view(reinterpret_cast<const char*>(p), width);
+    }
+
+    // Prices are 4-decimal fixed point (Price(4)): 1234500 = $123.45
+    constexpr int64_t PRICE_SCALE = 10000;
+
+    // Fields common to every message: type(1) locate(2) tracking(2) timestamp(6)
+    struct MessageView {
+        const uint8_t* data;
+
+        char type() const { return static_cast<char>(data[0]); }
+        uint16_t stock_locate() const { return readU16(data + 1); }
+        uint16_t tracking_number() const { return readU16(data + 3); }
+        uint64_t timestamp_ns() const { return readU48(data + 5); } // Since midnight
+    };
+
+    // 'R' Stock Directory
+    struct StockDirectory : MessageView {
+        static constexpr size_t LENGTH = 39;
+        std::string_view stock() const { return readAlpha(data + 11, 8); }
+    };
+
+    // 'A' Add Order (no MPID) and 'F' Add Order with MPID attribution
+    struct AddOrder : MessageView {
+        static constexpr size_t LENGTH = 36;
+        static constexpr size_t LENGTH_WITH_MPID = 40;
+        uint64_t order_reference() const { return readU64(data + 11); }
+        bool is_buy() const { return data[19] == 'B'; }
+        uint32_t shares() const { return readU32(data + 20); }
+        std::string_view stock() const { return readAlpha(data + 24, 8); }
+        uint32_t price() const { return readU32(data + 32); }
+    };
+
+    // 'E' Order Executed
+    struct OrderExecuted : MessageView {
+        static constexpr size_t LENGTH = 31;
+        uint64_t order_reference() const { return readU64(data + 11); }
+        uint32_t executed_shares() const { return readU32(data + 19); }
+        uint64_t match_number() const { return readU64(data + 23); }
+    };
+
+    // 'C' Order Executed With Price
+    struct OrderExecutedWithPrice : OrderExecuted {
+        static constexpr size_t LENGTH = 36;
+        bool printable() const { return data[31] == 'Y'; }
+        uint32_t execution_price() const { return readU32(data + 32); }
+    };
+
+    // 'X' Order Cancel (partial)
+    struct OrderCancel : MessageView {
+        static constexpr size_t LENGTH = 23;
+        uint64_t order_reference() const { return readU64(data + 11); }
+        uint32_t cancelled_shares() const { return readU32(data + 19); }
+    };
+
+    // 'D' Order Delete
+    struct OrderDelete : MessageView {
+        static constexpr size_t LENGTH = 19;
+        uint64_t order_reference() const { return readU64(data + 11); }
+    };
+
+    // 'U' Order Replace: original order is removed, new reference takes its side
+    struct OrderReplace : MessageView {
+        static constexpr size_t LENGTH = 35;
+        uint64_t original_reference() const { return readU64(data + 11); }
+        uint64_t new_reference() const { return readU64(data + 19); }
+        uint32_t shares() const { return readU32(data + 27); }
+        uint32_t price() const { return readU32(data + 31); }
+    };
+
+    /**
+     * @brief No-op callbacks; derive and hide the ones of interest (dispatch is static).
+     */
+    struct HandlerBase {
+        void on_stock_directory(const StockDirectory&) {}
+        void on_add_order(const AddOrder&) {}
+        void on_order_executed(const OrderExecuted&) {}
+        void on_order_executed_with_price(const OrderExecutedWithPrice&) {}
+        void on_order_cancel(const OrderCancel&) {}
+        void on_order_delete(const OrderDelete&) {}
+        void on_order_replace(const OrderReplace&) {}
+        void on_skipped(char /*type*/) {}
+        // Called before the message's own callback; `index` counts framed messages from 0
+        void on_message(const uint8_t* /*message*/, size_t /*length*/, uint64_t /*index*/) {}
+    };
+
+    struct ParseResult {
+        uint64_t messages = 0;      // Framed messages seen
+        uint64_t malformed = 0;     // Known type but shorter than its layout
+        size_t bytes_consumed = 0;  // Stops before a truncated trailing frame
+    };
+
+    /**
+     * @brief Decode a stream of ITCH 5.0 messages, each framed by a 2-byte big-endian length.
+     * @details This is the layout of NASDAQ's published binary files. The handler's
+     * callbacks receive views into `data`, valid as long as the buffer is.
+     * Stops after `max_messages` framed messages.
+     */
+    template<typename Handler> ParseResult parseStream(const uint8_t* data, size_t size, Handler& handler,
+                                                       uint64_t max_messages = UINT64_MAX) {
+        ParseResult result;
+        size_t offset = 0;
+        while (offset + 2 <= size && result.messages < max_messages) {
+            size_t length = readU16(data + offset);
+            if (offset + 2 + length > size) break;
+            const uint8_t* message = data + offset + 2;
+            offset += 2 + length;
+            if (length == 0) continue;
+
+            handler.on_message(message, length, result.messages++);
+            auto fits = [&](size_t expected) {
+                if (length >= expected) return true;
+                ++result.malformed;
+                return false;
+            };
+            switch (message[0]) {
+                case 'R': if (fits(StockDirectory::LENGTH)) handler.on_stock_directory(StockDirectory{{message}}); break;
+                case 'A': if (fits(AddOrder::LENGTH)) handler.on_add_order(AddOrder{{message}}); break;
+                case 'F': if (fits(AddOrder::LENGTH_WITH_MPID)) handler.on_add_order(AddOrder{{message}}); break;
+                case 'E': if (fits(OrderExecuted::LENGTH)) handler.on_order_executed(OrderExecuted{{message}}); break;
+                case 'C':
+                    if (fits(OrderExecutedWithPrice::LENGTH)) {
+                        handler.on_order_executed_with_price(OrderExecutedWithPrice{{{message}}});
+                    }
+                    break;
+                case 'X': if (fits(OrderCancel::LENGTH)) handler.on_order_cancel(OrderCancel{{message}}); break;
+                case 'D': if (fits(OrderDelete::LENGTH)) handler.on_order_delete(OrderDelete{{message}}); break;
+                case 'U': if (fits(OrderReplace::LENGTH)) handler.on_order_replace(OrderReplace{{message}}); break;
+                default: handler.on_skipped(static_cast<char>(message[0])); break;
+            }
+        }
+        result.bytes_consumed = offset;
+        return result;
+    }
+
+    /**
+     * @brief Appends framed ITCH 5.0 messages to a byte buffer.
+     * @details For tests and for producing synthetic replay files; timestamps and
+     * tracking numbers are written as given, unused fields are zero.
+     */
+    class Encoder {
+    private:
+        std::vector<uint8_t>& out_;
+
+        void put16(uint16_t value) { out_.push_back(static_cast<uint8_t>(value >> 8)); out_.push_back(static_cast<uint8_t>(value)); }
+        void put32(uint32_t value) { put16(static_cast<uint16_t>(value >> 16)); put16(static_cast<uint16_t>(value)); }
+        void put48(uint64_t value) { put16(static_cast<uint16_t>(value >> 32)); put32(static_cast<uint32_t>(value)); }
+        void put64(uint64_t value) { put32(static_cast<uint32_t>(value >> 32)); put32(static_cast<uint32_t>(value)); }
+        void putAlpha(std::string_view text, size_t width) {
+            for (size_t i = 0; i < width; ++i) out_.push_back(i < text.size() ? static_cast<uint8_t>(text[i]) : ' ');
+        }
+        void header(size_t length, char type, uint16_t locate, uint64_t timestamp_ns) {
+            put16(static_cast<uint16_t>(length));
+            out_.push_back(static_cast<uint8_t>(type));
+            put16(locate);
+            put16(0);
+            put48(timestamp_ns);
+        }
+
+    public:
+        explicit Encoder(std::vector<uint8_t>& out) : out_(out) {}
+
+        void stock_directory(uint16_t locate, std::string_view stock, uint64_t ts = 0) {
+            header(StockDirectory::LENGTH, 'R', locate, ts);
+            putAlpha(stock, 8);
+            out_.insert(out_.end(), StockDirectory::LENGTH - 19, 0);
+        }
+
+        void add_order(uint16_t locate, uint64_t reference, bool is_buy, uint32_t shares,
+                       std::string_view stock, uint32_t price, uint64_t ts = 0) {
+            header(AddOrder::LENGTH, 'A', locate, ts);
+            put64(reference);
+            out_.push_back(is_buy ? 'B' : 'S');
+            put32(shares);
+            putAlpha(stock, 8);
+            put32(price);
+        }
+
+        void order_executed(uint16_t locate, uint64_t reference, uint32_t shares, uint64_t match, uint64_t ts = 0) {
+            header(OrderExecuted::LENGTH, 'E', locate, ts);
+            put64(reference);
+            put32(shares);
+            put64(match);
+        }
+
+        void order_cancel(uint16_t locate, uint64_t reference, uint32_t shares, uint64_t ts = 0) {
+            header(OrderCancel::LENGTH, 'X', locate, ts);
+            put64(reference);
+            put32(shares);
+        }
+
+        void order_delete(uint16_t locate, uint64_t reference, uint64_t ts = 0) {
+            header(OrderDelete::LENGTH, 'D', locate, ts);
+            put64(reference);
+        }
+
+        void order_replace(uint16_t locate, uint64_t original, uint64_t replacement, uint32_t shares,
+                           uint32_t price, uint64_t ts = 0) {
+            header(OrderReplace::LENGTH, 'U', locate, ts);
+            put64(original);
+            put64(replacement);
+            put32(shares);
+            put32(price);
+        }
+
+        // 'S' System Event, decoded as skipped
+        void system_event(char code, uint64_t ts = 0) {
+            header(12, 'S', 0, ts);
+            out_.push_back(static_cast<uint8_t>(code));
+        }
+    };
+
+} // namespace Itch
+} // namespace OrderEngine
+
+#endif // ITCH_PARSER_H
@@ -0,0 +1,137 @@
+#pragma once
+#ifndef ITCH_REPLAY_H
+#define ITCH_REPLAY_H
+
+#include "ItchParser.h"
+#include "OrderBook.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OrderEngine {
+
+    /**
+     * @brief Rebuilds one OrderBook per ITCH stock locate from decoded messages.
+     * @details
+     * Message to book command mapping:
+     * - 'R' Stock Directory          : names the book of that locate
+     * - 'A' / 'F' Add Order          : addOrder, limit GTC at the ITCH price
+     * - 'E' / 'C' Order Executed     : reduceOrder by the executed shares
+     * - 'X' Order Cancel             : reduceOrder by the cancelled shares
+     * - 'D' Order Delete             : cancelOrder
+     * - 'U' Order Replace            : cancelOrder(original) + addOrder(new reference)
+     * ITCH reports executions against resting orders only (aggressors are not shown),
+     * so they are applied as externally reported reductions rather than matched.
+     * Prices stay in ITCH units (1/10000 of a dollar). Order references are unique
+     * per day across all stocks and are used as order ids unchanged.
+     */
+    class ItchBookReplayer : public Itch::HandlerBase {
+    public:
+        using OrderPtr = std::shared_ptr<Order>;
+        using Book = OrderBook<OrderPtr>;
+
+        struct Counters {
+            uint64_t adds = 0;
+            uint64_t executions = 0;
+            uint64_t cancels = 0;
+            uint64_t deletes = 0;
+            uint64_t replaces = 0;
+            uint64_t unknown_orders = 0;    // Referenced an order not resting in its book
+            uint64_t skipped = 0;           // Message types not needed for the book
+        };
+
+    private:
+        std::vector<std::unique_ptr<Book>> books_;  // Indexed by stock locate
+        Counters counters_;
+        bool latency_histograms_ = false;
+
+        Book& book(uint16_t locate, std::string_view stock = {}) {
+            if (locate >= books_.size()) books_.resize(static_cast<size_t>(locate) + 1);
+            auto& slot = books_[locate];
+            if (!slot) {
+                slot = std::make_unique<Book>(stock.empty() ? "LOCATE" + std::to_string(locate) : std::string(stock));
+                if (latency_histograms_) slot->enableLatencyHistograms();
+            }
+            return *slot;
+        }
+
+        void add(uint16_t locate, OrderId reference, bool is_buy, Quantity shares, Price price) {
+            Book& target = book(locate);
+            target.addOrder(std::make_shared<Order>(reference, target.symbol(),
+                is_buy ? OrderSide::BUY : OrderSide::SELL, shares, price));
+        }
+
+        void count(bool found) { if (!found) ++counters_.unknown_orders; }
+
+    public:
+        void on_stock_directory(const Itch::StockDirectory& message) { book(message.stock_locate(), message.stock()); }
+
+        void on_add_order(const Itch::AddOrder& message) {
+            ++counters_.adds;
+            add(message.stock_locate(), message.order_reference(), message.is_buy(), message.shares(), message.price());
+        }
+
+        void on_order_executed(const Itch::OrderExecuted& message) {
+            ++counters_.executions;
+            count(book(message.stock_locate()).reduceOrder(message.order_reference(), message.executed_shares()));
+        }
+
+        void on_order_executed_with_price(const Itch::OrderExecutedWithPrice& message) { on_order_executed(message); }
+
+        void on_order_cancel(const Itch::OrderCancel& message) {
+            ++counters_.cancels;
+            count(book(message.stock_locate()).reduceOrder(message.order_reference(), message.cancelled_shares()));
+        }
+
+        void on_order_delete(const Itch::OrderDelete& message) {
+            ++counters_.deletes;
+            count(book(message.stock_locate()).cancelOrder(message.order_reference()));
+        }
+
+        void on_order_replace(const Itch::OrderReplace& message) {
+            ++counters_.replaces;
+            Book& target = book(message.stock_locate());
+            // Side is not repeated in 'U', it is inherited from the original order
+            OrderPtr original = target.findOrder(message.original_reference());
+            if (!original) {
+                ++counters_.unknown_orders;
+                return;
+            }
+            target.cancelOrder(original->order_id());
+            add(message.stock_locate(), message.new_reference(), original->is_buy(), message.shares(), message.price());
+        }
+
+        void on_skipped(char) { ++counters_.skipped; }
+
+        const Counters& counters() const { return counters_; }
+
+        // Record per-operation latency in every book, existing and future
+        void enable_latency_histograms() {
+            latency_histograms_ = true;
+            for (auto& book : books_) {
+                if (book) book->enableLatencyHistograms();
+            }
+        }
+
+        // Per-operation latency of all books merged (empty unless enabled)
+        void merge_latency(OrderBookLatency& total) const {
+            for (const auto& book : books_) {
+                if (book && book->latency()) total.merge(*book->latency());
+            }
+        }
+
+        // Book of `locate`, or nullptr if that locate was never seen
+        const Book* book_at(uint16_t locate) const {
+            return locate < books_.size() ? books_[locate].get() : nullptr;
+        }
+
+        size_t book_count() const {
+            size_t count = 0;
+            for (const auto& book : books_) count += book != nullptr;
+            return count;
+        }
+    };
+
+} // namespace OrderEngine
+
+#endif // ITCH_REPLAY_H
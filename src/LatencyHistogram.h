@@ -0,0 +1,226 @@
+#pragma once
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include "Tsc.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <utility>
+
+namespace OrderEngine {
+
+    /**
+     * @brief Fixed-memory log-linear histogram (HdrHistogram layout).
+     * @details
+     * Values below 2^SUB_BITS get a bucket each; above that every power of two is
+     * split into 2^SUB_BITS linear sub-buckets, so a reported percentile is within
+     * 1/32 (~3%) of the recorded value. Values of 2^MAX_EXPONENT and above share the
+     * last bucket (max() stays exact). record() is O(1): a count-leading-zeros, a
+     * shift and a counter bump, no allocation.
+     *
+     * Single writer, any number of readers: counters are relaxed atomics updated with
+     * a plain load/store, so readers see consistent-enough snapshots without making
+     * the writer pay for locked instructions. To combine threads, give each writer
+     * its own histogram and merge() them from the reporting thread.
+     *
+     * The unit is the caller's; OrderBookLatency records TSC ticks.
+     */
+    class LatencyHistogram {
+    public:
+        static constexpr int SUB_BITS = 5;
+        static constexpr int MAX_EXPONENT = 40;
+        static constexpr size_t BUCKETS = static_cast<size_t>(MAX_EXPONENT - SUB_BITS + 1) << SUB_BITS;
+
+        struct Summary {
+            uint64_t count = 0;
+            uint64_t min = 0;
+            uint64_t mean = 0;
+            uint64_t p50 = 0;
+            uint64_t p90 = 0;
+            uint64_t p99 = 0;
+            uint64_t p999 = 0;
+            uint64_t max = 0;
+        };
+
+    private:
+        std::atomic<uint64_t> counts_[BUCKETS] = {};
+        std::atomic<uint64_t> total_{0};
+        std::atomic<uint64_t> sum_{0};
+        std::atomic<uint64_t> min_{UINT64_MAX};
+        std::atomic<uint64_t> max_{0};
+
+        static void bump(std::atomic<uint64_t>& counter, uint64_t by = 1) {
+            counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+        }
+
+        static size_t index(uint64_t value) {
+            if (value < (uint64_t{1} << SUB_BITS)) return static_cast<size_t>(value);
+            if (value >> MAX_EXPONENT) return BUCKETS - 1;
+            int exponent = 63 - __builtin_clzll(value);
+            uint64_t sub = (value >> (exponent - SUB_BITS)) & ((uint64_t{1} << SUB_BITS) - 1);
+            return (static_cast<size_t>(exponent - SUB_BITS + 1) << SUB_BITS) | static_cast<size_t>(sub);
+        }
+
+        // Largest value that lands in `bucket`
+        static uint64_t upper_bound(size_t bucket) {
+            if (bucket < (size_t{1} << SUB_BITS)) return bucket;
+            int exponent = static_cast<int>(bucket >> SUB_BITS) + SUB_BITS - 1;
+            uint64_t sub = bucket & ((size_t{1} << SUB_BITS) - 1);
+            return ((((uint64_t{1} << SUB_BITS) | sub) + 1) << (exponent - SUB_BITS)) - 1;
+        }
+
+    public:
+        LatencyHistogram() = default;
+        LatencyHistogram(const LatencyHistogram&) = delete;
+        LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+        void record(uint64_t value) {
+            bump(counts_[index(value)]);
+            bump(total_);
+            bump(sum_, value);
+            if (value < min_.load(std::memory_order_relaxed)) min_.store(value, std::memory_order_relaxed);
+            if (value > max_.load(std::memory_order_relaxed)) max_.store(value, std::memory_order_relaxed);
+        }
+
+        // Add `other`'s recordings to this one (the caller is this histogram's only writer)
+        void merge(const LatencyHistogram& other) {
+            if (other.count() == 0) return;
+            for (size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+                uint64_t n = other.counts_[bucket].load(std::memory_order_relaxed);
+                if (n) bump(counts_[bucket], n);
+            }
+            bump(total_, other.total_.load(std::memory_order_relaxed));
+            bump(sum_, other.sum_.load(std::memory_order_relaxed));
+            min_.store(std::min(min(), other.min()), std::memory_order_relaxed);
+            max_.store(std::max(max(), other.max()), std::memory_order_relaxed);
+        }
+
+        void reset() {
+            for (auto& counter : counts_) counter.store(0, std::memory_order_relaxed);
+            total_.store(0, std::memory_order_relaxed);
+            sum_.store(0, std::memory_order_relaxed);
+            min_.store(UINT64_MAX, std::memory_order_relaxed);
+            max_.store(0, std::memory_order_relaxed);
+        }
+
+        uint64_t count() const { return total_.load(std::memory_order_relaxed); }
+        uint64_t min() const { return count() ? min_.load(std::memory_order_relaxed) : 0; }
+        uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+        uint64_t mean() const { return count() ? sum_.load(std::memory_order_relaxed) / count() : 0; }
+        uint64_t sum() const { return sum_.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Smallest bucket bound at or above `p` percent of the recordings.
+         * @return 0 when empty; never more than max().
+         */
+        uint64_t percentile(double p) const {
+            uint64_t total = count();
+            if (total == 0) return 0;
+            auto rank = static_cast<uint64_t>(p / 100.0 * static_cast<double>(total) + 0.5);
+            rank = std::min(std::max<uint64_t>(rank, 1), total);
+            uint64_t seen = 0;
+            for (size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+                seen += counts_[bucket].load(std::memory_order_relaxed);
+                if (seen < rank) continue;
+                if (bucket == BUCKETS - 1) return max(); // Overflow bucket has no bound
+                return std::max(std::min(upper_bound(bucket), max()), min());
+            }
+            return max();
+        }
+
+        Summary summary() const {
+            Summary summary;
+            summary.count = count();
+            summary.min = min();
+            summary.mean = mean();
+            summary.p50 = percentile(50);
+            summary.p90 = percentile(90);
+            summary.p99 = percentile(99);
+            summary.p999 = percentile(99.9);
+            summary.max = max();
+            return summary;
+        }
+    };
+
+    /**
+     * @brief Times one scope into a histogram in TSC ticks; a null histogram costs one branch.
+     */
+    class ScopedLatency {
+    private:
+        LatencyHistogram* histogram_;
+        uint64_t start_;
+
+    public:
+        explicit ScopedLatency(LatencyHistogram* histogram)
+            : histogram_(histogram), start_(histogram ? Tsc::now() : 0) {}
+
+        ~ScopedLatency() {
+            if (histogram_) histogram_->record(Tsc::now() - start_);
+        }
+
+        ScopedLatency(const ScopedLatency&) = delete;
+        ScopedLatency& operator=(const ScopedLatency&) = delete;
+    };
+
+    /**
+     * @brief Per-operation latency of one OrderBook (or, merged, of a shard of books).
+     * @details
+     * Recorded in TSC ticks under the book lock:
+     * - add     : addOrder, matching and listener dispatch included
+     * - cancel  : cancelOrder and reduceOrder
+     * - replace : replaceOrder (massQuote is not recorded)
+     * - match   : each matching pass that executed at least one fill
+     * - notify  : end-of-operation publishing (market signals, depth update)
+     */
+    struct OrderBookLatency {
+        LatencyHistogram add;
+        LatencyHistogram cancel;
+        LatencyHistogram replace;
+        LatencyHistogram match;
+        LatencyHistogram notify;
+
+        void merge(const OrderBookLatency& other) {
+            add.merge(other.add);
+            cancel.merge(other.cancel);
+            replace.merge(other.replace);
+            match.merge(other.match);
+            notify.merge(other.notify);
+        }
+
+        void reset() {
+            add.reset();
+            cancel.reset();
+            replace.reset();
+            match.reset();
+            notify.reset();
+        }
+
+        // One line per operation, percentiles converted to nanoseconds
+        void dump(std::ostream& out) const {
+            const std::pair<const char*, const LatencyHistogram*> rows[] = {
+                {"add", &add}, {"cancel", &cancel}, {"replace", &replace}, {"match", &match}, {"notify", &notify}};
+            char line[160];
+            std::snprintf(line, sizeof(line), "%-8s %12s %10s %10s %10s %10s %10s\n",
+                          "op", "count", "p50 ns", "p99 ns", "p99.9 ns", "max ns", "mean ns");
+            out << line;
+            for (const auto& row : rows) {
+                LatencyHistogram::Summary s = row.second->summary();
+                std::snprintf(line, sizeof(line), "%-8s %12llu %10llu %10llu %10llu %10llu %10llu\n", row.first,
+                              static_cast<unsigned long long>(s.count),
+                              static_cast<unsigned long long>(Tsc::to_ns(s.p50)),
+                              static_cast<unsigned long long>(Tsc::to_ns(s.p99)),
+                              static_cast<unsigned long long>(Tsc::to_ns(s.p999)),
+                              static_cast<unsigned long long>(Tsc::to_ns(s.max)),
+                              static_cast<unsigned long long>(Tsc::to_ns(s.mean)));
+                out << line;
+            }
+        }
+    };
+
+} // namespace OrderEngine
+
+#endif // LATENCY_HISTOGRAM_H
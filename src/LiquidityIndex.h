@@ -0,0 +1,496 @@
+#pragma once
+#ifndef LIQUIDITY_INDEX_H
+#define LIQUIDITY_INDEX_H
+
+#include "OrderTypes.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace OrderEngine {
+
+    /**
+     * @brief Result of a hypothetical sweep of one side of the book.
+     * @details
+     * fillable_quantity < requested_quantity means the side ran out of liquidity;
+     * the other fields then describe sweeping the whole side.
+     */
+    struct SweepEstimate {
+        Quantity requested_quantity = 0;
+        Quantity fillable_quantity = 0;
+        double vwap = 0.0;          // Average fill price in price units (paisa)
+        Price best_price = 0;       // First price touched
+        Price worst_price = 0;      // Last price touched
+        size_t levels_touched = 0;  // Number of price levels consumed (fully or partially)
+
+        bool fully_fillable() const { return fillable_quantity == requested_quantity; }
+    };
+
+    /**
+     * @brief The best slots of one side of the book with running totals.
+     * @details
+     * A bounded copy of a LiquidityIndex, best price first (lowest for asks,
+     * highest for bids), filled by LiquidityIndex::copy_best in O(k + log n)
+     * for k slots. Its size follows k, never the price range of the book.
+     * A sweep that ends inside the band is priced by one binary search; one
+     * that runs past it is only answered when the band holds the whole side.
+     */
+    class LiquidityBand {
+    private:
+        struct Slot {
+            Price price;
+            Quantity qty;
+            uint64_t notional;
+            uint32_t levels;
+            Quantity cum_qty;       // Totals from the best slot through this one
+            uint64_t cum_notional;
+            uint64_t cum_levels;
+        };
+
+        std::vector<Slot> slots_;
+        bool complete_ = true;
+
+    public:
+        // Appends the next slot away from the best price
+        void push(Price price, Quantity qty, uint64_t notional, uint32_t levels) {
+            Slot slot{price, qty, notional, levels, qty, notional, levels};
+            if (!slots_.empty()) {
+                slot.cum_qty += slots_.back().cum_qty;
+                slot.cum_notional += slots_.back().cum_notional;
+                slot.cum_levels += slots_.back().cum_levels;
+            }
+            slots_.push_back(slot);
+        }
+
+        void clear() {
+            slots_.clear();
+            complete_ = true;
+        }
+
+        void reserve(size_t slots) { slots_.reserve(slots); }
+
+        // False when the side holds slots beyond the band
+        bool complete() const { return complete_; }
+        void set_complete(bool complete) { complete_ = complete; }
+
+        size_t slot_count() const { return slots_.size(); }
+        Quantity total_quantity() const { return slots_.empty() ? 0 : slots_.back().cum_qty; }
+        size_t memory_bytes() const { return slots_.capacity() * sizeof(Slot); }
+
+        /**
+         * @brief Price a sweep from the best slot outwards. O(log k)
+         * @return False if the sweep runs past an incomplete band; `estimate` is then untouched.
+         */
+        bool sweep(Quantity quantity, SweepEstimate& estimate) const {
+            Quantity total = total_quantity();
+            if (quantity > total && !complete_) return false;
+
+            estimate = SweepEstimate{};
+            estimate.requested_quantity = quantity;
+            if (quantity == 0 || total == 0) return true;
+
+            Quantity fill = std::min(quantity, total);
+            auto worst = std::lower_bound(slots_.begin(), slots_.end(), fill,
+                                          [](const Slot& slot, Quantity q) { return slot.cum_qty < q; });
+            Quantity before_qty = worst->cum_qty - worst->qty;
+            uint64_t before_notional = worst->cum_notional - worst->notional;
+
+            // Average price within the worst slot (exact unless tick_size merges prices)
+            double worst_avg = static_cast<double>(worst->notional) / static_cast<double>(worst->qty);
+            estimate.fillable_quantity = fill;
+            estimate.best_price = slots_.front().price;
+            estimate.worst_price = worst->price;
+            estimate.levels_touched = static_cast<size_t>(worst->cum_levels);
+            estimate.vwap = (static_cast<double>(before_notional) +
+                             worst_avg * static_cast<double>(fill - before_qty)) / static_cast<double>(fill);
+            return true;
+        }
+    };
+
+    /**
+     * @brief Cumulative quantity index over the prices that hold liquidity.
+     * @details
+     * Prices are grouped into slots of `tick_size` price units, and every slot
+     * with open quantity is a node of a treap (a binary search tree on price,
+     * balanced by random priorities). Each node also keeps the totals of its
+     * subtree: open quantity, notional (price x quantity) and non-empty levels.
+     * That turns "how much is available up to price X", "what price do I have
+     * to reach to get Q" and the whole pricing of a sweep (VWAP, worst price,
+     * levels touched) into one O(log n) descent, n being the number of slots
+     * in use. Memory follows the number of levels, not the price range they
+     * span: a stub quote far from the market costs one node.
+     *
+     *              [15010 | 250]  sum 400
+     *             /             \
+     *   [15000 | 100] sum 100   [15015 | 50] sum 50      (tick_size = 5)
+     *
+     * Nodes live in one vector and emptied slots are recycled through a free
+     * list, so a warmed index does not allocate.
+     */
+    class LiquidityIndex {
+    private:
+        static constexpr uint32_t NIL = UINT32_MAX;
+
+        struct Node {
+            Price price;            // Slot price, a multiple of tick_size
+            Quantity qty;
+            uint64_t notional;      // Sum of price x quantity over the slot
+            uint32_t levels;        // Non-empty price levels in the slot
+            uint32_t priority;
+            uint32_t left;
+            uint32_t right;
+            Quantity sum_qty;       // Totals of the subtree rooted here
+            uint64_t sum_notional;
+            uint64_t sum_levels;
+        };
+
+        // Totals of the slots left of a descent's stopping point
+        struct Prefix {
+            Quantity qty = 0;
+            uint64_t notional = 0;
+            uint64_t levels = 0;
+        };
+
+        Price tick_size_;
+        std::vector<Node> nodes_;
+        std::vector<uint32_t> free_;        // Recycled node indexes
+        uint32_t root_ = NIL;
+        size_t slots_ = 0;                  // Nodes in the tree
+        uint32_t seed_ = 2463534242u;       // xorshift32 state for priorities
+
+        Quantity sum_qty(uint32_t n) const { return n == NIL ? 0 : nodes_[n].sum_qty; }
+        uint64_t sum_notional(uint32_t n) const { return n == NIL ? 0 : nodes_[n].sum_notional; }
+        uint64_t sum_levels(uint32_t n) const { return n == NIL ? 0 : nodes_[n].sum_levels; }
+
+        void pull(uint32_t n) {
+            Node& node = nodes_[n];
+            node.sum_qty = node.qty + sum_qty(node.left) + sum_qty(node.right);
+            node.sum_notional = node.notional + sum_notional(node.left) + sum_notional(node.right);
+            node.sum_levels = node.levels + sum_levels(node.left) + sum_levels(node.right);
+        }
+
+        uint32_t next_priority() {
+            seed_ ^= seed_ << 13;
+            seed_ ^= seed_ >> 17;
+            seed_ ^= seed_ << 5;
+            return seed_;
+        }
+
+        uint32_t make_node(Price price) {
+            uint32_t n;
+            if (!free_.empty()) {
+                n = free_.back();
+                free_.pop_back();
+            }
+            else {
+                n = static_cast<uint32_t>(nodes_.size());
+                nodes_.emplace_back();
+            }
+            nodes_[n] = Node{price, 0, 0, 0, next_priority(), NIL, NIL, 0, 0, 0};
+            ++slots_;
+            return n;
+        }
+
+        uint32_t rotate_right(uint32_t n) {
+            uint32_t l = nodes_[n].left;
+            nodes_[n].left = nodes_[l].right;
+            nodes_[l].right = n;
+            pull(n);
+            pull(l);
+            return l;
+        }
+
+        uint32_t rotate_left(uint32_t n) {
+            uint32_t r = nodes_[n].right;
+            nodes_[n].right = nodes_[r].left;
+            nodes_[r].left = n;
+            pull(n);
+            pull(r);
+            return r;
+        }
+
+        // Join two treaps, every price of `a` below every price of `b`
+        uint32_t merge(uint32_t a, uint32_t b) {
+            if (a == NIL) return b;
+            if (b == NIL) return a;
+            if (nodes_[a].priority > nodes_[b].priority) {
+                nodes_[a].right = merge(nodes_[a].right, b);
+                pull(a);
+                return a;
+            }
+            nodes_[b].left = merge(a, nodes_[b].left);
+            pull(b);
+            return b;
+        }
+
+        // Add deltas to the slot at `price` (created or dropped as needed); returns the new subtree root
+        uint32_t update(uint32_t n, Price price, Quantity qty, uint64_t notional, uint32_t levels) {
+            if (n == NIL) {
+                n = make_node(price);
+                Node& node = nodes_[n];
+                node.qty = qty;
+                node.notional = notional;
+                node.levels = levels;
+                pull(n);
+                return n;
+            }
+            if (price < nodes_[n].price) {
+                uint32_t child = update(nodes_[n].left, price, qty, notional, levels);
+                nodes_[n].left = child;
+                if (child != NIL && nodes_[child].priority > nodes_[n].priority) return rotate_right(n);
+            }
+            else if (price > nodes_[n].price) {
+                uint32_t child = update(nodes_[n].right, price, qty, notional, levels);
+                nodes_[n].right = child;
+                if (child != NIL && nodes_[child].priority > nodes_[n].priority) return rotate_left(n);
+            }
+            else {
+                Node& node = nodes_[n];
+                node.qty += qty;
+                node.notional += notional;
+                node.levels += levels;
+                if (node.qty == 0 && node.levels == 0) {
+                    uint32_t joined = merge(node.left, node.right);
+                    free_.push_back(n);
+                    --slots_;
+                    return joined;
+                }
+            }
+            pull(n);
+            return n;
+        }
+
+        /**
+         * @brief Slot holding the (target + 1)-th unit of quantity in ascending price order.
+         * @details Like FenwickTree::max_prefix_within: the first slot whose running
+         * total exceeds `target`. `before` receives the totals of the slots below it.
+         * Requires target < total_quantity().
+         */
+        uint32_t find_quantity(Quantity target, Prefix& before) const {
+            uint32_t n = root_;
+            while (n != NIL) {
+                const Node& node = nodes_[n];
+                Quantity left = sum_qty(node.left);
+                if (target < left) {
+                    n = node.left;
+                    continue;
+                }
+                before.qty += left;
+                before.notional += sum_notional(node.left);
+                before.levels += sum_levels(node.left);
+                if (target - left < node.qty) return n;
+                target -= left + node.qty;
+                before.qty += node.qty;
+                before.notional += node.notional;
+                before.levels += node.levels;
+                n = node.right;
+            }
+            return NIL;
+        }
+
+        // First slot whose running level count exceeds `target`; requires target < total_levels()
+        uint32_t find_levels(uint64_t target, Prefix& before) const {
+            uint32_t n = root_;
+            while (n != NIL) {
+                const Node& node = nodes_[n];
+                uint64_t left = sum_levels(node.left);
+                if (target < left) {
+                    n = node.left;
+                    continue;
+                }
+                before.qty += sum_qty(node.left);
+                before.levels += left;
+                if (target - left < node.levels) return n;
+                target -= left + node.levels;
+                before.qty += node.qty;
+                before.levels += node.levels;
+                n = node.right;
+            }
+            return NIL;
+        }
+
+        // Total quantity of the slots priced below `price` (or at it, if `inclusive`); slot prices are aligned
+        Quantity quantity_below(Price price, bool inclusive) const {
+            Quantity total = 0;
+            uint32_t n = root_;
+            while (n != NIL) {
+                const Node& node = nodes_[n];
+                if (node.price < price || (inclusive && node.price == price)) {
+                    total += sum_qty(node.left) + node.qty;
+                    n = node.right;
+                }
+                else {
+                    n = node.left;
+                }
+            }
+            return total;
+        }
+
+        // In-order walk from the best slot, stopping once the band holds `limit` slots
+        void copy_slots(uint32_t n, bool ascending, size_t limit, LiquidityBand& band) const {
+            if (n == NIL || band.slot_count() == limit) return;
+            const Node& node = nodes_[n];
+            copy_slots(ascending ? node.left : node.right, ascending, limit, band);
+            if (band.slot_count() == limit) return;
+            band.push(node.price, node.qty, node.notional, node.levels);
+            copy_slots(ascending ? node.right : node.left, ascending, limit, band);
+        }
+
+        Price aligned(Price price) const {
+            Price slot = price / tick_size_;
+            if (price < 0 && slot * tick_size_ != price) --slot;
+            return slot * tick_size_;
+        }
+
+        // Completes an estimate from the totals of the slots strictly better than `worst`
+        void fill_estimate(SweepEstimate& estimate, Quantity fill, Price best, uint32_t worst,
+                           const Prefix& before) const {
+            // Average price within the worst slot (exact unless tick_size merges prices)
+            const Node& node = nodes_[worst];
+            Quantity worst_qty = fill - before.qty;
+            double worst_avg = static_cast<double>(node.notional) / static_cast<double>(node.qty);
+
+            estimate.fillable_quantity = fill;
+            estimate.best_price = best;
+            estimate.worst_price = node.price;
+            estimate.levels_touched = static_cast<size_t>(before.levels) + node.levels;
+            estimate.vwap = (static_cast<double>(before.notional) + worst_avg * static_cast<double>(worst_qty))
+                            / static_cast<double>(fill);
+        }
+
+    public:
+        explicit LiquidityIndex(Price tick_size = 1) : tick_size_(tick_size > 0 ? tick_size : 1) {}
+
+        Price tick_size() const { return tick_size_; }
+        // Slots (ticks) currently holding liquidity
+        size_t slot_count() const { return slots_; }
+
+        // Heap bytes of the nodes, free ones included; follows the peak number of slots in use
+        size_t memory_bytes() const {
+            return nodes_.capacity() * sizeof(Node) + free_.capacity() * sizeof(uint32_t);
+        }
+        Quantity total_quantity() const { return sum_qty(root_); }
+        size_t total_levels() const { return static_cast<size_t>(sum_levels(root_)); }
+
+        /**
+         * @brief Apply a level quantity change. O(log n)
+         */
+        void apply(Price price, Quantity old_qty, Quantity new_qty) {
+            if (old_qty == new_qty) return;
+            Quantity delta = new_qty - old_qty; // wraps for decreases, sums stay exact
+            Price slot_price = aligned(price);
+            uint32_t level_delta = 0;
+            if (old_qty == 0) level_delta = 1u;
+            else if (new_qty == 0) level_delta = static_cast<uint32_t>(-1);
+            root_ = update(root_, slot_price, delta, static_cast<uint64_t>(price) * delta, level_delta);
+        }
+
+        void clear() {
+            nodes_.clear();
+            free_.clear();
+            root_ = NIL;
+            slots_ = 0;
+        }
+
+        // ========== Queries (all O(log n)) ==========
+
+        // Query prices are only compared with slot prices, so any value (INT64_MAX included) is safe
+
+        // Total quantity at prices <= price
+        Quantity quantity_at_or_below(Price price) const {
+            return quantity_below(price, true);
+        }
+
+        // Total quantity at prices >= price
+        Quantity quantity_at_or_above(Price price) const {
+            return total_quantity() - quantity_below(price, false);
+        }
+
+        // Lowest price P such that quantity_at_or_below(P) >= quantity, 0 if not enough
+        Price lowest_price_covering(Quantity quantity) const {
+            if (quantity == 0 || quantity > total_quantity()) return 0;
+            Prefix before;
+            return nodes_[find_quantity(quantity - 1, before)].price;
+        }
+
+        // Highest price P such that quantity_at_or_above(P) >= quantity, 0 if not enough
+        Price highest_price_covering(Quantity quantity) const {
+            if (quantity == 0 || quantity > total_quantity()) return 0;
+            Prefix before;
+            return nodes_[find_quantity(total_quantity() - quantity, before)].price;
+        }
+
+        // Quantity held by the `levels` lowest-priced non-empty levels
+        Quantity quantity_of_lowest_levels(size_t levels) const {
+            if (levels >= total_levels()) return total_quantity();
+            if (levels == 0) return 0;
+            Prefix before;
+            uint32_t last = find_levels(levels - 1, before);
+            return before.qty + nodes_[last].qty;
+        }
+
+        // Quantity held by the `levels` highest-priced non-empty levels
+        Quantity quantity_of_highest_levels(size_t levels) const {
+            if (levels >= total_levels()) return total_quantity();
+            if (levels == 0) return 0;
+            Prefix before;
+            find_levels(total_levels() - levels, before);
+            return total_quantity() - before.qty;
+        }
+
+        /**
+         * @brief Copy at most `max_slots` slots from the best price outwards. O(k + log n)
+         * @param ascending True to start at the lowest price (asks), false at the highest (bids).
+         */
+        void copy_best(size_t max_slots, bool ascending, LiquidityBand& band) const {
+            band.clear();
+            band.reserve(std::min(max_slots, slots_));
+            copy_slots(root_, ascending, max_slots, band);
+            band.set_complete(band.slot_count() == slots_);
+        }
+
+        /**
+         * @brief Price a sweep from the lowest price upwards (a buy against asks). O(log n)
+         */
+        SweepEstimate sweep_ascending(Quantity quantity) const {
+            SweepEstimate estimate;
+            estimate.requested_quantity = quantity;
+            Quantity total = total_quantity();
+            if (quantity == 0 || total == 0) return estimate;
+
+            Quantity fill = std::min(quantity, total);
+            Prefix first_before, before;
+            uint32_t first = find_quantity(0, first_before);
+            uint32_t worst = find_quantity(fill - 1, before);
+            fill_estimate(estimate, fill, nodes_[first].price, worst, before);
+            return estimate;
+        }
+
+        /**
+         * @brief Price a sweep from the highest price downwards (a sell against bids). O(log n)
+         */
+        SweepEstimate sweep_descending(Quantity quantity) const {
+            SweepEstimate estimate;
+            estimate.requested_quantity = quantity;
+            Quantity total = total_quantity();
+            if (quantity == 0 || total == 0) return estimate;
+
+            Quantity fill = std::min(quantity, total);
+            Prefix first_before, below;
+            uint32_t first = find_quantity(total - 1, first_before);
+            uint32_t worst = find_quantity(total - fill, below);
+
+            // Mirror the prefix: what lies above the worst slot
+            const Node& node = nodes_[worst];
+            Prefix before;
+            before.qty = total - below.qty - node.qty;
+            before.notional = sum_notional(root_) - below.notional - node.notional;
+            before.levels = sum_levels(root_) - below.levels - node.levels;
+            fill_estimate(estimate, fill, nodes_[first].price, worst, before);
+            return estimate;
+        }
+    };
+
+} // namespace OrderEngine
+
+#endif // LIQUIDITY_INDEX_H
@@ -4,12 +4,14 @@
 
 #include "OrderTypes.h"
 #include <memory>
+#include <vector>
 
 namespace OrderEngine {
     class Order;
     // Forward declarations
     struct Trade;
     struct DepthLevel;
+    struct MarketSignals;
 
     /**
      * @brief Interface for listening to order lifecycle events.
@@ -49,6 +51,16 @@ namespace OrderEngine {
         
         virtual void on_order_book_change(const OrderBookType* book) {}
         virtual void on_bbo_change(const OrderBookType* book, Price bid, Price ask) {}
+        // Published after on_bbo_change and whenever top-of-book sizes or top-N depth move
+        virtual void on_market_signals(const OrderBookType* book, const MarketSignals& signals) {}
+    };
+
+    // Net change of one price level over a book operation
+    struct LevelDelta {
+        bool is_bid;
+        Price price;
+        Quantity old_qty;
+        Quantity new_qty;
     };
 
     // Depth book event listener interface  
@@ -58,6 +70,36 @@ namespace OrderEngine {
         
         virtual void on_depth_change(const OrderBookType* book, bool is_bid, 
                                 Price price, Quantity new_qty, Quantity delta) = 0;
+
+        /**
+         * @brief All level changes of one book operation, coalesced (one entry per level).
+         * @details Override to consume the batch at once; by default forwards each entry
+         * to on_depth_change, `delta` being new_qty - old_qty in unsigned arithmetic.
+         */
+        virtual void on_depth_update(const OrderBookType* book, const std::vector<LevelDelta>& changes) {
+            for (const auto& change : changes) {
+                on_depth_change(book, change.is_bid, change.price, change.new_qty, change.new_qty - change.old_qty);
+            }
+        }
+
+        // Heap bytes of depth state kept for the book, charged to the book's memory footprint
+        virtual size_t memory_bytes() const { return 0; }
+    };
+
+    /**
+     * @brief Interface for listening to aggregate changes of a single price level.
+     * @details
+     * Raised by OrderTracker whenever a level's total quantity or order count changes
+     * (order added, removed, resized or filled). Incremental views over the ladder
+     * implement it so they can stay in sync without rescanning the book.
+     */
+    class LevelChangeListener {
+    public:
+        virtual ~LevelChangeListener() = default;
+
+        virtual void on_level_change(bool is_buy_side, Price price,
+                                    Quantity old_qty, Quantity new_qty,
+                                    size_t old_count, size_t new_count) = 0;
     };
 
 } // namespace OrderEngine
@@ -0,0 +1,323 @@
+#pragma once
+#ifndef LOBSTER_LOADER_H
+#define LOBSTER_LOADER_H
+
+#include "OrderBook.h"
+#include "DepthTracker.h"
+#include <array>
+#include <cstdint>
+#include <map>
+#include <memory>
+
+namespace OrderEngine {
+namespace Lobster {
+
+    /**
+     * LOBSTER (lobsterdata.com) level-3 CSV files.
+     *
+     * message file  : Time,Type,OrderID,Size,Price,Direction
+     *                 Time in seconds after midnight with up to 9 decimals,
+     *                 Price in 1/10000 dollar, Direction 1 = buy, -1 = sell.
+     * orderbook file: AskPrice1,AskSize1,BidPrice1,BidSize1,AskPrice2,...
+     *                 one row per message, the book *after* that message;
+     *                 empty levels carry price +/-9999999999 and size 0.
+     *
+     * Rows are parsed in place from a buffer (usually a MappedFile) by a
+     * hand-rolled numeric parser: no allocation, no locale, no iostreams.
+     */
+
+    enum class EventType : int {
+        SUBMIT = 1,
+        PARTIAL_CANCEL = 2,
+        DELETE = 3,
+        EXECUTE_VISIBLE = 4,
+        EXECUTE_HIDDEN = 5,
+        CROSS_TRADE = 6,
+        TRADING_HALT = 7
+    };
+
+    struct Message {
+        int64_t time_ns = 0;        // Since midnight
+        EventType type = EventType::SUBMIT;
+        OrderId order_id = 0;
+        Quantity size = 0;
+        Price price = 0;
+        int direction = 1;          // Side of the order (for executions: the resting order)
+
+        bool is_buy() const { return direction > 0; }
+    };
+
+    constexpr size_t MAX_LEVELS = 50;
+    constexpr Price EMPTY_ASK_PRICE = 9999999999;
+    constexpr Price EMPTY_BID_PRICE = -9999999999;
+
+    struct BookRow {
+        size_t levels = 0;
+        std::array<Price, MAX_LEVELS> ask_price{};
+        std::array<Quantity, MAX_LEVELS> ask_size{};
+        std::array<Price, MAX_LEVELS> bid_price{};
+        std::array<Quantity, MAX_LEVELS> bid_size{};
+    };
+
+    // ========== Numeric Parsing ==========
+
+    // Optionally signed decimal integer, stops at the first non-digit
+    inline bool parseInt(const char*& p, const char* end, int64_t& out) {
+        bool negative = p < end && *p == '-';
+        if (negative) ++p;
+        const char* start = p;
+        uint64_t value = 0;
+        while (p < end && static_cast<unsigned>(*p - '0') < 10) value = value * 10 + static_cast<unsigned>(*p++ - '0');
+        if (p == start) return false;
+        out = negative ? -static_cast<int64_t>(value) : static_cast<int64_t>(value);
+        return true;
+    }
+
+    // Seconds with an optional fraction, as nanoseconds (extra digits past 9 are dropped)
+    inline bool parseSeconds(const char*& p, const char* end, int64_t& out_ns) {
+        int64_t seconds = 0;
+        if (!parseInt(p, end, seconds)) return false;
+        int64_t fraction = 0;
+        int digits = 0;
+        if (p < end && *p == '.') {
+            ++p;
+            while (p < end && static_cast<unsigned>(*p - '0') < 10) {
+                if (digits < 9) {
+                    fraction = fraction * 10 + (*p - '0');
+                    ++digits;
+                }
+                ++p;
+            }
+        }
+        for (; digits < 9; ++digits) fraction *= 10;
+        out_ns = seconds * 1000000000 + fraction;
+        return true;
+    }
+
+    inline bool expectComma(const char*& p, const char* end) {
+        if (p >= end || *p != ',') return false;
+        ++p;
+        return true;
+    }
+
+    /**
+     * @brief Iterates the lines of a buffer in place, accepting LF or CRLF endings.
+     */
+    class LineCursor {
+    private:
+        const char* p_;
+        const char* end_;
+
+    public:
+        LineCursor(const char* data, size_t size) : p_(data), end_(data + size) {}
+
+        // Next non-empty line as [begin, stop); false at the end of the buffer
+        bool next(const char*& begin, const char*& stop) {
+            while (p_ < end_ && (*p_ == '\n' || *p_ == '\r')) ++p_;
+            if (p_ >= end_) return false;
+            begin = p_;
+            while (p_ < end_ && *p_ != '\n') ++p_;
+            stop = p_;
+            if (stop > begin && stop[-1] == '\r') --stop;
+            return true;
+        }
+    };
+
+    inline bool parseMessage(const char* p, const char* end, Message& out) {
+        int64_t type = 0, id = 0, size = 0, price = 0, direction = 0;
+        if (!parseSeconds(p, end, out.time_ns) || !expectComma(p, end) ||
+            !parseInt(p, end, type) || !expectComma(p, end) ||
+            !parseInt(p, end, id) || !expectComma(p, end) ||
+            !parseInt(p, end, size) || !expectComma(p, end) ||
+            !parseInt(p, end, price) || !expectComma(p, end) ||
+            !parseInt(p, end, direction)) {
+            return false;
+        }
+        if (type < 1 || type > 7 || size < 0) return false;
+        out.type = static_cast<EventType>(type);
+        out.order_id = static_cast<OrderId>(id);
+        out.size = static_cast<Quantity>(size);
+        out.price = price;
+        out.direction = direction < 0 ? -1 : 1;
+        return true;
+    }
+
+    inline bool parseBookRow(const char* p, const char* end, BookRow& out) {
+        out.levels = 0;
+        while (p < end && out.levels < MAX_LEVELS) {
+            int64_t ask_price = 0, ask_size = 0, bid_price = 0, bid_size = 0;
+            if (out.levels > 0 && !expectComma(p, end)) return false;
+            if (!parseInt(p, end, ask_price) || !expectComma(p, end) ||
+                !parseInt(p, end, ask_size) || !expectComma(p, end) ||
+                !parseInt(p, end, bid_price) || !expectComma(p, end) ||
+                !parseInt(p, end, bid_size)) {
+                return false;
+            }
+            out.ask_price[out.levels] = ask_price;
+            out.ask_size[out.levels] = static_cast<Quantity>(ask_size);
+            out.bid_price[out.levels] = bid_price;
+            out.bid_size[out.levels] = static_cast<Quantity>(bid_size);
+            ++out.levels;
+        }
+        return out.levels > 0 && p == end;
+    }
+
+    // ========== Book Reconstruction ==========
+
+    /**
+     * @brief Drives an OrderBook from LOBSTER messages and checks it against the orderbook file.
+     * @details
+     * Message to book command mapping:
+     * - 1 submit            : addOrder (limit GTC)
+     * - 2 partial cancel    : reduceOrder
+     * - 3 delete            : cancelOrder
+     * - 4 visible execution : reduceOrder (the resting order shrinks, nothing is matched)
+     * - 5, 6, 7             : no effect on visible depth, counted and skipped
+     *
+     * LOBSTER samples start with a non-empty book whose orders never appeared as
+     * messages. seed() recreates it as one synthetic order per visible level from the
+     * first orderbook row; later messages for unknown order ids at a seeded price are
+     * applied to that level's synthetic order. Depth beyond the file's levels is not
+     * known at the start, so deep levels that later move into view may not match.
+     */
+    class Replayer {
+    public:
+        using OrderPtr = std::shared_ptr<Order>;
+        using Book = OrderBook<OrderPtr>;
+        using Depth = DepthTracker<MAX_LEVELS>;
+
+        struct Counters {
+            uint64_t messages = 0;
+            uint64_t skipped = 0;           // Hidden executions, cross trades, halts
+            uint64_t seed_adjustments = 0;  // Applied to a synthetic seed order
+            uint64_t unknown_orders = 0;    // Neither resting nor seeded
+            uint64_t rows_validated = 0;
+            uint64_t mismatched_rows = 0;
+            uint64_t first_mismatch = 0;    // 1-based row of the files, 0 if none
+        };
+
+    private:
+        static constexpr OrderId SEED_ID_BASE = OrderId{1} << 62;
+
+        Book book_;
+        Depth depth_;
+        Counters counters_;
+        std::map<std::pair<int, Price>, OrderId> seeds_;  // (direction, price) -> synthetic order
+
+        // Apply a reduction to an order the book does not know: fall back to the level's seed
+        void reduceUnknown(const Message& message) {
+            auto seed_it = seeds_.find({message.direction, message.price});
+            if (seed_it != seeds_.end() && book_.reduceOrder(seed_it->second, message.size)) {
+                ++counters_.seed_adjustments;
+                return;
+            }
+            ++counters_.unknown_orders;
+        }
+
+    public:
+        explicit Replayer(const Symbol& symbol = "LOBSTER") : book_(symbol) {}
+
+        const Book& book() const { return book_; }
+        const Depth& depth() const { return depth_; }
+        const Counters& counters() const { return counters_; }
+
+        // Recreate the visible book of `row` as one synthetic order per level
+        void seed(const BookRow& row) {
+            OrderId next_id = SEED_ID_BASE;
+            for (size_t level = 0; level < row.levels; ++level) {
+                if (row.ask_size[level] > 0 && row.ask_price[level] != EMPTY_ASK_PRICE) {
+                    book_.addOrder(std::make_shared<Order>(next_id, book_.symbol(), OrderSide::SELL,
+                                                           row.ask_size[level], row.ask_price[level]));
+                    seeds_[{-1, row.ask_price[level]}] = next_id++;
+                }
+                if (row.bid_size[level] > 0 && row.bid_price[level] != EMPTY_BID_PRICE) {
+                    book_.addOrder(std::make_shared<Order>(next_id, book_.symbol(), OrderSide::BUY,
+                                                           row.bid_size[level], row.bid_price[level]));
+                    seeds_[{1, row.bid_price[level]}] = next_id++;
+                }
+            }
+        }
+
+        void apply(const Message& message) {
+            ++counters_.messages;
+            switch (message.type) {
+                case EventType::SUBMIT:
+                    book_.addOrder(std::make_shared<Order>(message.order_id, book_.symbol(),
+                        message.is_buy() ? OrderSide::BUY : OrderSide::SELL, message.size, message.price));
+                    break;
+                case EventType::PARTIAL_CANCEL:
+                case EventType::EXECUTE_VISIBLE:
+                    if (!book_.reduceOrder(message.order_id, message.size)) reduceUnknown(message);
+                    break;
+                case EventType::DELETE:
+                    if (!book_.cancelOrder(message.order_id)) reduceUnknown(message);
+                    break;
+                default:
+                    ++counters_.skipped;
+                    break;
+            }
+        }
+
+        /**
+         * @brief Compare the top `row.levels` levels of the book with `row`.
+         * @return True if every price and size matches.
+         */
+        bool validate(const BookRow& row) {
+            depth_.update_from_tracker(book_.bids(), book_.asks());
+            ++counters_.rows_validated;
+            bool match = true;
+            for (size_t level = 0; level < row.levels && match; ++level) {
+                const DepthLevel& ask = depth_.get_ask_level(level);
+                const DepthLevel& bid = depth_.get_bid_level(level);
+                bool ask_empty = row.ask_size[level] == 0 || row.ask_price[level] == EMPTY_ASK_PRICE;
+                bool bid_empty = row.bid_size[level] == 0 || row.bid_price[level] == EMPTY_BID_PRICE;
+                match = (ask_empty ? ask.quantity == 0 : ask.price == row.ask_price[level] && ask.quantity == row.ask_size[level]) &&
+                        (bid_empty ? bid.quantity == 0 : bid.price == row.bid_price[level] && bid.quantity == row.bid_size[level]);
+            }
+            if (!match) {
+                ++counters_.mismatched_rows;
+                // Row 1 seeded the book, so validated row n is file row n + 1
+                if (counters_.first_mismatch == 0) counters_.first_mismatch = counters_.rows_validated + 1;
+            }
+            return match;
+        }
+    };
+
+    /**
+     * @brief Replay a message buffer, optionally validating against an orderbook buffer.
+     * @param orderbook_data May be null: no seeding and no validation (pure throughput).
+     * @details With an orderbook file the first row seeds the book and stands in for
+     * the first message, every following row is validated after its message.
+     * @return False if a row failed to parse.
+     */
+    inline bool replay(Replayer& replayer, const char* message_data, size_t message_size,
+                       const char* orderbook_data = nullptr, size_t orderbook_size = 0) {
+        LineCursor messages(message_data, message_size);
+        LineCursor rows(orderbook_data, orderbook_data ? orderbook_size : 0);
+        Message message;
+        BookRow row;
+        const char* begin;
+        const char* stop;
+        bool first = true;
+        while (messages.next(begin, stop)) {
+            if (!parseMessage(begin, stop, message)) return false;
+            if (!orderbook_data) {
+                replayer.apply(message);
+                continue;
+            }
+            if (!rows.next(begin, stop) || !parseBookRow(begin, stop, row)) return false;
+            if (first) {
+                replayer.seed(row);
+                first = false;
+                continue;
+            }
+            replayer.apply(message);
+            replayer.validate(row);
+        }
+        return true;
+    }
+
+} // namespace Lobster
+} // namespace OrderEngine
+
+#endif // LOBSTER_LOADER_H
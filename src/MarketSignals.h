@@ -0,0 +1,136 @@
+#pragma once
+#ifndef MARKET_SIGNALS_H
+#define MARKET_SIGNALS_H
+
+#include "OrderTypes.h"
+#include <limits>
+
+namespace OrderEngine {
+
+    /**
+     * @brief Best bid and offer with their sizes. A missing side has price 0 and quantity 0.
+     */
+    struct TopOfBook {
+        Price bid_price = 0;
+        Quantity bid_qty = 0;
+        Price ask_price = 0;
+        Quantity ask_qty = 0;
+
+        bool operator==(const TopOfBook& other) const {
+            return bid_price == other.bid_price && bid_qty == other.bid_qty &&
+                ask_price == other.ask_price && ask_qty == other.ask_qty;
+        }
+        bool operator!=(const TopOfBook& other) const { return !(*this == other); }
+    };
+
+    /**
+     * @brief Microstructure signals derived from the top of the book.
+     * @details
+     * - top_imbalance    : (bid_qty - ask_qty) / (bid_qty + ask_qty) at the touch, in [-1, 1].
+     * - depth_imbalance  : same ratio over the best `depth_levels` levels of each side.
+     * - microprice       : size-weighted mid, (bid * ask_qty + ask * bid_qty) / (bid_qty + ask_qty).
+     * - last_ofi         : Cont-Kukanov-Stoikov order flow imbalance of the latest top-of-book event.
+     * - cumulative_ofi   : running sum of last_ofi since construction or reset_ofi().
+     */
+    struct MarketSignals {
+        TopOfBook top;
+        Quantity bid_depth_qty = 0;
+        Quantity ask_depth_qty = 0;
+        double top_imbalance = 0.0;
+        double depth_imbalance = 0.0;
+        double microprice = 0.0;
+        int64_t last_ofi = 0;
+        int64_t cumulative_ofi = 0;
+        uint64_t updates = 0;           // Number of changes folded in so far
+    };
+
+    /**
+     * @brief Maintains MarketSignals incrementally, one book event at a time.
+     * @details
+     * Each update is O(1): the tracker only needs the new top of book, the new top-N
+     * depth totals and the previous top of book it keeps itself. The book computes
+     * these once per event and every subscriber reads the result, instead of each
+     * strategy recomputing the same ratios.
+     *
+     * ORDER FLOW IMBALANCE (per top-of-book event n):
+     *   e(n) = [Pb(n) >= Pb(n-1)] * qb(n) - [Pb(n) <= Pb(n-1)] * qb(n-1)
+     *        - [Pa(n) <= Pa(n-1)] * qa(n) + [Pa(n) >= Pa(n-1)] * qa(n-1)
+     * An empty ask side is treated as an infinitely high ask, an empty bid side as 0.
+     */
+    class MarketSignalTracker {
+    private:
+        size_t depth_levels_;
+        MarketSignals signals_;
+        bool has_previous_;
+
+        static double imbalance(Quantity bid_qty, Quantity ask_qty) {
+            if (bid_qty + ask_qty == 0) return 0.0;
+            return (static_cast<double>(bid_qty) - static_cast<double>(ask_qty)) /
+                   static_cast<double>(bid_qty + ask_qty);
+        }
+
+        static double microprice(const TopOfBook& top) {
+            if (top.bid_qty == 0 || top.ask_qty == 0) {
+                return static_cast<double>(top.bid_qty > 0 ? top.bid_price : top.ask_price);
+            }
+            double total = static_cast<double>(top.bid_qty + top.ask_qty);
+            return (static_cast<double>(top.bid_price) * static_cast<double>(top.ask_qty) +
+                    static_cast<double>(top.ask_price) * static_cast<double>(top.bid_qty)) / total;
+        }
+
+        static Price effective_ask(const TopOfBook& top) {
+            return top.ask_qty == 0 ? std::numeric_limits<Price>::max() : top.ask_price;
+        }
+
+        static int64_t order_flow(const TopOfBook& prev, const TopOfBook& next) {
+            int64_t flow = 0;
+            if (next.bid_price >= prev.bid_price) flow += static_cast<int64_t>(next.bid_qty);
+            if (next.bid_price <= prev.bid_price) flow -= static_cast<int64_t>(prev.bid_qty);
+            Price prev_ask = effective_ask(prev);
+            Price next_ask = effective_ask(next);
+            if (next_ask <= prev_ask) flow -= static_cast<int64_t>(next.ask_qty);
+            if (next_ask >= prev_ask) flow += static_cast<int64_t>(prev.ask_qty);
+            return flow;
+        }
+
+    public:
+        explicit MarketSignalTracker(size_t depth_levels = 5)
+            : depth_levels_(depth_levels > 0 ? depth_levels : 1), has_previous_(false) {}
+
+        size_t depth_levels() const { return depth_levels_; }
+        const MarketSignals& signals() const { return signals_; }
+
+        /**
+         * @brief Fold in the book state after one event.
+         * @return True if any signal changed (i.e. worth publishing).
+         */
+        bool update(const TopOfBook& top, Quantity bid_depth_qty, Quantity ask_depth_qty) {
+            bool top_changed = !has_previous_ || top != signals_.top;
+            if (!top_changed && bid_depth_qty == signals_.bid_depth_qty && ask_depth_qty == signals_.ask_depth_qty) {
+                return false;
+            }
+
+            if (top_changed) {
+                signals_.last_ofi = has_previous_ ? order_flow(signals_.top, top) : 0;
+                signals_.cumulative_ofi += signals_.last_ofi;
+                signals_.top = top;
+                signals_.top_imbalance = imbalance(top.bid_qty, top.ask_qty);
+                signals_.microprice = microprice(top);
+                has_previous_ = true;
+            }
+            signals_.bid_depth_qty = bid_depth_qty;
+            signals_.ask_depth_qty = ask_depth_qty;
+            signals_.depth_imbalance = imbalance(bid_depth_qty, ask_depth_qty);
+            signals_.updates++;
+            return true;
+        }
+
+        void reset_ofi() {
+            signals_.last_ofi = 0;
+            signals_.cumulative_ofi = 0;
+        }
+    };
+
+} // namespace OrderEngine
+
+#endif // MARKET_SIGNALS_H
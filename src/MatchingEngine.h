@@ -0,0 +1,269 @@
+#pragma once
+#ifndef MATCHING_ENGINE_H
+#define MATCHING_ENGINE_H
+
+#include "MemoryFootprint.h"
+#include "OrderBook.h"
+#include "ShardPlan.h"
+#include "SpscQueue.h"
+#include "Tsc.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace OrderEngine {
+
+    enum class RequestType : char {
+        ADD = 'A',          // Limit order
+        MARKET = 'E',       // Market order
+        CANCEL = 'X',
+        REPLACE = 'M'       // quantity = new total quantity (or SIZE_UNCHANGED), price = new price (or PRICE_UNCHANGED)
+    };
+
+    /**
+     * @brief One order-entry message on its way to a matcher thread.
+     * @details `tag` is opaque to the engine and comes back in the ack, e.g. a
+     * client sequence number or send timestamp.
+     */
+    struct EngineRequest {
+        RequestType type = RequestType::ADD;
+        uint32_t book = 0;              // Index into the engine's symbols
+        OrderId order_id = 0;
+        OrderSide side = OrderSide::BUY;
+        Price price = 0;
+        Quantity quantity = 0;
+        uint64_t tag = 0;
+    };
+
+    struct EngineAck {
+        uint64_t tag = 0;
+        OrderId order_id = 0;
+        uint64_t completed_tsc = 0;     // Tsc::now() when the book operation returned
+        bool applied = false;           // Traded, rested, cancelled or replaced (false: rejected / not found)
+    };
+
+    /**
+     * @brief Order books sharded over matcher threads, fed through per-thread SPSC queues.
+     * @details
+     * Books are placed on threads by ShardPlan (expected activity per book) and
+     * are only touched by their owner, so the book locks are never contended.
+     * Every request yields one ack on its matcher's ack queue.
+     *
+     * GATEWAY --submit--> [ingress 0] --> MATCHER 0 (books 0, 3) --> [acks 0] --poll--> GATEWAY
+     *                 \-> [ingress 1] --> MATCHER 1 (books 1, 2) --> [acks 1] --/
+     *
+     * Threading: submit() from one producer thread and poll() from one consumer
+     * thread (may be the same one). A running matcher whose ack queue is full
+     * waits for poll(), so a gateway that stops polling stalls its matchers.
+     * Idle matchers spin briefly and then yield the CPU.
+     *
+     * Monitoring reads nothing that needs a book lock: book counters, queue sizes
+     * and per-matcher service histograms are atomics, and the memory footprint of
+     * its books is published by each matcher itself when requestMemoryRefresh()
+     * asks for it (while idle, or between requests when busy).
+     */
+    class MatchingEngine {
+    public:
+        using OrderPtr = std::shared_ptr<Order>;
+        using Book = OrderBook<OrderPtr>;
+
+    private:
+        static constexpr unsigned SPINS_BEFORE_YIELD = 256;
+        // A busy matcher looks for memory refresh requests this often
+        static constexpr uint64_t MEMORY_CHECK_REQUESTS = 4096;
+
+        struct Matcher {
+            SpscQueue<EngineRequest> ingress;
+            SpscQueue<EngineAck> acks;
+            std::thread thread;
+            std::atomic<uint64_t> processed{0};
+            LatencyHistogram service;       // Pop to book operation done, TSC ticks
+            uint64_t memory_generation = 0; // Matcher thread only
+            // Footprints of the shard's books in plan order; std::atomic_load/store only
+            std::shared_ptr<const std::vector<MemoryFootprint>> memory;
+
+            explicit Matcher(size_t capacity) : ingress(capacity), acks(capacity) {}
+        };
+
+        std::vector<std::unique_ptr<Book>> books_;
+        ShardPlan plan_;
+        std::vector<std::unique_ptr<Matcher>> matchers_;
+        std::atomic<bool> running_{false};
+        mutable std::atomic<uint64_t> memory_request_{1};
+        size_t next_poll_ = 0;
+
+        bool apply(const EngineRequest& request) {
+            Book& book = *books_[request.book];
+            switch (request.type) {
+                case RequestType::ADD:
+                case RequestType::MARKET: {
+                    // addOrder reports fills only; an order that rested or was cancelled unfilled was applied too
+                    auto order = request.type == RequestType::MARKET
+                        ? std::make_shared<Order>(request.order_id, book.symbol(), request.side,
+                                                  request.quantity, MARKET_PRICE, OrderType::MARKET)
+                        : std::make_shared<Order>(request.order_id, book.symbol(), request.side,
+                                                  request.quantity, request.price);
+                    book.addOrder(order);
+                    return order->status() != OrderStatus::REJECTED;
+                }
+                case RequestType::CANCEL:
+                    return book.cancelOrder(request.order_id);
+                case RequestType::REPLACE:
+                    return book.replaceOrder(request.order_id, request.quantity, request.price);
+            }
+            return false;
+        }
+
+        // Publish the footprints of this matcher's books if a refresh was asked for
+        void publishMemory(Matcher& matcher, size_t shard) {
+            uint64_t wanted = memory_request_.load(std::memory_order_relaxed);
+            if (wanted == matcher.memory_generation) return;
+            auto footprints = std::make_shared<std::vector<MemoryFootprint>>();
+            for (size_t book : plan_.books(shard)) footprints->push_back(books_[book]->memoryFootprint());
+            std::atomic_store(&matcher.memory, std::shared_ptr<const std::vector<MemoryFootprint>>(std::move(footprints)));
+            matcher.memory_generation = wanted;
+        }
+
+        void runMatcher(Matcher& matcher, size_t shard) {
+            EngineRequest request;
+            unsigned idle = 0;
+            for (;;) {
+                if (!matcher.ingress.try_pop(request)) {
+                    if (running_.load(std::memory_order_acquire)) {
+                        if (idle == 0) publishMemory(matcher, shard);
+                        if (++idle >= SPINS_BEFORE_YIELD) {
+                            std::this_thread::yield();
+                            idle = 0;
+                        }
+                        continue;
+                    }
+                    // Stopped: look again, requests submitted before stop() may only be visible now
+                    if (!matcher.ingress.try_pop(request)) break;
+                }
+                idle = 0;
+                uint64_t begin = Tsc::now();
+                EngineAck ack;
+                ack.tag = request.tag;
+                ack.order_id = request.order_id;
+                ack.applied = apply(request);
+                ack.completed_tsc = Tsc::now();
+                matcher.service.record(ack.completed_tsc - begin);
+                uint64_t processed = matcher.processed.load(std::memory_order_relaxed) + 1;
+                matcher.processed.store(processed, std::memory_order_relaxed);
+                if (processed % MEMORY_CHECK_REQUESTS == 0) publishMemory(matcher, shard);
+                while (!matcher.acks.try_push(ack)) {
+                    if (!running_.load(std::memory_order_acquire)) break; // Stopped and nobody polling
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+    public:
+        /**
+         * @param symbols One book per symbol; requests address books by index.
+         * @param weights Expected activity per book for placement (empty: equal).
+         * @param threads Matcher threads, at least 1.
+         * @param queueCapacity Slots of every ingress and ack queue.
+         */
+        MatchingEngine(const std::vector<Symbol>& symbols, const std::vector<double>& weights, size_t threads,
+                       size_t queueCapacity = 65536)
+            : plan_(weights.size() == symbols.size() ? weights : std::vector<double>(symbols.size(), 1.0), threads) {
+            for (const auto& symbol : symbols) books_.push_back(std::make_unique<Book>(symbol));
+            for (size_t i = 0; i < plan_.shards(); ++i) matchers_.push_back(std::make_unique<Matcher>(queueCapacity));
+        }
+
+        ~MatchingEngine() { stop(); }
+
+        MatchingEngine(const MatchingEngine&) = delete;
+        MatchingEngine& operator=(const MatchingEngine&) = delete;
+
+        // Record per-operation latency in every book (see OrderBook::enableLatencyHistograms); call before start()
+        void enableBookLatency() {
+            for (auto& book : books_) book->enableLatencyHistograms();
+        }
+
+        void start() {
+            if (running_.exchange(true)) return;
+            for (size_t shard = 0; shard < matchers_.size(); ++shard) {
+                matchers_[shard]->thread = std::thread([this, shard] { runMatcher(*matchers_[shard], shard); });
+            }
+        }
+
+        /**
+         * @brief Process everything already submitted, then join the matchers.
+         * @details Acks stay pollable; once stopping, acks that do not fit in a full
+         * ack queue are dropped, so poll first if every ack matters.
+         */
+        void stop() {
+            if (!running_.exchange(false)) return;
+            for (auto& matcher : matchers_) {
+                if (matcher->thread.joinable()) matcher->thread.join();
+            }
+        }
+
+        // Producer thread only; false if the owning matcher's queue is full
+        bool submit(const EngineRequest& request) {
+            return matchers_[plan_.owner(request.book)]->ingress.try_push(request);
+        }
+
+        // Consumer thread only; next ack of any matcher, round robin
+        bool poll(EngineAck& ack) {
+            for (size_t i = 0; i < matchers_.size(); ++i) {
+                size_t index = next_poll_++ % matchers_.size();
+                if (matchers_[index]->acks.try_pop(ack)) return true;
+            }
+            return false;
+        }
+
+        bool running() const { return running_.load(std::memory_order_acquire); }
+        size_t threads() const { return matchers_.size(); }
+        size_t books() const { return books_.size(); }
+        const ShardPlan& plan() const { return plan_; }
+        uint64_t processed(size_t thread) const { return matchers_[thread]->processed.load(std::memory_order_relaxed); }
+        // Requests waiting in a matcher's ingress queue
+        size_t backlog(size_t thread) const { return matchers_[thread]->ingress.size(); }
+        // Acks waiting for poll()
+        size_t ackBacklog(size_t thread) const { return matchers_[thread]->acks.size(); }
+        size_t queueCapacity() const { return matchers_.front()->ingress.capacity(); }
+        // Time from dequeue to book operation done, TSC ticks; readable from any thread
+        const LatencyHistogram& serviceLatency(size_t thread) const { return matchers_[thread]->service; }
+
+        // Ask every running matcher to republish the memory footprint of its books
+        void requestMemoryRefresh() const { memory_request_.fetch_add(1, std::memory_order_relaxed); }
+
+        /**
+         * @brief Last footprints published by a matcher, one per book of plan().books(thread).
+         * @return Null until the matcher has published once after start().
+         */
+        std::shared_ptr<const std::vector<MemoryFootprint>> publishedMemory(size_t thread) const {
+            return std::atomic_load(&matchers_[thread]->memory);
+        }
+
+        // Bytes of the queues and matcher state, not charged to any book
+        size_t sharedMemoryBytes() const {
+            size_t bytes = 0;
+            for (const auto& matcher : matchers_) {
+                bytes += sizeof(Matcher) + matcher->ingress.memory_bytes() + matcher->acks.memory_bytes();
+            }
+            return bytes;
+        }
+        // Read book state only while stopped, or through the book's own locked queries
+        const Book& book(size_t index) const { return *books_[index]; }
+
+        /**
+         * @brief Memory of every book plus the engine's queues (shared, not charged to books).
+         * @details Takes each book lock in turn, so it can run while matching; call it
+         * from a reporting thread at a low rate.
+         */
+        MemoryReport memoryReport() const {
+            MemoryReport report;
+            for (const auto& book : books_) report.add(book->symbol(), book->memoryFootprint());
+            report.add_shared(sharedMemoryBytes());
+            return report;
+        }
+    };
+
+} // namespace OrderEngine
+
+#endif // MATCHING_ENGINE_H
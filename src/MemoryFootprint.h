@@ -0,0 +1,174 @@
+#pragma once
+#ifndef MEMORY_FOOTPRINT_H
+#define MEMORY_FOOTPRINT_H
+
+#include "FormatBuffer.h"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OrderEngine {
+
+    /**
+     * @brief Heap bytes held by one order book, by what holds them.
+     * @details
+     * Map nodes are counted exactly from the trackers' NodePools (free blocks
+     * included, they are not given back). Everything else is counted from
+     * container capacities and object sizes, which is what the allocator was
+     * asked for; allocator headers and fragmentation are not included.
+     * Orders are owned by the caller but kept alive by the book, so resting
+     * orders are charged to it.
+     *
+     * The shape counters explain a large footprint, e.g. order slots far beyond
+     * resting orders, or many spare levels left by a burst of activity.
+     */
+    struct MemoryFootprint {
+        size_t orders = 0;              // Resting order objects
+        size_t price_levels = 0;        // Level objects, their slots and queue trees, spares, level map nodes
+        size_t order_index = 0;         // Order id -> location map nodes
+        size_t liquidity_index = 0;     // Liquidity index nodes and the published pre-trade snapshot
+        size_t stop_orders = 0;         // All of the above, for the stop trackers
+        size_t pending_trades = 0;      // Trade execution queue
+        size_t depth = 0;               // Level delta batch and depth trackers
+        size_t other = 0;               // Time and sales ring, quote sets, latency histograms, perf counters
+
+        size_t resting_orders = 0;
+        size_t levels = 0;
+        size_t spare_levels = 0;        // Emptied levels kept for reuse
+        size_t order_slots = 0;         // Level slots, live or vacated
+        size_t index_nodes = 0;         // Liquidity index nodes in use, one per price holding liquidity
+
+        size_t total() const {
+            return orders + price_levels + order_index + liquidity_index + stop_orders + pending_trades + depth + other;
+        }
+
+        MemoryFootprint& operator+=(const MemoryFootprint& other_book) {
+            orders += other_book.orders;
+            price_levels += other_book.price_levels;
+            order_index += other_book.order_index;
+            liquidity_index += other_book.liquidity_index;
+            stop_orders += other_book.stop_orders;
+            pending_trades += other_book.pending_trades;
+            depth += other_book.depth;
+            other += other_book.other;
+            resting_orders += other_book.resting_orders;
+            levels += other_book.levels;
+            spare_levels += other_book.spare_levels;
+            order_slots += other_book.order_slots;
+            index_nodes += other_book.index_nodes;
+            return *this;
+        }
+    };
+
+    /**
+     * @brief Heap bytes of one object behind an order pointer.
+     * @details A shared_ptr is assumed to come from make_shared: the object shares
+     * one allocation with a control block of two counts and a vtable pointer.
+     */
+    template<typename OrderPtr> struct PointeeFootprint {
+        static constexpr size_t bytes = sizeof(typename std::pointer_traits<OrderPtr>::element_type);
+    };
+
+    template<typename T> struct PointeeFootprint<std::shared_ptr<T>> {
+        static constexpr size_t bytes = sizeof(T) + sizeof(void*) + 2 * sizeof(int);
+    };
+
+    // Buckets plus one node per element (next pointer, cached hash, value) of an unordered container
+    template<typename HashMap> size_t hash_map_bytes(const HashMap& map) {
+        return map.bucket_count() * sizeof(void*) +
+               map.size() * (sizeof(typename HashMap::value_type) + 2 * sizeof(void*));
+    }
+
+    /**
+     * @brief Named footprints of many books, printed largest first with a total.
+     * @details
+     * Byte columns are KB ("other" folds stop orders, pending trades, depth and
+     * the rest); count columns are resting orders, levels, level slots and
+     * liquidity index nodes. A book with 1300 price levels (1000 bid, 300 ask) of one order each:
+     *
+     * book          total KB orders KB levels KB  index KB    liq KB  other KB   orders  levels    slots liq nodes
+     * WIDE               728       143       288        84        96       119     1300    1300     1300      1300
+     */
+    class MemoryReport {
+    private:
+        struct Entry {
+            std::string name;
+            MemoryFootprint footprint;
+        };
+
+        std::vector<Entry> entries_;
+        MemoryFootprint total_;
+        size_t shared_bytes_ = 0;       // Held outside any book (e.g. engine queues)
+
+        static FormatBuffer& append_kb(FormatBuffer& out, size_t bytes, size_t width) {
+            return out.append_uint_padded((bytes + 1023) / 1024, width);
+        }
+
+    public:
+        void add(const std::string& name, const MemoryFootprint& footprint) {
+            entries_.push_back(Entry{name, footprint});
+            total_ += footprint;
+        }
+
+        void add_shared(size_t bytes) { shared_bytes_ += bytes; }
+
+        size_t books() const { return entries_.size(); }
+        const MemoryFootprint& total() const { return total_; }
+        size_t shared_bytes() const { return shared_bytes_; }
+        size_t total_bytes() const { return total_.total() + shared_bytes_; }
+
+        /**
+         * @brief Append the report, largest book first.
+         * @param limit Print at most this many books (the total always covers all of them).
+         */
+        void format_to(FormatBuffer& out, size_t limit = static_cast<size_t>(-1)) const {
+            std::vector<const Entry*> sorted;
+            for (const auto& entry : entries_) sorted.push_back(&entry);
+            std::stable_sort(sorted.begin(), sorted.end(), [](const Entry* a, const Entry* b) {
+                return a->footprint.total() > b->footprint.total();
+            });
+
+            out.append_padded("book", 12, false)
+               .append_padded("total KB", 10).append_padded("orders KB", 10).append_padded("levels KB", 10)
+               .append_padded("index KB", 10).append_padded("liq KB", 10).append_padded("other KB", 10)
+               .append_padded("orders", 9).append_padded("levels", 8).append_padded("slots", 9)
+               .append_padded("liq nodes", 10).append("\n");
+
+            auto append_row = [&](const std::string& name, const MemoryFootprint& f) {
+                out.append_padded(name, 12, false);
+                append_kb(out, f.total(), 10);
+                append_kb(out, f.orders, 10);
+                append_kb(out, f.price_levels, 10);
+                append_kb(out, f.order_index, 10);
+                append_kb(out, f.liquidity_index, 10);
+                append_kb(out, f.stop_orders + f.pending_trades + f.depth + f.other, 10);
+                out.append_uint_padded(f.resting_orders, 9).append_uint_padded(f.levels, 8)
+                   .append_uint_padded(f.order_slots, 9).append_uint_padded(f.index_nodes, 10);
+                out.append('\n');
+            };
+            for (size_t i = 0; i < sorted.size() && i < limit; ++i) {
+                append_row(sorted[i]->name, sorted[i]->footprint);
+            }
+            if (sorted.size() > limit) {
+                out.append("... ").append_uint(sorted.size() - limit).append(" more\n");
+            }
+            append_row("all books", total_);
+            if (shared_bytes_ > 0) {
+                out.append("shared ");
+                append_kb(out, shared_bytes_, 0).append(" KB, total ");
+                append_kb(out, total_bytes(), 0).append(" KB\n");
+            }
+        }
+
+        std::string ToString(size_t limit = static_cast<size_t>(-1)) const {
+            FormatBuffer out(1024);
+            format_to(out, limit);
+            return out.str();
+        }
+    };
+
+} // namespace OrderEngine
+
+#endif // MEMORY_FOOTPRINT_H
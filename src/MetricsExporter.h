@@ -0,0 +1,253 @@
+#pragma once
+#ifndef METRICS_EXPORTER_H
+#define METRICS_EXPORTER_H
+
+#include "FormatBuffer.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace OrderEngine {
+
+    /**
+     * @brief Builder for the Prometheus text exposition format (version 0.0.4).
+     * @details
+     * Call family() once per metric name, then sample() for each label set of
+     * that name. Label values are escaped; names are the caller's responsibility.
+     *
+     * # HELP ome_trades_total Trades executed
+     * # TYPE ome_trades_total counter
+     * ome_trades_total{book="INFY",shard="0"} 1523
+     */
+    class PrometheusText {
+    public:
+        using Label = std::pair<std::string_view, std::string_view>;
+
+    private:
+        FormatBuffer out_;
+
+        void append_labels(std::initializer_list<Label> labels) {
+            if (labels.size() == 0) return;
+            out_.append('{');
+            bool first = true;
+            for (const auto& [name, value] : labels) {
+                if (!first) out_.append(',');
+                first = false;
+                out_.append(name).append("=\"");
+                for (char c : value) {
+                    if (c == '\\' || c == '"') out_.append('\\').append(c);
+                    else if (c == '\n') out_.append("\\n");
+                    else out_.append(c);
+                }
+                out_.append('"');
+            }
+            out_.append('}');
+        }
+
+    public:
+        explicit PrometheusText(size_t capacity = 16384) : out_(capacity) {}
+
+        void clear() { out_.clear(); }
+        std::string_view view() const { return out_.view(); }
+        std::string str() const { return out_.str(); }
+
+        // type: counter, gauge, summary or untyped
+        PrometheusText& family(std::string_view name, std::string_view type, std::string_view help) {
+            out_.append("# HELP ").append(name).append(' ').append(help).append('\n');
+            out_.append("# TYPE ").append(name).append(' ').append(type).append('\n');
+            return *this;
+        }
+
+        PrometheusText& sample(std::string_view name, std::initializer_list<Label> labels, uint64_t value) {
+            out_.append(name);
+            append_labels(labels);
+            out_.append(' ').append_uint(value).append('\n');
+            return *this;
+        }
+
+        PrometheusText& sample(std::string_view name, std::initializer_list<Label> labels, double value) {
+            char scratch[32];
+            int length = std::snprintf(scratch, sizeof(scratch), "%.9g", value);
+            out_.append(name);
+            append_labels(labels);
+            out_.append(' ').append(std::string_view(scratch, static_cast<size_t>(length))).append('\n');
+            return *this;
+        }
+    };
+
+    struct MetricsExporterConfig {
+        std::string file_path;              // Rewritten atomically every interval (empty: no file)
+        std::string socket_path;            // Unix stream socket serving the latest snapshot (empty: none)
+        std::chrono::milliseconds interval{1000};
+    };
+
+    /**
+     * @brief Periodic metrics snapshots published to a file and a local socket.
+     * @details
+     * One background thread calls the collector every interval, writes the
+     * text to `file_path` through a temporary file and rename() (readers such as
+     * the node_exporter textfile collector never see a partial file), and keeps
+     * it as the answer for the Unix socket: every connection receives the latest
+     * snapshot and is closed, e.g. `socat - UNIX-CONNECT:/run/ome.sock`.
+     * The collector only ever runs on the exporter thread, so it may keep state
+     * between snapshots (previous counters for rates) without locking.
+     */
+    class MetricsExporter {
+    public:
+        using Collector = std::function<void(PrometheusText&)>;
+
+    private:
+        Collector collector_;
+        MetricsExporterConfig config_;
+        std::thread thread_;
+        std::atomic<bool> running_{false};
+        std::atomic<uint64_t> snapshots_{0};
+        std::atomic<uint64_t> write_errors_{0};
+        std::atomic<uint64_t> clients_served_{0};
+        int listen_fd_ = -1;
+        std::string error_;
+        PrometheusText text_;               // Exporter thread only once started
+
+        static constexpr std::chrono::milliseconds MAX_POLL{100}; // Bounds how long stop() waits
+
+        bool writeFile(std::string_view text) const {
+            std::string temporary = config_.file_path + ".tmp";
+            FILE* out = std::fopen(temporary.c_str(), "w");
+            if (!out) return false;
+            bool ok = std::fwrite(text.data(), 1, text.size(), out) == text.size();
+            ok = std::fclose(out) == 0 && ok;
+            return ok && std::rename(temporary.c_str(), config_.file_path.c_str()) == 0;
+        }
+
+        void serveClient(int fd) const {
+            timeval timeout{1, 0}; // A stalled reader must not hold up snapshots for long
+            setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+            std::string_view text = text_.view();
+            while (!text.empty()) {
+                ssize_t sent = ::send(fd, text.data(), text.size(), MSG_NOSIGNAL);
+                if (sent < 0 && errno == EINTR) continue;
+                if (sent <= 0) break;
+                text.remove_prefix(static_cast<size_t>(sent));
+            }
+            ::close(fd);
+        }
+
+        void snapshot() {
+            text_.clear();
+            collector_(text_);
+            if (!config_.file_path.empty() && !writeFile(text_.view())) {
+                write_errors_.fetch_add(1, std::memory_order_relaxed);
+            }
+            snapshots_.fetch_add(1, std::memory_order_release);
+        }
+
+        void run() {
+            auto next = std::chrono::steady_clock::now();
+            while (running_.load(std::memory_order_acquire)) {
+                auto now = std::chrono::steady_clock::now();
+                if (now >= next) {
+                    snapshot();
+                    next += config_.interval;
+                    if (next < now) next = now + config_.interval; // Collector overran, skip missed ticks
+                    continue;
+                }
+                auto wait = std::min(std::chrono::duration_cast<std::chrono::milliseconds>(next - now) +
+                                     std::chrono::milliseconds(1), MAX_POLL);
+                if (listen_fd_ < 0) {
+                    std::this_thread::sleep_for(wait);
+                    continue;
+                }
+                pollfd listener{listen_fd_, POLLIN, 0};
+                if (::poll(&listener, 1, static_cast<int>(wait.count())) <= 0) continue;
+                int client = ::accept(listen_fd_, nullptr, nullptr);
+                if (client < 0) continue;
+                serveClient(client);
+                clients_served_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        bool openSocket() {
+            sockaddr_un address{};
+            if (config_.socket_path.size() >= sizeof(address.sun_path)) {
+                error_ = "socket path too long: " + config_.socket_path;
+                return false;
+            }
+            address.sun_family = AF_UNIX;
+            std::memcpy(address.sun_path, config_.socket_path.c_str(), config_.socket_path.size() + 1);
+
+            listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            if (listen_fd_ < 0) {
+                error_ = std::string("socket: ") + std::strerror(errno);
+                return false;
+            }
+            ::unlink(config_.socket_path.c_str()); // Left behind by a previous run
+            if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+                ::listen(listen_fd_, 16) < 0) {
+                error_ = config_.socket_path + ": " + std::strerror(errno);
+                ::close(listen_fd_);
+                listen_fd_ = -1;
+                return false;
+            }
+            return true;
+        }
+
+    public:
+        MetricsExporter(Collector collector, MetricsExporterConfig config)
+            : collector_(std::move(collector)), config_(std::move(config)) {}
+
+        ~MetricsExporter() { stop(); }
+
+        MetricsExporter(const MetricsExporter&) = delete;
+        MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+        /**
+         * @brief Bind the socket (if configured) and start snapshotting; the first snapshot is taken at once.
+         * @return False with error() set if the socket cannot be bound.
+         */
+        bool start() {
+            if (running_.load()) return true;
+            if (!config_.socket_path.empty() && !openSocket()) return false;
+            running_.store(true, std::memory_order_release);
+            thread_ = std::thread([this] { run(); });
+            return true;
+        }
+
+        void stop() {
+            if (!running_.exchange(false)) return;
+            if (thread_.joinable()) thread_.join();
+            if (listen_fd_ >= 0) {
+                ::close(listen_fd_);
+                ::unlink(config_.socket_path.c_str());
+                listen_fd_ = -1;
+            }
+        }
+
+        // Collect once on the calling thread; only while not started
+        std::string collectNow() {
+            PrometheusText text;
+            collector_(text);
+            return text.str();
+        }
+
+        const std::string& error() const { return error_; }
+        uint64_t snapshots() const { return snapshots_.load(std::memory_order_acquire); }
+        uint64_t writeErrors() const { return write_errors_.load(std::memory_order_relaxed); }
+        uint64_t clientsServed() const { return clients_served_.load(std::memory_order_relaxed); }
+    };
+
+} // namespace OrderEngine
+
+#endif // METRICS_EXPORTER_H
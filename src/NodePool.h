@@ -0,0 +1,128 @@
+#pragma once
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace OrderEngine {
+
+    /**
+     * @brief Free list of fixed-size blocks carved from chunks, for node based containers.
+     * @details
+     * The block size is fixed by the first allocation (a std::map only ever
+     * allocates its node type). Freed blocks go back on the free list and are
+     * never returned to the heap before the pool is destroyed, so a container
+     * that has reached its working size stops allocating altogether.
+     * Requests of any other size fall through to the global operator new.
+     * Not thread-safe: share a pool only between containers guarded by one lock.
+     *
+     * CHUNK : [ node | node | node | ... | node ]   CHUNK_NODES blocks
+     * FREE  : head -> node -> node -> nullptr       intrusive, through the block itself
+     */
+    class NodePool {
+    private:
+        struct FreeBlock { FreeBlock* next; };
+
+        static constexpr size_t CHUNK_NODES = 64;
+
+        size_t block_size_ = 0;
+        FreeBlock* free_ = nullptr;
+        size_t capacity_ = 0;    // Blocks carved so far
+        size_t in_use_ = 0;
+        std::vector<void*> chunks_;
+
+        static size_t rounded(size_t bytes) {
+            constexpr size_t align = alignof(std::max_align_t);
+            bytes = bytes < sizeof(FreeBlock) ? sizeof(FreeBlock) : bytes;
+            return (bytes + align - 1) / align * align;
+        }
+
+        void grow(size_t blocks) {
+            char* chunk = static_cast<char*>(::operator new(blocks * block_size_));
+            chunks_.push_back(chunk);
+            for (size_t i = blocks; i-- > 0;) {
+                auto* block = reinterpret_cast<FreeBlock*>(chunk + i * block_size_);
+                block->next = free_;
+                free_ = block;
+            }
+            capacity_ += blocks;
+        }
+
+    public:
+        NodePool() = default;
+        ~NodePool() {
+            for (void* chunk : chunks_) ::operator delete(chunk);
+        }
+
+        NodePool(const NodePool&) = delete;
+        NodePool& operator=(const NodePool&) = delete;
+
+        void* allocate(size_t bytes) {
+            if (block_size_ == 0) block_size_ = rounded(bytes);
+            if (rounded(bytes) != block_size_) return ::operator new(bytes);
+            if (!free_) grow(CHUNK_NODES);
+            FreeBlock* block = free_;
+            free_ = block->next;
+            ++in_use_;
+            return block;
+        }
+
+        void deallocate(void* p, size_t bytes) {
+            if (rounded(bytes) != block_size_) {
+                ::operator delete(p);
+                return;
+            }
+            auto* block = static_cast<FreeBlock*>(p);
+            block->next = free_;
+            free_ = block;
+            --in_use_;
+        }
+
+        size_t block_size() const { return block_size_; }
+        size_t capacity() const { return capacity_; }
+        size_t in_use() const { return in_use_; }
+        // Heap bytes held by the pool, in use or free
+        size_t bytes_reserved() const { return capacity_ * block_size_; }
+    };
+
+    /**
+     * @brief Standard allocator drawing single-object allocations from a NodePool.
+     * @details
+     * Copies and rebinds share the pool, so `std::map<K, V, C, PoolAllocator<...>>`
+     * pools its nodes. Array allocations (n > 1) and a null pool use the global heap.
+     * The pool must outlive every container using it.
+     */
+    template<typename T> class PoolAllocator {
+    private:
+        NodePool* pool_;
+
+        template<typename U> friend class PoolAllocator;
+
+    public:
+        using value_type = T;
+
+        explicit PoolAllocator(NodePool* pool = nullptr) noexcept : pool_(pool) {}
+        template<typename U> PoolAllocator(const PoolAllocator<U>& other) noexcept : pool_(other.pool_) {}
+
+        T* allocate(size_t n) {
+            static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned types are not pooled");
+            if (n != 1 || !pool_) return static_cast<T*>(::operator new(n * sizeof(T)));
+            return static_cast<T*>(pool_->allocate(sizeof(T)));
+        }
+
+        void deallocate(T* p, size_t n) noexcept {
+            if (n != 1 || !pool_) ::operator delete(p);
+            else pool_->deallocate(p, sizeof(T));
+        }
+
+        NodePool* pool() const { return pool_; }
+
+        template<typename U> bool operator==(const PoolAllocator<U>& other) const { return pool_ == other.pool_; }
+        template<typename U> bool operator!=(const PoolAllocator<U>& other) const { return pool_ != other.pool_; }
+    };
+
+} // namespace OrderEngine
+
+#endif // NODE_POOL_H
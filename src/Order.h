@@ -14,7 +14,7 @@ namespace OrderEngine {
       OrderType order_type_;
       TimeInForce time_in_force_;
       OrderStatus status_;
-      Timestamp timestamp_;
+      Timestamp timestamp_; // Set by the book's Clock on acceptance
   public:
       Order(OrderId id, const Symbol& symbol, OrderSide side, Quantity qty,
             Price price, OrderType type = OrderType::LIMIT,
@@ -22,10 +22,10 @@ namespace OrderEngine {
           : order_id_(id), symbol_(symbol), side_(side), quantity_(qty),
             open_quantity_(qty), price_(price), stop_price_(0),
             order_type_(type), time_in_force_(tif), status_(OrderStatus::PENDING),
-            timestamp_(std::chrono::high_resolution_clock::now()) {}
+            timestamp_() {}
 
       OrderId order_id() const { return order_id_; }
-      Symbol symbol() const { return symbol_; }
+      const Symbol& symbol() const { return symbol_; }
       OrderSide side() const { return side_; }
       Quantity quantity() const { return quantity_; }
       Quantity open_quantity() const { return open_quantity_; }
@@ -41,6 +41,7 @@ namespace OrderEngine {
       void set_price(Price price) { price_ = price; }
       void set_status(OrderStatus status) { status_ = status; }
       void set_stop_price(Price price) { stop_price_ = price; }
+      void set_timestamp(Timestamp timestamp) { timestamp_ = timestamp; }
 
       // Optional methods for advanced features
       bool is_buy() const { return side() == OrderSide::BUY; }
@@ -3,10 +3,19 @@
 #define ORDER_BOOK_H
 
 #include "OrderTypes.h"
+#include "Clock.h"
 #include "Listeners.h"
 #include "OrderTracker.h"
+#include "MarketSignals.h"
+#include "TimeAndSales.h"
+#include "LatencyHistogram.h"
+#include "PerfCounters.h"
+#include "TraceRing.h"
 #include <atomic>
+#include <limits>
+#include <memory>
 #include <mutex>
+#include <unordered_map>
 namespace OrderEngine{
 
     /**
@@ -25,9 +34,9 @@ namespace OrderEngine{
         FillFlags flags;
         
         TradeExecution(const OrderPtr& inbound, const OrderPtr& resting, 
-                    Quantity qty, Price p, FillFlags f = FILL_NORMAL)
+                    Quantity qty, Price p, Timestamp ts, FillFlags f = FILL_NORMAL)
             : inbound_order(inbound), resting_order(resting), quantity(qty), 
-            price(p), timestamp(std::chrono::high_resolution_clock::now()), flags(f) {}
+            price(p), timestamp(ts), flags(f) {}
     };
     
     /**
@@ -55,6 +64,67 @@ namespace OrderEngine{
         }
     };
 
+    /**
+     * @brief Immutable copy of the best slots of both sides' liquidity indexes.
+     * @details
+     * Published by OrderBook for pre-trade queries, so readers compute on it 
+     * without holding the book lock. `version` is the book version it was taken at.
+     * Each side holds at most OrderBook::SNAPSHOT_BAND_SLOTS slots, so publishing
+     * costs the same however wide the book is.
+     */
+    struct LiquiditySnapshot {
+        uint64_t version;
+        LiquidityBand bids;     // Highest price first
+        LiquidityBand asks;     // Lowest price first
+    };
+
+    /**
+     * @brief Net level changes collected over one book operation.
+     * @details
+     * Attached to both trackers as a LevelChangeListener. Repeated changes of the same
+     * level are folded into one LevelDelta (first old quantity, last new quantity),
+     * so a multi-order operation such as a mass quote yields one entry per level.
+     */
+    class LevelDeltaCollector : public LevelChangeListener {
+    private:
+        std::vector<LevelDelta> deltas_;
+
+    public:
+        void on_level_change(bool is_buy_side, Price price, Quantity old_qty, Quantity new_qty,
+                            size_t, size_t) override {
+            // Operations touch a handful of levels, a linear scan beats hashing here
+            for (auto& delta : deltas_) {
+                if (delta.is_bid == is_buy_side && delta.price == price) {
+                    delta.new_qty = new_qty;
+                    return;
+                }
+            }
+            deltas_.push_back(LevelDelta{is_buy_side, price, old_qty, new_qty});
+        }
+
+        // Drop levels whose net change is nil; true if anything is left to publish
+        bool settle() {
+            deltas_.erase(std::remove_if(deltas_.begin(), deltas_.end(),
+                [](const LevelDelta& delta) { return delta.old_qty == delta.new_qty; }), deltas_.end());
+            return !deltas_.empty();
+        }
+
+        const std::vector<LevelDelta>& deltas() const { return deltas_; }
+        void clear() { deltas_.clear(); }
+        size_t memory_bytes() const { return deltas_.capacity() * sizeof(LevelDelta); }
+    };
+
+    /**
+     * @brief Outcome of OrderBook::massQuote, counted per quote entry.
+     */
+    struct MassQuoteResult {
+        size_t added = 0;       // New price points (may have traded on entry)
+        size_t modified = 0;    // Existing quote resized (in place when the size went down)
+        size_t unchanged = 0;   // Existing quote left untouched, priority kept
+        size_t cancelled = 0;   // Previous quotes absent from the new set
+        size_t rejected = 0;    // Invalid or duplicate entries
+    };
+
     /**
      * @brief The OrderBook class manages buy and sell orders, matches trades, and notifies listeners of events.
      * @remarks 
@@ -81,6 +151,9 @@ namespace OrderEngine{
         OrderTracker mStopBidTracker; // Manages all stop buy orders
         OrderTracker mStopAskTracker; // Manages all stop sell orders
 
+        // Stamps accepted orders and fills
+        std::shared_ptr<Clock> mClock;
+
         // Market state
         std::atomic<Price> mMarketPrice;
         std::atomic<Price> mLastTradePrice;
@@ -94,22 +167,52 @@ namespace OrderEngine{
 
         // Statistics
         OrderBookStats mStats;
+        std::unique_ptr<OrderBookLatency> mLatency; // Null until enableLatencyHistograms()
+        std::unique_ptr<OrderBookPerf> mPerf;       // Null until enablePerfCounters()
+
+        // Microstructure signals, updated once per book event for all subscribers
+        MarketSignalTracker mSignals;
 
         // Thread safety
         mutable std::recursive_mutex mBookMutex;
 
-        // Trade execution queue for batch processing
+        // Live quote set of every participant, see massQuote
+        std::unordered_map<ParticipantId, std::vector<OrderPtr>> mQuotes;
+
+        // Level changes of the current operation, published to depth listeners as one batch
+        LevelDeltaCollector mLevelDeltas;
+
+        // Trade execution queue for batch processing (cleared after every operation)
         std::vector<TradeExecution> mPendingTrades;
 
+        // Recent trade history, readable from any thread without the book lock
+        TimeAndSales mTimeAndSales;
+
+        // Pre-trade snapshot publishing
+        std::atomic<uint64_t> mBookVersion;  // Bumped by every operation that changes the book
+        mutable std::shared_ptr<const LiquiditySnapshot> mLiquiditySnapshot; // std::atomic_load/store only
+
         public:
-        explicit OrderBook(const Symbol& symbol) : mSymbol(symbol), 
+        // Slots per side copied into a LiquiditySnapshot; deeper sweeps use the live index
+        static constexpr size_t SNAPSHOT_BAND_SLOTS = 256;
+
+        /**
+         * @param symbol Instrument traded in this book.
+         * @param tradeHistory Capacity of the time-and-sales ring (rounded up to a power of two).
+         * @param clock Timestamp source for orders and fills (default: the shared TscClock).
+         */
+        explicit OrderBook(const Symbol& symbol, size_t tradeHistory = TimeAndSales::DEFAULT_CAPACITY,
+                           std::shared_ptr<Clock> clock = defaultClock()) : mSymbol(symbol), 
             mBidTracker(true),   
             mAskTracker(false),   
             mStopBidTracker(true),
             mStopAskTracker(false),
+            mClock(std::move(clock)),
             mMarketPrice(0),
             mLastTradePrice(0),
-            mLastTradeQuantity(0){
+            mLastTradeQuantity(0),
+            mTimeAndSales(tradeHistory),
+            mBookVersion(0){
                 mPendingTrades.reserve(1000); 
         }
         
@@ -122,6 +225,26 @@ namespace OrderEngine{
             // todo: checkStopOrders();
         }
 
+        /**
+         * @brief Start recording per-operation latency histograms (see OrderBookLatency).
+         * @details Off by default: the histograms take ~45 KB per book, and a disabled
+         * book pays one branch per timed scope. Enable before the book sees traffic.
+         */
+        void enableLatencyHistograms() {
+            std::lock_guard<std::recursive_mutex> lock(mBookMutex);
+            if (!mLatency) mLatency = std::make_unique<OrderBookLatency>();
+        }
+
+        /**
+         * @brief Start attributing hardware counter deltas to operation types (see OrderBookPerf).
+         * @details Off by default: every timed scope then costs two perf counter reads
+         * (syscalls). Counters are opened per thread on first use.
+         */
+        void enablePerfCounters() {
+            std::lock_guard<std::recursive_mutex> lock(mBookMutex);
+            if (!mPerf) mPerf = std::make_unique<OrderBookPerf>();
+        }
+
         // ========== Listener Management ==========
 
         void addOrderListener(OrderListenerPtr listener) {
@@ -141,6 +264,11 @@ namespace OrderEngine{
     
         void addDepthListener(DepthListenerPtr listener) {
             std::lock_guard<std::recursive_mutex> lock(mBookMutex);
+            if (mDepthListeners.empty()) {
+                // Only pay for level collection once somebody consumes it
+                mBidTracker.add_level_listener(&mLevelDeltas);
+                mAskTracker.add_level_listener(&mLevelDeltas);
+            }
             mDepthListeners.push_back(listener);
         }
 
@@ -151,37 +279,511 @@ namespace OrderEngine{
          * @param order The order to be added.
          * @param conditions Special conditions for order execution (default is NO_CONDITIONS).
          * @details
-         * - Validates the order parameters.
+         * - Validates the order parameters and rejects an id that is already resting.
+         * - Folds the order's time in force (IOC / FOK) into the conditions and rejects an
+         *   all-or-none limit order that is not also immediate-or-cancel (resting AON is not supported).
+         * - Matches market and limit orders against the opposite side in a single pass.
+         * - Rests the unfilled part of a limit order unless it is immediate-or-cancel,
+         *   cancels the unfilled part of a market order.
          * @todo 
-         * - Implement handling for different order types (limit, stop, etc.).
-         * - Implement notifications to listeners for order acceptance.
+         * - Implement handling for stop orders.
          * - Update market data and depth after adding the order.
-         * @return True if the order was successfully added, false otherwise.
+         * @return True if any quantity of the order was filled, false otherwise.
          */
         bool addOrder(const OrderPtr& order, OrderConditions conditions = NO_CONDITIONS){
             
             std::lock_guard<std::recursive_mutex> lock(mBookMutex); // acquire lock
+            ScopedLatency timer(latencyOf(&OrderBookLatency::add));
+            ScopedPerfSample counters(perfOf(&OrderBookPerf::add));
+            Trace::Scope trace(Trace::Event::ADD_ORDER, order ? order->order_id() : 0, order ? order->open_quantity() : 0);
             
             if (!validateOrder(order)) {
                 rejectOrder(order, "Invalid order parameters");
                 return false;
             }
+
+            // A second live order under the same id would overwrite the first one's location
+            if (findRestingOrder(order->order_id())) {
+                rejectOrder(order, "Duplicate order id");
+                return false;
+            }
+            
+            if (order->is_stop()) {
+                // todo: add order processing for stop orders (mStopBidTracker / mStopAskTracker)
+                return false;
+            }
+            
+            conditions = withTimeInForce(order, conditions);
+            // Resting orders are not protected from partial fills, so AON needs immediacy (FOK)
+            if (!order->is_market() && IsAllOrNone(conditions) && !isImmediateOrCancel(conditions)) {
+                rejectOrder(order, "All-or-none limit order must be immediate-or-cancel");
+                return false;
+            }
+            acceptOrder(order);
             
             bool filled = false;
             
             if(order->is_market()){
                 filled = processMarketOrder(order, conditions);
             } 
-            // todo: add order processing for stop order and limit order
-            // todo: add notification that order is accepted
-            // todo: update market data and depth
+            else {
+                filled = processLimitOrder(order, conditions);
+            }
+            completeOperation();
             return filled;
         }
 
+        /**
+         * @brief Cancel a resting order.
+         * @return True if the order was resting in this book and has been cancelled.
+         */
+        bool cancelOrder(OrderId orderId) {
+            std::lock_guard<std::recursive_mutex> lock(mBookMutex);
+            ScopedLatency timer(latencyOf(&OrderBookLatency::cancel));
+            ScopedPerfSample counters(perfOf(&OrderBookPerf::cancel));
+            Trace::Scope trace(Trace::Event::CANCEL_ORDER, orderId);
+
+            OrderPtr order = findRestingOrder(orderId);
+            if (!order) return false;
+
+            cancelResting(order);
+            completeOperation();
+            return true;
+        }
+
+        /**
+         * @brief Take `quantity` off a resting order without touching its priority.
+         * @details
+         * A partial cancel, also used to apply executions reported by an external venue
+         * (market data replay). The order is cancelled outright once nothing is left;
+         * otherwise on_cancel reports the reduced quantity and the order stays live.
+         * @return True if the order was resting in this book.
+         */
+        bool reduceOrder(OrderId orderId, Quantity quantity) {
+            std::lock_guard<std::recursive_mutex> lock(mBookMutex);
+            ScopedLatency timer(latencyOf(&OrderBookLatency::cancel));
+            ScopedPerfSample counters(perfOf(&OrderBookPerf::cancel));
+            Trace::Scope trace(Trace::Event::CANCEL_ORDER, orderId, quantity);
+
+            OrderPtr order = findRestingOrder(orderId);
+            if (!order) return false;
+
+            if (quantity >= order->open_quantity()) {
+                cancelResting(order);
+            }
+            else {
+                OrderTracker& ownSide = order->is_buy() ? mBidTracker : mAskTracker;
+                order->set_quantity(order->quantity() - quantity);
+                ownSide.replace_order(order, order->price(), order->open_quantity() - quantity);
+                for (const auto& listener : mOrderListeners) {
+                    listener->on_cancel(order, quantity);
+                }
+            }
+            completeOperation();
+            return true;
+        }
+
+        /**
+         * @brief Cancel/replace a resting order as one atomic operation.
+         * @param orderId Resting order to modify.
+         * @param newQuantity New total order quantity (filled quantity included), or SIZE_UNCHANGED.
+         * @param newPrice New limit price, or PRICE_UNCHANGED.
+         * @details
+         * - Same price with less open quantity is modified in place and keeps time priority.
+         * - A larger quantity or a new price loses priority and goes to the back of the queue.
+         * - A new price that crosses the opposite side is matched like an inbound limit
+         *   order, whatever is left rests at the new price.
+         * The order keeps its id, so on_replace is raised with the same order as old and new.
+         * @return True if the replace was applied, false if the order was not found or the
+         *         replace was rejected (on_replace_reject).
+         */
+        bool replaceOrder(OrderId orderId, Quantity newQuantity = SIZE_UNCHANGED, Price newPrice = PRICE_UNCHANGED) {
+            std::lock_guard<std::recursive_mutex> lock(mBookMutex);
+            ScopedLatency timer(latencyOf(&OrderBookLatency::replace));
+            ScopedPerfSample counters(perfOf(&OrderBookPerf::replace));
+            Trace::Scope trace(Trace::Event::REPLACE_ORDER, orderId, newQuantity == SIZE_UNCHANGED ? 0 : newQuantity);
+
+            OrderPtr order = findRestingOrder(orderId);
+            if (!order) return false;
+
+            bool replaced = replaceResting(order, newQuantity, newPrice);
+            if (replaced) completeOperation();
+            return replaced;
+        }
+
+        /**
+         * @brief Replace a participant's whole quote set in one atomic operation.
+         * @param participant Owner of the quotes; each participant has one live set per book.
+         * @param quotes New quote set: limit orders, at most one per side and price.
+         *        An empty set pulls all of the participant's quotes.
+         * @details
+         * The new set is diffed against the participant's previous one by (side, price):
+         * - price points only in the previous set are cancelled,
+         * - price points in both keep the resting order (the new entry object is not used);
+         *   a smaller size is modified in place (priority kept), a larger one is re-queued,
+         *   an equal one is untouched,
+         * - price points only in the new set are entered like addOrder and may trade.
+         * Previous quotes that traded out completely count as absent. The whole update
+         * runs under one book lock, bumps the book version once and reaches depth
+         * listeners as a single coalesced on_depth_update.
+         * @return Per-entry counts; see MassQuoteResult.
+         */
+        MassQuoteResult massQuote(ParticipantId participant, const std::vector<OrderPtr>& quotes) {
+            std::lock_guard<std::recursive_mutex> lock(mBookMutex);
+            Trace::Scope trace(Trace::Event::MASS_QUOTE, participant, quotes.size());
+            MassQuoteResult result;
+
+            std::vector<OrderPtr> previous;
+            auto quotes_it = mQuotes.find(participant);
+            if (quotes_it != mQuotes.end()) {
+                for (const auto& order : quotes_it->second) {
+                    const OrderTracker& ownSide = order->is_buy() ? mBidTracker : mAskTracker;
+                    // Same object only: the id may have been reused by another order since
+                    if (ownSide.find_order(order->order_id()) == order) previous.push_back(order);
+                }
+            }
+
+            // Pair every new entry with the previous quote at the same side and price
+            std::vector<OrderPtr> kept(quotes.size());
+            std::vector<bool> valid(quotes.size(), false);
+            std::vector<bool> carried(previous.size(), false);
+            for (size_t i = 0; i < quotes.size(); ++i) {
+                const OrderPtr& quote = quotes[i];
+                if (!quote) {
+                    result.rejected++;
+                    continue;
+                }
+                if (!validateOrder(quote) || quote->is_market() || quote->is_stop() || isDuplicateQuote(quotes, valid, i)) {
+                    rejectOrder(quote, "Invalid quote");
+                    result.rejected++;
+                    continue;
+                }
+                valid[i] = true;
+                for (size_t j = 0; j < previous.size(); ++j) {
+                    if (!carried[j] && previous[j]->side() == quote->side() && previous[j]->price() == quote->price()) {
+                        carried[j] = true;
+                        kept[i] = previous[j];
+                        break;
+                    }
+                }
+            }
+
+            // Pull stale quotes first so they can never trade against the new ones
+            for (size_t j = 0; j < previous.size(); ++j) {
+                if (carried[j]) continue;
+                cancelResting(previous[j]);
+                result.cancelled++;
+            }
+
+            std::vector<OrderPtr> current;
+            current.reserve(quotes.size());
+            for (size_t i = 0; i < quotes.size(); ++i) {
+                if (!valid[i]) continue;
+                if (kept[i]) {
+                    if (kept[i]->open_quantity() == quotes[i]->open_quantity()) {
+                        result.unchanged++;
+                    }
+                    else {
+                        Quantity filledQty = kept[i]->quantity() - kept[i]->open_quantity();
+                        replaceResting(kept[i], filledQty + quotes[i]->open_quantity(), PRICE_UNCHANGED);
+                        result.modified++;
+                    }
+                    current.push_back(kept[i]);
+                    continue;
+                }
+                if (findRestingOrder(quotes[i]->order_id())) {
+                    rejectOrder(quotes[i], "Duplicate order id");
+                    result.rejected++;
+                    continue;
+                }
+                acceptOrder(quotes[i]);
+                processLimitOrder(quotes[i], withTimeInForce(quotes[i], NO_CONDITIONS));
+                result.added++;
+                if (quotes[i]->open_quantity() > 0 && quotes[i]->status() != OrderStatus::CANCELLED) {
+                    current.push_back(quotes[i]);
+                }
+            }
+
+            if (current.empty()) {
+                mQuotes.erase(participant);
+            }
+            else {
+                mQuotes[participant] = std::move(current);
+            }
+            completeOperation();
+            return result;
+        }
+
+        // ========== Market Data ==========
+
+        TopOfBook top_of_book() const {
+            std::lock_guard<std::recursive_mutex> lock(mBookMutex);
+            return currentTopOfBook();
+        }
+
+        // Signals as of the last book event (read under the book lock for a consistent copy)
+        MarketSignals market_signals() const {
+            std::lock_guard<std::recursive_mutex> lock(mBookMutex);
+            return mSignals.signals();
+        }
+
+        // ========== Pre-trade Queries ==========
+
+        /**
+         * @brief Estimate the cost of a hypothetical order sweeping the book.
+         * @param side Side of the hypothetical order (BUY sweeps the asks, SELL the bids).
+         * @param quantity Size of the hypothetical order.
+         * @details
+         * Answered from a published LiquiditySnapshot, never mutating the book. The book
+         * lock is only taken to copy the best SNAPSHOT_BAND_SLOTS slots of each side when
+         * the snapshot is older than the book, O(SNAPSHOT_BAND_SLOTS + log n); every query
+         * until the next book change shares that copy. A sweep running past the band is
+         * priced in O(log n) on the live index under the lock. Safe to call from any thread.
+         * @return VWAP, best/worst price and levels touched; see SweepEstimate.
+         */
+        SweepEstimate estimate_sweep(OrderSide side, Quantity quantity) const {
+            auto snapshot = liquidity_snapshot();
+            SweepEstimate estimate;
+            if ((side == OrderSide::BUY ? snapshot->asks : snapshot->bids).sweep(quantity, estimate)) {
+                return estimate;
+            }
+            // Runs past the published band: price it on the live index instead
+            std::lock_guard<std::recursive_mutex> lock(mBookMutex);
+            return side == OrderSide::BUY ? mAskTracker.estimate_sweep(quantity)
+                                          : mBidTracker.estimate_sweep(quantity);
+        }
+
+        /**
+         * @brief Current liquidity snapshot, republished if the book changed since the last one.
+         */
+        std::shared_ptr<const LiquiditySnapshot> liquidity_snapshot() const {
+            auto snapshot = std::atomic_load(&mLiquiditySnapshot);
+            if (snapshot && snapshot->version == mBookVersion.load(std::memory_order_acquire)) {
+                return snapshot;
+            }
+            return publishLiquiditySnapshot();
+        }
+
+        uint64_t version() const { return mBookVersion.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Quantity and number of orders ahead of a resting order at its price.
+         * @return QueuePosition with found == false if the order is not resting in this book.
+         */
+        typename OrderTracker::QueuePosition queue_position(OrderId order_id) const {
+            std::lock_guard<std::recursive_mutex> lock(mBookMutex);
+            auto position = mBidTracker.queue_position(order_id);
+            return position.found ? position : mAskTracker.queue_position(order_id);
+        }
+
+        // ========== Accessors ==========
+
+        // Resting order with `orderId`, or an empty pointer
+        OrderPtr findOrder(OrderId orderId) const {
+            std::lock_guard<std::recursive_mutex> lock(mBookMutex);
+            return findRestingOrder(orderId);
+        }
+
+        const Symbol& symbol() const { return mSymbol; }
+        const Clock& clock() const { return *mClock; }
+        const OrderTracker& bids() const { return mBidTracker; }
+        const OrderTracker& asks() const { return mAskTracker; }
+        const OrderBookStats& stats() const { return mStats; }
+        // Null unless enableLatencyHistograms() was called; merge() into a shard total to aggregate
+        const OrderBookLatency* latency() const { return mLatency.get(); }
+        // Null unless enablePerfCounters() was called
+        const OrderBookPerf* perfCounters() const { return mPerf.get(); }
+        // Wait-free readers: call last() / since() from any thread
+        const TimeAndSales& time_and_sales() const { return mTimeAndSales; }
+        Price market_price() const { return mMarketPrice.load(); }
+        Price last_trade_price() const { return mLastTradePrice.load(); }
+        Quantity last_trade_quantity() const { return mLastTradeQuantity.load(); }
+
+        /**
+         * @brief Heap bytes held by this book, by component (see MemoryFootprint).
+         * @details O(levels) under the book lock, meant for periodic reports rather
+         * than the hot path. Depth listeners are charged what they report through
+         * memory_bytes(); add a DepthTracker kept outside the book to `depth` yourself.
+         */
+        MemoryFootprint memoryFootprint() const {
+            std::lock_guard<std::recursive_mutex> lock(mBookMutex);
+            MemoryFootprint footprint = mBidTracker.memory_footprint();
+            footprint += mAskTracker.memory_footprint();
+            footprint.stop_orders = mStopBidTracker.memory_footprint().total() + mStopAskTracker.memory_footprint().total();
+
+            auto snapshot = std::atomic_load(&mLiquiditySnapshot);
+            if (snapshot) {
+                footprint.liquidity_index += sizeof(LiquiditySnapshot) + snapshot->bids.memory_bytes() +
+                                             snapshot->asks.memory_bytes();
+            }
+            footprint.pending_trades = mPendingTrades.capacity() * sizeof(TradeExecution);
+            footprint.depth = mLevelDeltas.memory_bytes() + mDepthListeners.capacity() * sizeof(DepthListenerPtr);
+            for (const auto& listener : mDepthListeners) footprint.depth += listener->memory_bytes();
+
+            footprint.other = mTimeAndSales.memory_bytes() + hash_map_bytes(mQuotes) +
+                              (mLatency ? sizeof(OrderBookLatency) : 0) + (mPerf ? sizeof(OrderBookPerf) : 0) +
+                              (mOrderListeners.capacity() + mTradeListeners.capacity() + mBookListeners.capacity()) *
+                                  sizeof(std::shared_ptr<void>);
+            for (const auto& [participant, quotes] : mQuotes) footprint.other += quotes.capacity() * sizeof(OrderPtr);
+            return footprint;
+        }
+
         private:
+
+        // ========== Operation Helpers ==========
+
+        OrderPtr findRestingOrder(OrderId orderId) const {
+            OrderPtr order = mBidTracker.find_order(orderId);
+            return order ? order : mAskTracker.find_order(orderId);
+        }
+
+        void cancelResting(const OrderPtr& order) {
+            OrderTracker& ownSide = order->is_buy() ? mBidTracker : mAskTracker;
+            ownSide.remove_order(order);
+            cancelRemainingQuantity(order);
+        }
+
+        /**
+         * @brief Apply a cancel/replace to a resting order; see replaceOrder.
+         * @return False if the replace was rejected.
+         */
+        bool replaceResting(const OrderPtr& order, Quantity newQuantity, Price newPrice) {
+            Quantity filledQty = order->quantity() - order->open_quantity();
+            if (newQuantity == SIZE_UNCHANGED) newQuantity = order->quantity();
+            if (newPrice == PRICE_UNCHANGED) newPrice = order->price();
+
+            if (newPrice <= 0) {
+                rejectReplace(order, "Invalid replace price");
+                return false;
+            }
+            if (newQuantity <= filledQty) {
+                rejectReplace(order, "Replace quantity not above filled quantity");
+                return false;
+            }
+
+            OrderTracker& ownSide = order->is_buy() ? mBidTracker : mAskTracker;
+            const OrderTracker& oppositeSide = order->is_buy() ? mAskTracker : mBidTracker;
+            Quantity newOpenQty = newQuantity - filledQty;
+            // Losing priority makes it a new arrival
+            if (newPrice != order->price() || newOpenQty > order->open_quantity()) order->set_timestamp(mClock->now());
+            order->set_quantity(newQuantity);
+
+            bool crosses = !oppositeSide.empty() &&
+                (order->is_buy() ? newPrice >= oppositeSide.best_price() : newPrice <= oppositeSide.best_price());
+            if (crosses) {
+                ownSide.remove_order(order);
+                order->set_price(newPrice);
+                order->set_open_quantity(newOpenQty);
+                notifyReplace(order);
+                processLimitOrder(order, NO_CONDITIONS);
+            }
+            else {
+                ownSide.replace_order(order, newPrice, newOpenQty);
+                notifyReplace(order);
+            }
+            return true;
+        }
+
+        LatencyHistogram* latencyOf(LatencyHistogram OrderBookLatency::*histogram) {
+            return mLatency ? &((*mLatency).*histogram) : nullptr;
+        }
+
+        PerfTotals* perfOf(PerfTotals OrderBookPerf::*totals) {
+            return mPerf ? &((*mPerf).*totals) : nullptr;
+        }
+
+        // Quote i repeats the side and price of an earlier valid entry (rejected ones do not claim a price)
+        static bool isDuplicateQuote(const std::vector<OrderPtr>& quotes, const std::vector<bool>& valid, size_t i) {
+            for (size_t j = 0; j < i; ++j) {
+                if (valid[j] && quotes[j]->side() == quotes[i]->side() && quotes[j]->price() == quotes[i]->price()) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Common tail of every book-changing operation.
+         * @details Trades were already dispatched to listeners; bumps the book version,
+         * publishes signals and hands depth listeners the operation's level changes as one batch.
+         */
+        void completeOperation() {
+            mPendingTrades.clear();
+            markBookChanged();
+            ScopedLatency timer(latencyOf(&OrderBookLatency::notify));
+            ScopedPerfSample counters(perfOf(&OrderBookPerf::notify));
+            Trace::Scope trace(Trace::Event::LISTENER_DISPATCH, 0);
+            publishMarketSignals();
+            publishDepthUpdate();
+        }
+
+        void publishDepthUpdate() {
+            if (!mLevelDeltas.settle()) return;
+            for (const auto& listener : mDepthListeners) {
+                listener->on_depth_update(this, mLevelDeltas.deltas());
+            }
+            mLevelDeltas.clear();
+        }
+
+        // ========== Snapshot Publishing ==========
+
+        // Single writer (the book lock holder), so a plain load/store pair suffices
+        void markBookChanged() {
+            mBookVersion.store(mBookVersion.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        std::shared_ptr<const LiquiditySnapshot> publishLiquiditySnapshot() const {
+            std::lock_guard<std::recursive_mutex> lock(mBookMutex);
+            uint64_t version = mBookVersion.load(std::memory_order_acquire);
+            auto current = std::atomic_load(&mLiquiditySnapshot);
+            if (current && current->version == version) {
+                return current; // Another reader published while we waited
+            }
+            auto snapshot = std::make_shared<LiquiditySnapshot>();
+            snapshot->version = version;
+            mBidTracker.liquidity_index().copy_best(SNAPSHOT_BAND_SLOTS, false, snapshot->bids);
+            mAskTracker.liquidity_index().copy_best(SNAPSHOT_BAND_SLOTS, true, snapshot->asks);
+            std::shared_ptr<const LiquiditySnapshot> published = std::move(snapshot);
+            std::atomic_store(&mLiquiditySnapshot, published);
+            return published;
+        }
         
         // ========== Event Notifications ==========
 
+        TopOfBook currentTopOfBook() const {
+            TopOfBook top;
+            if (auto bid = mBidTracker.best_level()) {
+                top.bid_price = bid->price();
+                top.bid_qty = bid->total_quantity();
+            }
+            if (auto ask = mAskTracker.best_level()) {
+                top.ask_price = ask->price();
+                top.ask_qty = ask->total_quantity();
+            }
+            return top;
+        }
+
+        /**
+         * @brief Refresh microstructure signals after a book event and publish them.
+         * @details
+         * O(1) signal update plus two O(log n) top-N depth queries on the liquidity
+         * indexes, done once here rather than by every subscriber.
+         */
+        void publishMarketSignals() {
+            TopOfBook previous = mSignals.signals().top;
+            TopOfBook top = currentTopOfBook();
+            size_t depth = mSignals.depth_levels();
+            if (!mSignals.update(top, mBidTracker.quantity_of_best_levels(depth),
+                                 mAskTracker.quantity_of_best_levels(depth))) {
+                return;
+            }
+            bool bboChanged = top.bid_price != previous.bid_price || top.ask_price != previous.ask_price;
+            for (const auto& listener : mBookListeners) {
+                if (bboChanged) listener->on_bbo_change(this, top.bid_price, top.ask_price);
+                listener->on_market_signals(this, mSignals.signals());
+            }
+        }
+
         /**
          * @brief Method to handle rejection of order
          */
@@ -194,6 +796,43 @@ namespace OrderEngine{
             //todo: add warn log
         }
 
+        /**
+         * @brief Method to handle acceptance of a validated order
+         */
+        void acceptOrder(const OrderPtr& order) {
+            order->set_status(OrderStatus::ACCEPTED);
+            order->set_timestamp(mClock->now());
+            mStats.total_orders_added++;
+            for (const auto& listener : mOrderListeners) {
+                listener->on_accept(order);
+            }
+        }
+
+        void notifyReplace(const OrderPtr& order) {
+            mStats.total_orders_replaced++;
+            for (const auto& listener : mOrderListeners) {
+                listener->on_replace(order, order);
+            }
+        }
+
+        void rejectReplace(const OrderPtr& order, const std::string& reason) {
+            for (const auto& listener : mOrderListeners) {
+                listener->on_replace_reject(order, reason);
+            }
+        }
+
+        /**
+         * @brief Method to cancel whatever quantity of an inbound order is left unfilled
+         */
+        void cancelRemainingQuantity(const OrderPtr& order) {
+            Quantity cancelledQty = order->open_quantity();
+            order->set_status(OrderStatus::CANCELLED);
+            mStats.total_orders_cancelled++;
+            for (const auto& listener : mOrderListeners) {
+                listener->on_cancel(order, cancelledQty);
+            }
+        }
+
         // ========== Validation ==========
 
         /**
@@ -219,12 +858,33 @@ namespace OrderEngine{
                 filled = matchMarketBuyOrder(inBoundorderPtr, conditions);
             }
             else {
-                // todo: implement matchMarketSellOrder
+                filled = matchMarketSellOrder(inBoundorderPtr, conditions);
             }
 
+            // Market orders never rest, whatever is left is cancelled
             if (inBoundorderPtr->open_quantity() > 0) {
-                inBoundorderPtr->set_status(OrderStatus::CANCELLED);
-                // todo: notifyOrderCancelled(inBoundorderPtr, inBoundorderPtr->open_quantity()); mOrderListeners
+                cancelRemainingQuantity(inBoundorderPtr);
+            }
+            return filled;
+        }
+
+        bool processLimitOrder(const OrderPtr& inBoundOrderPtr, OrderConditions conditions){
+            bool filled = false;
+            if(inBoundOrderPtr->is_buy()){
+                filled = matchBuyOrder(inBoundOrderPtr, conditions, inBoundOrderPtr->price());
+            }
+            else {
+                filled = matchSellOrder(inBoundOrderPtr, conditions, inBoundOrderPtr->price());
+            }
+
+            if (inBoundOrderPtr->open_quantity() > 0) {
+                if (isImmediateOrCancel(conditions)) {
+                    cancelRemainingQuantity(inBoundOrderPtr);
+                }
+                else {
+                    OrderTracker& ownSide = inBoundOrderPtr->is_buy() ? mBidTracker : mAskTracker;
+                    ownSide.addOrder(inBoundOrderPtr);
+                }
             }
             return filled;
         }
@@ -242,6 +902,16 @@ namespace OrderEngine{
             return matchBuyOrder(order,conditions,limitPrice);
         }
 
+        /**
+         * @brief Match a market sell order against the order book.
+         * @details
+         * The seller accepts any price, so we match against the highest bids available.
+         */
+        bool matchMarketSellOrder(const OrderPtr& order, OrderConditions conditions){
+            Price limitPrice = std::numeric_limits<Price>::min(); // No price limit for market orders
+            return matchSellOrder(order,conditions,limitPrice);
+        }
+
         /**
          * @brief Match a buy order against the order book.
          * @param order The incoming buy order.
@@ -249,46 +919,70 @@ namespace OrderEngine{
          * @param limitPrice The maximum price the buyer is willing to pay. (decided by order type)
          */
         bool matchBuyOrder(const OrderPtr& inBoundOrderPtr, OrderConditions conditions, Price limitPrice) {
+            // These are order lying in sell section of order booking waiting to be matched with buy orders
+            Trace::Scope trace(Trace::Event::MATCH_BUY, inBoundOrderPtr->order_id(), inBoundOrderPtr->open_quantity());
+            return matchOrder(inBoundOrderPtr, mAskTracker, conditions, limitPrice);
+        }
+
+        /**
+         * @brief Match a sell order against the order book.
+         * @param limitPrice The minimum price the seller is willing to accept.
+         */
+        bool matchSellOrder(const OrderPtr& inBoundOrderPtr, OrderConditions conditions, Price limitPrice) {
+            // These are order lying in buy section of order booking waiting to be matched with sell orders
+            Trace::Scope trace(Trace::Event::MATCH_SELL, inBoundOrderPtr->order_id(), inBoundOrderPtr->open_quantity());
+            return matchOrder(inBoundOrderPtr, mBidTracker, conditions, limitPrice);
+        }
+
+        /**
+         * @brief Match an inbound order against resting orders of the opposite side.
+         * @param restingSide Tracker holding the resting (passive) orders.
+         * @details
+         * All-or-none feasibility (AON and FOK) is decided before any mutation from the
+         * resting side's cumulative liquidity index in O(log n): an order that cannot be
+         * filled completely returns without touching a PriceLevel, and an order that can
+         * is executed in one pass, best price first and FIFO within a level.
+         */
+        bool matchOrder(const OrderPtr& inBoundOrderPtr, OrderTracker& restingSide,
+                        OrderConditions conditions, Price limitPrice) {
 
             Quantity inBoundOrderRemaining = inBoundOrderPtr->open_quantity();
-            bool any_fill = false;
 
-            // Get matching sell(ask) orders from the ask-order tracker, format: std::vector<std::pair<OrderPtr, Quantity>>
-            // These are order lying in sell section of order booking waiting to be matched with buy orders
-            // These are resting order (orders lying in order book to be matched)
-            auto matches = mAskTracker.matchQuantity(limitPrice, inBoundOrderRemaining); 
+            // Check all-or-none conditions
+            if (IsAllOrNone(conditions) &&
+                restingSide.quantity_through_price(limitPrice) < inBoundOrderRemaining) {
+                return false;
+            }
+
+            bool any_fill = false;
+            uint64_t start = mLatency ? Tsc::now() : 0;
+            PerfSample countersBefore;
+            bool sampled = mPerf && PerfCounterGroup::forThisThread().read(countersBefore);
             
-            for (const auto& [restingOrderPtr, restingOrderRemainingQty] : matches) {
+            while (inBoundOrderRemaining > 0) {
+                auto level = restingSide.best_level();
+                if (!level) break;
 
-                if (inBoundOrderRemaining == 0){
-                    break;
-                }
-                
-                // Check all-or-none conditions
-                if (IsAllOrNone(conditions) && restingOrderRemainingQty < inBoundOrderRemaining) {
-                    continue;
-                }
-                
-                Quantity fillQty = std::min(restingOrderRemainingQty, inBoundOrderRemaining);
-                Price fillPrice = restingOrderPtr->price();
+                // Check if the best resting price is within the inbound order's limit
+                Price levelPrice = level->price();
+                bool can_match = restingSide.is_buy_side() ? (levelPrice >= limitPrice) : (levelPrice <= limitPrice);
+                if (!can_match) break;
+
+                OrderPtr restingOrderPtr = level->front_order(); // FIFO within the level
+                Quantity fillQty = std::min(restingOrderPtr->open_quantity(), inBoundOrderRemaining);
                 
                 // Execute the trade
-                executeTrade(inBoundOrderPtr, restingOrderPtr, fillQty, fillPrice);
+                executeTrade(inBoundOrderPtr, restingOrderPtr, fillQty, levelPrice);
                 
-                inBoundOrderRemaining -= fillQty;
+                inBoundOrderRemaining = inBoundOrderPtr->open_quantity();
                 any_fill = true;
-                
-                // Update order quantities
-                inBoundOrderPtr->set_open_quantity(inBoundOrderRemaining);
-                
-                if (inBoundOrderRemaining == 0) {
-                    inBoundOrderPtr->set_status(OrderStatus::FILLED);
-                    break;
-                } else {
-                    inBoundOrderPtr->set_status(OrderStatus::PARTIALLY_FILLED);
-                }
             }
             
+            if (any_fill && mLatency) mLatency->match.record(Tsc::now() - start);
+            PerfSample countersAfter;
+            if (any_fill && sampled && PerfCounterGroup::forThisThread().read(countersAfter)) {
+                mPerf->match.add(countersBefore, countersAfter);
+            }
             return any_fill;
         }
 
@@ -300,23 +994,27 @@ namespace OrderEngine{
          * @param price The price at which the trade is executed.
          * @details
          * - Creates a TradeExecution record
-         * - Updates order statuses and quantities
+         * - Updates order statuses and quantities (the resting order through its tracker,
+         *   so price levels and the liquidity index stay consistent)
          * - Notifies listeners of the trade event
          */
         void executeTrade(const OrderPtr& inBoundOrderPtr, const OrderPtr& restingOrderPtr, 
                             Quantity quantity, Price price) {
+            Trace::Scope trace(Trace::Event::EXECUTE_TRADE, restingOrderPtr->order_id(), quantity);
         
-            FillFlags flags = FILL_NORMAL;
+            FillFlags flags = FILL_AGGRESSIVE;
             if (inBoundOrderPtr->open_quantity() == quantity){
-                flags |= FILL_COMPLETE;
+                flags = static_cast<FillFlags>(flags | FILL_COMPLETE);
             }
             else{
-                flags |= FILL_PARTIAL;
+                flags = static_cast<FillFlags>(flags | FILL_PARTIAL);
             }
 
             // Create trade execution record
-            TradeExecution trade(inBoundOrderPtr, restingOrderPtr, quantity, price, flags);
-            mPendingTrades.push_back(trade);
+            Timestamp now = mClock->now();
+            mPendingTrades.emplace_back(inBoundOrderPtr, restingOrderPtr, quantity, price, now, flags);
+            mTimeAndSales.append(Clock::toNanoseconds(now), price, quantity,
+                inBoundOrderPtr->order_id(), restingOrderPtr->order_id(), inBoundOrderPtr->side());
                      
             // ==== Updating Meta Data ==== 
 
@@ -327,19 +1025,35 @@ namespace OrderEngine{
             mLastTradePrice.store(price);
             mLastTradeQuantity.store(quantity);
             mMarketPrice.store(price);
+
+            // Update inbound order
+            Quantity inBoundRemainingQty = inBoundOrderPtr->open_quantity() - quantity;
+            inBoundOrderPtr->set_open_quantity(inBoundRemainingQty);
+            inBoundOrderPtr->set_status(inBoundRemainingQty == 0 ? OrderStatus::FILLED : OrderStatus::PARTIALLY_FILLED);
         
             // Update resting order
+            OrderTracker& restingSide = restingOrderPtr->is_buy() ? mBidTracker : mAskTracker;
             Quantity restingRemainingQty = restingOrderPtr->open_quantity() - quantity;
-            restingOrderPtr->set_open_quantity(restingRemainingQty);
             
             if (restingRemainingQty == 0) {
+                restingSide.remove_order(restingOrderPtr);
+                restingOrderPtr->set_open_quantity(0);
                 restingOrderPtr->set_status(OrderStatus::FILLED);
             } else {
+                restingSide.update_order_quantity(restingOrderPtr, restingRemainingQty);
                 restingOrderPtr->set_status(OrderStatus::PARTIALLY_FILLED);
             }
             
             // todo: log the trade
-            // todo: notify trade listeners that trade is executed
+            Trace::Scope dispatch(Trace::Event::LISTENER_DISPATCH, inBoundOrderPtr->order_id());
+            for (const auto& listener : mOrderListeners) {
+                listener->on_fill(inBoundOrderPtr, restingOrderPtr, quantity, price);
+                listener->on_fill(restingOrderPtr, inBoundOrderPtr, quantity, price);
+            }
+            for (const auto& listener : mTradeListeners) {
+                listener->on_trade(inBoundOrderPtr, restingOrderPtr, quantity, price,
+                                   inBoundRemainingQty == 0, restingRemainingQty == 0);
+            }
         }
 
         // ========== Utility Functions ==========
@@ -349,11 +1063,20 @@ namespace OrderEngine{
          */
 
         bool IsAllOrNone(OrderConditions conditions) const {
-            return (conditions & ALL_OR_NONE) == 1;
+            return (conditions & ALL_OR_NONE) != 0;
         }
         
         bool isImmediateOrCancel(OrderConditions conditions) const {
-            return (conditions & IMMEDIATE_OR_CANCEL) == 1;
+            return (conditions & IMMEDIATE_OR_CANCEL) != 0;
+        }
+
+        // Time in force IOC / FOK expressed as execution conditions
+        static OrderConditions withTimeInForce(const OrderPtr& order, OrderConditions conditions) {
+            uint32_t merged = conditions;
+            if (order->is_fill_or_kill()) merged |= FILL_OR_KILL;
+            if (order->is_immediate_or_cancel()) merged |= IMMEDIATE_OR_CANCEL;
+            if (order->is_all_or_none()) merged |= ALL_OR_NONE;
+            return static_cast<OrderConditions>(merged);
         }
     };
 
@@ -0,0 +1,287 @@
+#pragma once
+#ifndef ORDER_FLOW_GENERATOR_H
+#define ORDER_FLOW_GENERATOR_H
+
+#include "OrderTypes.h"
+#include "Order.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace OrderEngine {
+
+    /**
+     * @brief Knobs of the synthetic order flow, see OrderFlowGenerator.
+     * @details Event weights are relative, they do not need to sum to one.
+     */
+    struct OrderFlowConfig {
+        enum class Arrivals { POISSON, HAWKES };
+
+        uint64_t seed = 1;
+
+        // Instruments and how activity is spread over them: Zipf(symbol_skew) by index
+        std::vector<Symbol> symbols{"INFY"};
+        double symbol_skew = 1.0;               // 0 = uniform
+
+        // Arrival process, mean events per second over all symbols
+        Arrivals arrivals = Arrivals::POISSON;
+        double event_rate = 100000.0;
+        double hawkes_branching = 0.7;          // Expected children per event, < 1
+        double hawkes_decay = 2000.0;           // Excitation decay rate per second
+
+        // Event mix
+        double add_weight = 0.45;
+        double cancel_weight = 0.40;
+        double modify_weight = 0.10;
+        double market_weight = 0.05;
+        double modify_reprice_probability = 0.3; // Modify also moves the price
+
+        // Prices: limit orders sit 1 + `distance` ticks from the symbol's reference price with
+        // P(distance >= d) ~ (1 + d)^(1 - distance_exponent). The reference is fixed unless
+        // set_reference_price() re-centres it; it does not follow the book's touch.
+        Price reference_price = 150000;         // Mid of every symbol at start
+        Price tick_size = 5;
+        double distance_exponent = 2.5;         // > 1; larger = tighter around the reference
+        uint32_t max_distance_ticks = 200;
+        // Share of limit prices (adds and reprices) placed on the far side of the reference,
+        // so they cross resting liquidity like a marketable limit; 0 = every limit is passive
+        double marketable_fraction = 0.1;
+
+        // Sizes: uniform 1..max_lots lots
+        Quantity lot_size = 100;
+        uint32_t max_lots = 10;
+    };
+
+    enum class FlowEventType : char {
+        ADD = 'A',
+        CANCEL = 'X',
+        MODIFY = 'M',
+        MARKET = 'E'
+    };
+
+    /**
+     * @brief One generated order-entry event.
+     * @details MODIFY carries the new total quantity and PRICE_UNCHANGED unless repriced;
+     * CANCEL the order id and side. Ids are unique over all symbols.
+     */
+    struct FlowEvent {
+        int64_t time_ns = 0;            // Since the start of the flow
+        size_t symbol_index = 0;
+        FlowEventType type = FlowEventType::ADD;
+        OrderId order_id = 0;
+        OrderSide side = OrderSide::BUY;
+        Price price = 0;
+        Quantity quantity = 0;
+    };
+
+    /**
+     * @brief Deterministic generator of realistic synthetic order flow.
+     * @details
+     * - Arrivals are Poisson or self-exciting Hawkes (exponential kernel, simulated by
+     *   Ogata thinning), both with mean rate `event_rate`; Hawkes flow is bursty.
+     * - Each event picks a symbol by Zipf skew, then a type by the configured mix.
+     * - Limit prices follow a power law in ticks from a per-symbol reference price, so
+     *   most orders cluster around it with a heavy tail behind. A `marketable_fraction`
+     *   of them is placed through the reference and trades against the other side, so
+     *   liquidity near the reference is consumed by limit flow as well as market orders.
+     *   The reference stays put unless the caller feeds back the book's mid.
+     * - Cancels and modifies target the generator's own live orders of that symbol.
+     *   Orders filled in the book stay "live" here; applying such an event is a no-op.
+     * The same seed and config always produce the same event stream: all sampling is
+     * done from raw mt19937_64 output, never through library distributions whose
+     * algorithms differ between standard libraries.
+     */
+    class OrderFlowGenerator {
+    private:
+        OrderFlowConfig config_;
+        std::mt19937_64 rng_;
+        std::vector<double> symbol_cdf_;
+        std::vector<Price> reference_prices_;
+        std::vector<std::vector<std::pair<OrderId, OrderSide>>> live_orders_;   // Per symbol
+        double type_weights_[4];
+        double time_s_;
+        double excitation_;                             // Hawkes intensity above the base rate
+        OrderId next_order_id_;
+
+        // Uniform in [0, 1)
+        double uniform() { return static_cast<double>(rng_() >> 11) * 0x1.0p-53; }
+
+        double exponential(double rate) { return -std::log(1.0 - uniform()) / rate; }
+
+        uint64_t below(uint64_t bound) { return bound ? rng_() % bound : 0; }
+
+        double next_arrival_gap() {
+            if (config_.arrivals == OrderFlowConfig::Arrivals::POISSON) {
+                return exponential(config_.event_rate);
+            }
+            // Ogata thinning: intensity only decays between events, so its current
+            // value bounds it until the next candidate
+            double base = config_.event_rate * (1.0 - config_.hawkes_branching);
+            double gap = 0.0;
+            for (;;) {
+                double bound = base + excitation_;
+                double step = exponential(bound);
+                gap += step;
+                excitation_ *= std::exp(-config_.hawkes_decay * step);
+                if (uniform() * bound <= base + excitation_) break;
+            }
+            excitation_ += config_.hawkes_branching * config_.hawkes_decay;
+            return gap;
+        }
+
+        size_t pick_symbol() {
+            double u = uniform();
+            auto it = std::upper_bound(symbol_cdf_.begin(), symbol_cdf_.end(), u);
+            return std::min(static_cast<size_t>(it - symbol_cdf_.begin()), symbol_cdf_.size() - 1);
+        }
+
+        FlowEventType pick_type(bool has_live) {
+            double total = type_weights_[0] + type_weights_[3] +
+                (has_live ? type_weights_[1] + type_weights_[2] : 0.0);
+            double u = uniform() * total;
+            if ((u -= type_weights_[0]) < 0) return FlowEventType::ADD;
+            if ((u -= type_weights_[3]) < 0 || !has_live) return FlowEventType::MARKET;
+            if ((u -= type_weights_[1]) < 0) return FlowEventType::CANCEL;
+            return FlowEventType::MODIFY;
+        }
+
+        // Inverse CDF of a discretised Pareto tail, clamped to the configured range
+        uint32_t distance_ticks() {
+            double tail = std::pow(1.0 - uniform(), -1.0 / (config_.distance_exponent - 1.0)) - 1.0;
+            return static_cast<uint32_t>(std::min(tail, static_cast<double>(config_.max_distance_ticks)));
+        }
+
+        Price limit_price(size_t symbol, OrderSide side) {
+            Price offset = static_cast<Price>(1 + distance_ticks()) * config_.tick_size;
+            // No extra draw when disabled, so passive-only streams do not depend on the knob
+            bool through = config_.marketable_fraction > 0.0 && uniform() < config_.marketable_fraction;
+            bool under = (side == OrderSide::BUY) != through;
+            Price price = under ? reference_prices_[symbol] - offset : reference_prices_[symbol] + offset;
+            return std::max(price, config_.tick_size);
+        }
+
+        Quantity quantity() { return (1 + below(config_.max_lots)) * config_.lot_size; }
+
+        OrderSide side() { return (rng_() & 1) ? OrderSide::BUY : OrderSide::SELL; }
+
+        // Pick a live order and optionally forget it (swap-remove)
+        std::pair<OrderId, OrderSide> pick_live(size_t symbol, bool retire) {
+            auto& live = live_orders_[symbol];
+            size_t index = below(live.size());
+            auto picked = live[index];
+            if (retire) {
+                live[index] = live.back();
+                live.pop_back();
+            }
+            return picked;
+        }
+
+    public:
+        explicit OrderFlowGenerator(const OrderFlowConfig& config)
+            : config_(config), rng_(config.seed), time_s_(0.0), excitation_(0.0), next_order_id_(1) {
+            if (config_.symbols.empty()) config_.symbols.push_back("INFY");
+            config_.hawkes_branching = std::clamp(config_.hawkes_branching, 0.0, 0.99);
+            config_.distance_exponent = std::max(config_.distance_exponent, 1.01);
+            config_.max_lots = std::max<uint32_t>(config_.max_lots, 1);
+            config_.marketable_fraction = std::clamp(config_.marketable_fraction, 0.0, 1.0);
+
+            double total = 0.0;
+            for (size_t i = 0; i < config_.symbols.size(); ++i) {
+                total += 1.0 / std::pow(static_cast<double>(i + 1), config_.symbol_skew);
+                symbol_cdf_.push_back(total);
+            }
+            for (auto& value : symbol_cdf_) value /= total;
+
+            reference_prices_.assign(config_.symbols.size(), config_.reference_price);
+            live_orders_.resize(config_.symbols.size());
+            type_weights_[0] = config_.add_weight;
+            type_weights_[1] = config_.cancel_weight;
+            type_weights_[2] = config_.modify_weight;
+            type_weights_[3] = config_.market_weight;
+        }
+
+        const OrderFlowConfig& config() const { return config_; }
+
+        /**
+         * @brief Re-centre future limit prices of `symbol` (e.g. on the book's current mid).
+         * @details Feeding back the book keeps the flow anchored as trades move the market;
+         * it only stays deterministic if the fed prices are.
+         */
+        void set_reference_price(size_t symbol, Price price) {
+            if (symbol < reference_prices_.size() && price > 0) reference_prices_[symbol] = price;
+        }
+
+        // Orders added and not yet cancelled by the generator, for `symbol`
+        size_t live_orders(size_t symbol) const { return live_orders_[symbol].size(); }
+
+        FlowEvent next() {
+            FlowEvent event;
+            time_s_ += next_arrival_gap();
+            event.time_ns = static_cast<int64_t>(time_s_ * 1e9);
+            event.symbol_index = pick_symbol();
+            event.type = pick_type(!live_orders_[event.symbol_index].empty());
+
+            switch (event.type) {
+                case FlowEventType::ADD:
+                    event.order_id = next_order_id_++;
+                    event.side = side();
+                    event.price = limit_price(event.symbol_index, event.side);
+                    event.quantity = quantity();
+                    live_orders_[event.symbol_index].emplace_back(event.order_id, event.side);
+                    break;
+                case FlowEventType::MARKET:
+                    event.order_id = next_order_id_++;
+                    event.side = side();
+                    event.price = MARKET_PRICE;
+                    event.quantity = quantity();
+                    break;
+                case FlowEventType::CANCEL:
+                    std::tie(event.order_id, event.side) = pick_live(event.symbol_index, true);
+                    break;
+                case FlowEventType::MODIFY:
+                    std::tie(event.order_id, event.side) = pick_live(event.symbol_index, false);
+                    event.quantity = quantity();
+                    event.price = uniform() < config_.modify_reprice_probability
+                        ? limit_price(event.symbol_index, event.side) : PRICE_UNCHANGED;
+                    break;
+            }
+            return event;
+        }
+
+        std::vector<FlowEvent> generate(size_t count) {
+            std::vector<FlowEvent> events;
+            events.reserve(count);
+            for (size_t i = 0; i < count; ++i) events.push_back(next());
+            return events;
+        }
+    };
+
+    /**
+     * @brief Apply a generated event to the book of its symbol.
+     * @details Book must be an OrderBook of std::shared_ptr<Order>.
+     * @return True if the event changed the book (filled, cancelled or modified).
+     */
+    template<typename Book> bool applyFlowEvent(Book& book, const FlowEvent& event) {
+        switch (event.type) {
+            case FlowEventType::ADD:
+                book.addOrder(std::make_shared<Order>(event.order_id, book.symbol(), event.side,
+                                                      event.quantity, event.price));
+                return true;
+            case FlowEventType::MARKET:
+                return book.addOrder(std::make_shared<Order>(event.order_id, book.symbol(), event.side,
+                                                             event.quantity, MARKET_PRICE, OrderType::MARKET));
+            case FlowEventType::CANCEL:
+                return book.cancelOrder(event.order_id);
+            case FlowEventType::MODIFY:
+                return book.replaceOrder(event.order_id, event.quantity, event.price);
+        }
+        return false;
+    }
+
+} // namespace OrderEngine
+
+#endif // ORDER_FLOW_GENERATOR_H
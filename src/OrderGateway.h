@@ -0,0 +1,553 @@
+#pragma once
+#ifndef ORDER_GATEWAY_H
+#define ORDER_GATEWAY_H
+
+#include "OrderBook.h"
+#include "OuchProtocol.h"
+#include <arpa/inet.h>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+namespace OrderEngine {
+
+    struct GatewayConfig {
+        std::string address = "127.0.0.1";
+        uint16_t port = 0;                          // 0: any free port, see OrderGateway::port()
+        size_t max_output_bytes = 8 << 20;          // Unsent responses a session may pile up before it is dropped
+    };
+
+    /**
+     * @brief TCP order entry gateway speaking the Ouch binary protocol (src/OuchProtocol.h).
+     * @details
+     * One thread runs an edge-triggered epoll loop over non-blocking sockets and
+     * owns the books, so every request is applied inline, in arrival order, and
+     * the book locks are never contended. Responses are produced by an
+     * OrderListener registered on every book and routed to the session owning
+     * the order: a trade reaches both counterparties' sessions.
+     *
+     * Each wakeup drains every readable socket (edge-triggered: until EAGAIN),
+     * applies all complete messages, then flushes each session that has
+     * responses with one send() for the whole batch. What the kernel does not
+     * take waits for the socket's next EPOLLOUT edge.
+     *
+     * CLIENT A --'O' sell 100--> [read] -> book.addOrder -> on_accept ---> A: 'A'
+     * CLIENT B --'O' buy 150---> [read] -> book.addOrder -> on_accept ---> B: 'A'
+     *                                                     -> on_fill x2 -> B: 'E' 100, A: 'E' 100
+     *
+     * A session that disconnects has its live orders cancelled. A malformed
+     * frame (unknown type, wrong length) closes the session. stop() leaves the
+     * books as they are so they can be inspected.
+     */
+    class OrderGateway {
+    public:
+        using OrderPtr = std::shared_ptr<Order>;
+        using Book = OrderBook<OrderPtr>;
+
+    private:
+        static constexpr uint64_t LISTENER_ID = 0;
+        static constexpr uint64_t WAKEUP_ID = 1;
+        static constexpr size_t INPUT_BUFFER = 64 * 1024;
+        static constexpr int MAX_EVENTS = 64;
+
+        struct Session {
+            uint64_t id = 0;
+            int fd = -1;
+            std::unique_ptr<uint8_t[]> in{new uint8_t[INPUT_BUFFER]};
+            size_t in_size = 0;
+            std::vector<uint8_t> out;
+            size_t out_sent = 0;
+            std::unordered_map<uint64_t, OrderId> orders;   // Live orders by client token
+            bool dirty = false;                             // Queued for flushing in this wakeup
+            bool closing = false;                           // Closed at the end of this wakeup, gets no more responses
+        };
+
+        // Owner of a live order
+        struct Route {
+            uint64_t session;
+            uint64_t token;
+            uint32_t book;
+        };
+
+        // Turns book events into responses for the order's owner
+        class Listener : public OrderListener<OrderPtr> {
+        private:
+            OrderGateway& gateway_;
+
+        public:
+            explicit Listener(OrderGateway& gateway) : gateway_(gateway) {}
+
+            void on_accept(const OrderPtr& order) override { gateway_.onAccept(order); }
+            void on_reject(const OrderPtr& order, const std::string&) override {
+                gateway_.respondAndFinish(order->order_id(), [&](Session& session, const Route& route, uint64_t now) {
+                    Ouch::appendRejected(session.out, now, route.token, Ouch::RejectReason::INVALID_ORDER);
+                });
+            }
+            void on_fill(const OrderPtr& order, const OrderPtr& matched, Quantity quantity, Price price) override {
+                gateway_.onFill(order, matched, quantity, price);
+            }
+            void on_cancel(const OrderPtr& order, Quantity quantity) override {
+                gateway_.respondAndFinish(order->order_id(), [&](Session& session, const Route& route, uint64_t now) {
+                    Ouch::appendCancelled(session.out, now, route.token, quantity, gateway_.cancel_reason_);
+                });
+            }
+            void on_replace(const OrderPtr&, const OrderPtr& order) override { gateway_.onReplace(order); }
+            void on_replace_reject(const OrderPtr& order, const std::string&) override {
+                gateway_.respond(order->order_id(), [&](Session& session, const Route& route, uint64_t now) {
+                    Ouch::appendRejected(session.out, now, route.token, Ouch::RejectReason::REPLACE_REJECTED);
+                });
+            }
+        };
+
+        GatewayConfig config_;
+        std::vector<std::unique_ptr<Book>> books_;
+        std::map<Symbol, uint32_t, std::less<>> book_index_;
+        std::shared_ptr<Listener> listener_;
+
+        // Gateway thread only once started
+        std::unordered_map<uint64_t, std::unique_ptr<Session>> sessions_;
+        std::unordered_map<OrderId, Route> routes_;
+        std::vector<Session*> dirty_;
+        uint64_t next_session_ = WAKEUP_ID + 1;
+        OrderId next_order_id_ = 1;
+        uint64_t match_number_ = 0;
+        std::pair<const Order*, const Order*> last_fill_{nullptr, nullptr};
+        Ouch::CancelReason cancel_reason_ = Ouch::CancelReason::IMMEDIATE;
+
+        int listen_fd_ = -1;
+        int epoll_fd_ = -1;
+        int wakeup_fd_ = -1;
+        uint16_t port_ = 0;
+        std::string error_;
+        std::thread thread_;
+        std::atomic<bool> running_{false};
+
+        std::atomic<uint64_t> sessions_accepted_{0};
+        std::atomic<uint64_t> messages_in_{0};
+        std::atomic<uint64_t> messages_out_{0};
+        std::atomic<uint64_t> writes_{0};
+        std::atomic<uint64_t> protocol_errors_{0};
+
+        static uint64_t nowNs() {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        // ========== Responses ==========
+
+        Session* liveSession(uint64_t id) {
+            auto it = sessions_.find(id);
+            return it == sessions_.end() || it->second->closing ? nullptr : it->second.get();
+        }
+
+        void responseQueued(Session& session) {
+            messages_out_.fetch_add(1, std::memory_order_relaxed);
+            if (session.dirty) return;
+            session.dirty = true;
+            dirty_.push_back(&session);
+        }
+
+        // Append one response for the owner of `orderId`, if it is still connected
+        template<typename Append> void respond(OrderId orderId, Append&& append) {
+            auto route = routes_.find(orderId);
+            if (route == routes_.end()) return;
+            if (Session* session = liveSession(route->second.session)) {
+                append(*session, route->second, nowNs());
+                responseQueued(*session);
+            }
+        }
+
+        // The order is done (filled, cancelled or rejected): forget its route and token
+        void finish(OrderId orderId) {
+            auto route = routes_.find(orderId);
+            if (route == routes_.end()) return;
+            auto session = sessions_.find(route->second.session);
+            if (session != sessions_.end()) session->second->orders.erase(route->second.token);
+            routes_.erase(route);
+        }
+
+        template<typename Append> void respondAndFinish(OrderId orderId, Append&& append) {
+            respond(orderId, std::forward<Append>(append));
+            finish(orderId);
+        }
+
+        void reject(Session& session, uint64_t token, Ouch::RejectReason reason) {
+            Ouch::appendRejected(session.out, nowNs(), token, reason);
+            responseQueued(session);
+        }
+
+        void onAccept(const OrderPtr& order) {
+            respond(order->order_id(), [&](Session& session, const Route& route, uint64_t now) {
+                uint32_t price = order->is_market() ? Ouch::MARKET : Ouch::clamp32(static_cast<uint64_t>(order->price()));
+                Ouch::appendAccepted(session.out, now, route.token, order->order_id(), order->side(),
+                                     order->quantity(), books_[route.book]->symbol(), price);
+            });
+        }
+
+        void onFill(const OrderPtr& order, const OrderPtr& matched, Quantity quantity, Price price) {
+            // The book reports each trade twice, (inbound, resting) then (resting, inbound)
+            if (last_fill_.first != matched.get() || last_fill_.second != order.get()) ++match_number_;
+            last_fill_ = {order.get(), matched.get()};
+            respond(order->order_id(), [&](Session& session, const Route& route, uint64_t now) {
+                Ouch::appendExecuted(session.out, now, route.token, quantity, price, match_number_);
+            });
+            if (order->open_quantity() == 0) finish(order->order_id());
+        }
+
+        void onReplace(const OrderPtr& order) {
+            respond(order->order_id(), [&](Session& session, const Route& route, uint64_t now) {
+                Ouch::appendReplaced(session.out, now, route.token, order->open_quantity(), order->price());
+            });
+        }
+
+        // ========== Requests ==========
+
+        void enterOrder(Session& session, Ouch::EnterOrder message) {
+            auto book = book_index_.find(message.stock());
+            if (book == book_index_.end()) return reject(session, message.token(), Ouch::RejectReason::UNKNOWN_SYMBOL);
+            if (session.orders.count(message.token())) {
+                return reject(session, message.token(), Ouch::RejectReason::DUPLICATE_TOKEN);
+            }
+            char side = message.side();
+            char tif = message.time_in_force();
+            bool validTif = tif == static_cast<char>(TimeInForce::GOOD_TILL_CANCELLED) ||
+                            tif == static_cast<char>(TimeInForce::IMMEDIATE_OR_CANCEL) ||
+                            tif == static_cast<char>(TimeInForce::FILL_OR_KILL) ||
+                            tif == static_cast<char>(TimeInForce::DAY);
+            if ((side != static_cast<char>(OrderSide::BUY) && side != static_cast<char>(OrderSide::SELL)) || !validTif) {
+                return reject(session, message.token(), Ouch::RejectReason::INVALID_ORDER);
+            }
+
+            OrderId id = next_order_id_++;
+            routes_.emplace(id, Route{session.id, message.token(), book->second});
+            session.orders.emplace(message.token(), id);
+            bool market = message.price() == Ouch::MARKET;
+            Book& target = *books_[book->second];
+            target.addOrder(std::make_shared<Order>(id, target.symbol(), static_cast<OrderSide>(side), message.shares(),
+                                                    market ? MARKET_PRICE : static_cast<Price>(message.price()),
+                                                    market ? OrderType::MARKET : OrderType::LIMIT,
+                                                    static_cast<TimeInForce>(tif)));
+        }
+
+        void cancelOrder(Session& session, Ouch::CancelOrder message) {
+            auto order = session.orders.find(message.token());
+            if (order == session.orders.end()) return reject(session, message.token(), Ouch::RejectReason::UNKNOWN_TOKEN);
+            cancelLive(order->second, Ouch::CancelReason::USER_REQUESTED);
+        }
+
+        void replaceOrder(Session& session, Ouch::ReplaceOrder message) {
+            auto order = session.orders.find(message.token());
+            if (order == session.orders.end()) return reject(session, message.token(), Ouch::RejectReason::UNKNOWN_TOKEN);
+            OrderId id = order->second;
+            books_[routes_.at(id).book]->replaceOrder(id, message.shares() ? message.shares() : SIZE_UNCHANGED,
+                                                      message.price() ? static_cast<Price>(message.price())
+                                                                      : PRICE_UNCHANGED);
+        }
+
+        void massCancel(Session& session, Ouch::MassCancel message) {
+            uint32_t book = UINT32_MAX; // Every book
+            if (!message.stock().empty()) {
+                auto found = book_index_.find(message.stock());
+                if (found == book_index_.end()) return reject(session, 0, Ouch::RejectReason::UNKNOWN_SYMBOL);
+                book = found->second;
+            }
+            cancelAll(session, book, Ouch::CancelReason::MASS_CANCEL);
+        }
+
+        void cancelLive(OrderId id, Ouch::CancelReason reason) {
+            cancel_reason_ = reason;
+            books_[routes_.at(id).book]->cancelOrder(id);
+            cancel_reason_ = Ouch::CancelReason::IMMEDIATE;
+        }
+
+        // Cancelling erases from session.orders, so collect first
+        void cancelAll(Session& session, uint32_t book, Ouch::CancelReason reason) {
+            std::vector<OrderId> ids;
+            for (const auto& [token, id] : session.orders) {
+                if (book == UINT32_MAX || routes_.at(id).book == book) ids.push_back(id);
+            }
+            for (OrderId id : ids) cancelLive(id, reason);
+        }
+
+        // False if the session must be closed
+        bool dispatch(Session& session, const uint8_t* payload, size_t length) {
+            messages_in_.fetch_add(1, std::memory_order_relaxed);
+            if (length == 0) return false;
+            switch (static_cast<char>(payload[0])) {
+                case Ouch::EnterOrder::TYPE:
+                    if (length != Ouch::EnterOrder::LENGTH) return false;
+                    enterOrder(session, Ouch::EnterOrder{{payload}});
+                    return true;
+                case Ouch::CancelOrder::TYPE:
+                    if (length != Ouch::CancelOrder::LENGTH) return false;
+                    cancelOrder(session, Ouch::CancelOrder{{payload}});
+                    return true;
+                case Ouch::ReplaceOrder::TYPE:
+                    if (length != Ouch::ReplaceOrder::LENGTH) return false;
+                    replaceOrder(session, Ouch::ReplaceOrder{{payload}});
+                    return true;
+                case Ouch::MassCancel::TYPE:
+                    if (length != Ouch::MassCancel::LENGTH) return false;
+                    massCancel(session, Ouch::MassCancel{{payload}});
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        // ========== Sockets ==========
+
+        void closeLater(Session& session) {
+            if (session.closing) return;
+            session.closing = true;
+            if (!session.dirty) {
+                session.dirty = true;
+                dirty_.push_back(&session);
+            }
+        }
+
+        // Drain the socket (edge-triggered) and apply every complete message
+        void readSession(Session& session) {
+            while (!session.closing) {
+                ssize_t received = ::recv(session.fd, session.in.get() + session.in_size, INPUT_BUFFER - session.in_size, 0);
+                if (received < 0) {
+                    if (errno == EINTR) continue;
+                    if (errno != EAGAIN && errno != EWOULDBLOCK) closeLater(session);
+                    return;
+                }
+                if (received == 0) return closeLater(session);
+                session.in_size += static_cast<size_t>(received);
+
+                bool broken = false;
+                bool valid = true;
+                size_t consumed = Ouch::forEachFrame(session.in.get(), session.in_size, [&](const uint8_t* payload, size_t length) {
+                    if (valid && !dispatch(session, payload, length)) valid = false;
+                }, Ouch::MAX_INBOUND_LENGTH, broken);
+                if (broken || !valid) {
+                    protocol_errors_.fetch_add(1, std::memory_order_relaxed);
+                    return closeLater(session);
+                }
+                session.in_size -= consumed;
+                if (session.in_size > 0) std::memmove(session.in.get(), session.in.get() + consumed, session.in_size);
+            }
+        }
+
+        // One send() for everything queued; the rest goes out on the next EPOLLOUT edge
+        void flush(Session& session) {
+            while (session.out_sent < session.out.size()) {
+                ssize_t sent = ::send(session.fd, session.out.data() + session.out_sent,
+                                      session.out.size() - session.out_sent, MSG_NOSIGNAL);
+                if (sent < 0) {
+                    if (errno == EINTR) continue;
+                    if (errno != EAGAIN && errno != EWOULDBLOCK) session.closing = true;
+                    break;
+                }
+                writes_.fetch_add(1, std::memory_order_relaxed);
+                session.out_sent += static_cast<size_t>(sent);
+            }
+            if (session.out_sent == session.out.size()) {
+                session.out.clear();
+                session.out_sent = 0;
+            }
+            else if (session.out.size() - session.out_sent > config_.max_output_bytes) {
+                session.closing = true; // Not reading its responses
+            }
+            else if (session.out_sent > session.out.size() / 2) {
+                session.out.erase(session.out.begin(), session.out.begin() + static_cast<ptrdiff_t>(session.out_sent));
+                session.out_sent = 0;
+            }
+        }
+
+        // Cancel the session's orders (responses go nowhere) and drop the socket
+        void closeSession(uint64_t id) {
+            auto it = sessions_.find(id);
+            if (it == sessions_.end()) return;
+            Session& session = *it->second;
+            session.closing = true;
+            cancelAll(session, UINT32_MAX, Ouch::CancelReason::USER_REQUESTED);
+            ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, session.fd, nullptr);
+            ::close(session.fd);
+            sessions_.erase(it);
+        }
+
+        void acceptSessions() {
+            for (;;) {
+                int fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                if (fd < 0) {
+                    if (errno == EINTR || errno == ECONNABORTED) continue;
+                    return; // EAGAIN, or out of descriptors until a session closes
+                }
+                int one = 1;
+                ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+                auto session = std::make_unique<Session>();
+                session->id = next_session_++;
+                session->fd = fd;
+                epoll_event event{};
+                event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+                event.data.u64 = session->id;
+                if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+                    ::close(fd);
+                    continue;
+                }
+                sessions_.emplace(session->id, std::move(session));
+                sessions_accepted_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        void run() {
+            epoll_event events[MAX_EVENTS];
+            std::vector<uint64_t> closing;
+            while (running_.load(std::memory_order_acquire)) {
+                int ready = ::epoll_wait(epoll_fd_, events, MAX_EVENTS, -1);
+                if (ready < 0) {
+                    if (errno == EINTR) continue;
+                    break;
+                }
+                for (int i = 0; i < ready; ++i) {
+                    uint64_t id = events[i].data.u64;
+                    if (id == LISTENER_ID) {
+                        acceptSessions();
+                        continue;
+                    }
+                    if (id == WAKEUP_ID) {
+                        uint64_t count;
+                        [[maybe_unused]] ssize_t drained = ::read(wakeup_fd_, &count, sizeof(count));
+                        continue;
+                    }
+                    auto it = sessions_.find(id);
+                    if (it == sessions_.end()) continue;
+                    Session& session = *it->second;
+                    if (events[i].events & (EPOLLIN | EPOLLRDHUP)) readSession(session);
+                    if (events[i].events & (EPOLLERR | EPOLLHUP)) closeLater(session);
+                    if ((events[i].events & EPOLLOUT) && !session.dirty && session.out_sent < session.out.size()) {
+                        session.dirty = true;
+                        dirty_.push_back(&session);
+                    }
+                }
+                // Sessions are only erased below, so the pointers are valid
+                for (Session* session : dirty_) {
+                    session->dirty = false;
+                    if (!session->closing) flush(*session);
+                    if (session->closing) closing.push_back(session->id);
+                }
+                dirty_.clear();
+                // Cancelling a closed session's orders only responds to that session, i.e. nowhere
+                for (uint64_t id : closing) closeSession(id);
+                closing.clear();
+            }
+        }
+
+        bool fail(const std::string& what) {
+            error_ = what + ": " + std::strerror(errno);
+            for (int* fd : {&listen_fd_, &epoll_fd_, &wakeup_fd_}) {
+                if (*fd >= 0) ::close(*fd);
+                *fd = -1;
+            }
+            return false;
+        }
+
+    public:
+        explicit OrderGateway(const std::vector<Symbol>& symbols, GatewayConfig config = {})
+            : config_(std::move(config)), listener_(std::make_shared<Listener>(*this)) {
+            for (const auto& symbol : symbols) {
+                book_index_.emplace(symbol, static_cast<uint32_t>(books_.size()));
+                books_.push_back(std::make_unique<Book>(symbol));
+                books_.back()->addOrderListener(listener_);
+            }
+        }
+
+        ~OrderGateway() { stop(); }
+
+        OrderGateway(const OrderGateway&) = delete;
+        OrderGateway& operator=(const OrderGateway&) = delete;
+
+        /**
+         * @brief Listen on the configured address and start serving sessions.
+         * @return False with error() set if the socket cannot be set up.
+         */
+        bool start() {
+            if (running_.load()) return true;
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_port = htons(config_.port);
+            if (::inet_pton(AF_INET, config_.address.c_str(), &address.sin_addr) != 1) {
+                error_ = "not an IPv4 address: " + config_.address;
+                return false;
+            }
+
+            listen_fd_ = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+            if (listen_fd_ < 0) return fail("socket");
+            int one = 1;
+            ::setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+            if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+                return fail(config_.address + ":" + std::to_string(config_.port));
+            }
+            if (::listen(listen_fd_, SOMAXCONN) < 0) return fail("listen");
+            socklen_t length = sizeof(address);
+            ::getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&address), &length);
+            port_ = ntohs(address.sin_port);
+
+            epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+            if (epoll_fd_ < 0) return fail("epoll_create1");
+            wakeup_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (wakeup_fd_ < 0) return fail("eventfd");
+            epoll_event event{};
+            event.events = EPOLLIN | EPOLLET;
+            event.data.u64 = LISTENER_ID;
+            if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, listen_fd_, &event) < 0) return fail("epoll_ctl");
+            event.data.u64 = WAKEUP_ID;
+            if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wakeup_fd_, &event) < 0) return fail("epoll_ctl");
+
+            running_.store(true, std::memory_order_release);
+            thread_ = std::thread([this] { run(); });
+            return true;
+        }
+
+        // Close every session (their orders stay in the books) and stop listening
+        void stop() {
+            if (!running_.exchange(false)) return;
+            uint64_t one = 1;
+            [[maybe_unused]] ssize_t written = ::write(wakeup_fd_, &one, sizeof(one));
+            if (thread_.joinable()) thread_.join();
+            for (auto& [id, session] : sessions_) ::close(session->fd);
+            sessions_.clear();
+            routes_.clear();
+            for (int* fd : {&listen_fd_, &epoll_fd_, &wakeup_fd_}) {
+                ::close(*fd);
+                *fd = -1;
+            }
+        }
+
+        // Port actually listened on, once started
+        uint16_t port() const { return port_; }
+        const std::string& error() const { return error_; }
+        size_t books() const { return books_.size(); }
+        // Read book state only while stopped
+        const Book& book(size_t index) const { return *books_[index]; }
+
+        uint64_t sessionsAccepted() const { return sessions_accepted_.load(std::memory_order_relaxed); }
+        uint64_t messagesIn() const { return messages_in_.load(std::memory_order_relaxed); }
+        uint64_t messagesOut() const { return messages_out_.load(std::memory_order_relaxed); }
+        // send() calls that moved bytes; well below messagesOut() when responses are batched
+        uint64_t writes() const { return writes_.load(std::memory_order_relaxed); }
+        // Sessions closed for a malformed frame
+        uint64_t protocolErrors() const { return protocol_errors_.load(std::memory_order_relaxed); }
+    };
+
+} // namespace OrderEngine
+
+#endif // ORDER_GATEWAY_H
@@ -4,12 +4,15 @@
 
 #include "Order.h"
 #include "OrderTypes.h"
+#include "Listeners.h"
+#include "LiquidityIndex.h"
+#include "FenwickTree.h"
+#include "NodePool.h"
+#include "MemoryFootprint.h"
 #include <map>
-#include <list>
 #include <vector>
 #include <memory>
 #include <algorithm>
-// DOUBTS: Where to use PriceComparator?
 namespace OrderEngine {
 
     // Forward declaration
@@ -21,6 +24,8 @@ namespace OrderEngine {
     * A PriceLevel groups all active orders submitted at the same price.
     * It maintains both the list of orders (FIFO by entry time) and 
     * aggregate statistics like total open quantity and order count.  
+    * Orders sit in arrival-ordered slots with Fenwick trees of per-slot
+    * quantity and order count, so queue position is an O(log k) prefix sum.
     * Provides efficient operations for adding, removing, updating, 
     * and filling orders at this price.
     * Think of an order book like a building with floors, where each floor represents a different price
@@ -34,24 +39,72 @@ namespace OrderEngine {
     */
     template<typename OrderPtr> class PriceLevel {
     public:
+        // Orders in arrival order; a vacated slot (cancelled / filled) holds an empty OrderPtr
         using OrderList = std::vector<OrderPtr>;
-        using OrderIterator = typename OrderList::iterator;
+        // Slot index of an order within its level, stable until the level is compacted
+        using OrderHandle = size_t;
+
+        // Position of a resting order within its level's FIFO queue
+        struct QueuePosition {
+            Quantity quantity_ahead;
+            size_t orders_ahead;
+        };
     private:
         Price price_; // $150.00 
         OrderList orders_; // [John, Sarah, Mike]
+        size_t head_; // First slot that can still hold a live order
         Quantity total_quantity_; // 2,300 shares total
         size_t order_count_; // 3 orders at this price
+
+        // Order statistics over slots: open quantity and live-order count
+        FenwickTree<Quantity> slot_quantity_;
+        FenwickTree<uint32_t> slot_orders_;
+
+        // Slots kept around before compaction is worthwhile
+        static constexpr size_t MIN_COMPACT_SLOTS = 32;
+
+        void vacate(OrderHandle handle, Quantity open_qty) {
+            orders_[handle] = OrderPtr{};
+            slot_quantity_.add(handle, Quantity{} - open_qty);
+            slot_orders_.add(handle, static_cast<uint32_t>(-1));
+            while (head_ < orders_.size() && !orders_[head_]) ++head_;
+        }
         
     public:
         explicit PriceLevel(Price price) 
-            : price_(price), total_quantity_(0), order_count_(0) {}
+            : price_(price), head_(0), total_quantity_(0), order_count_(0) {}
+
+        // Empty the level and move it to `price`, keeping the capacity of its containers
+        void reset(Price price) {
+            price_ = price;
+            orders_.clear();
+            head_ = 0;
+            total_quantity_ = 0;
+            order_count_ = 0;
+            slot_quantity_.reset(0);
+            slot_orders_.reset(0);
+        }
         
         // Accessors
         Price price() const { return price_; }
         Quantity total_quantity() const { return total_quantity_; }
         size_t order_count() const { return order_count_; }
-        bool empty() const { return orders_.empty(); }
+        bool empty() const { return order_count_ == 0; }
+        // Raw slots, skip empty entries when iterating (see for_each_order)
         const OrderList& orders() const { return orders_; }
+
+        // The level object plus its slot and queue-position storage, by capacity
+        size_t memory_bytes() const {
+            return sizeof(*this) + orders_.capacity() * sizeof(OrderPtr) +
+                   slot_quantity_.memory_bytes() + slot_orders_.memory_bytes();
+        }
+
+        // Visit live orders in time priority
+        template<typename Fn> void for_each_order(Fn&& fn) const {
+            for (size_t i = head_; i < orders_.size(); ++i) {
+                if (orders_[i]) fn(orders_[i]);
+            }
+        }
         
         /**
         * @brief Adds a new order to the list of tracked orders.
@@ -59,27 +112,69 @@ namespace OrderEngine {
         * @details
         * Updates aggregate statistics (total open quantity and order count)
         * and appends the order to the internal container.
-        * @return Iterator pointing to the newly inserted order.
+        * @return Handle (slot) of the newly inserted order.
         */
-        OrderIterator add_order(const OrderPtr& order) {
+        OrderHandle add_order(const OrderPtr& order) {
             total_quantity_ += order->open_quantity();
             order_count_++;
-            return orders_.insert(orders_.end(), order);
+            orders_.push_back(order);
+            slot_quantity_.push_back(order->open_quantity());
+            slot_orders_.push_back(1);
+            return orders_.size() - 1;
         }
         
-        void remove_order(OrderIterator it) {
-            total_quantity_ -= (*it)->open_quantity();
+        void remove_order(OrderHandle handle) {
+            if (handle >= orders_.size() || !orders_[handle]) return; // already gone
+            Quantity open_qty = orders_[handle]->open_quantity();
+            total_quantity_ -= open_qty;
             --order_count_;
-            orders_.erase(it);
+            vacate(handle, open_qty);
         }
         
-        void update_quantity(const OrderPtr& order, Quantity old_qty, Quantity new_qty) {
+        void update_quantity(OrderHandle handle, Quantity old_qty, Quantity new_qty) {
             total_quantity_+=(new_qty- old_qty); // O(1)
+            slot_quantity_.add(handle, new_qty - old_qty); // O(log k)
+        }
+
+        /**
+         * @brief Quantity and number of orders queued ahead of `handle`. O(log k)
+         */
+        QueuePosition queue_position(OrderHandle handle) const {
+            return QueuePosition{slot_quantity_.prefix_sum(handle), slot_orders_.prefix_sum(handle)};
         }
         
         // Get the first order (FIFO)
         OrderPtr front_order() const {
-            return orders_.empty() ? OrderPtr{} : orders_.front();
+            return head_ < orders_.size() ? orders_[head_] : OrderPtr{};
+        }
+
+        // True once vacated slots outnumber live orders (and there are enough to bother)
+        bool needs_compaction() const {
+            return orders_.size() >= MIN_COMPACT_SLOTS && orders_.size() >= 2 * order_count_;
+        }
+
+        /**
+         * @brief Drop vacated slots, keeping time priority.
+         * @param on_moved Called as on_moved(order, new_handle) for every surviving order,
+         *                 so the owner can refresh cached handles.
+         */
+        template<typename Fn> void compact(Fn&& on_moved) {
+            size_t live = 0;
+            for (size_t i = head_; i < orders_.size(); ++i) {
+                if (!orders_[i]) continue;
+                if (live != i) orders_[live] = std::move(orders_[i]);
+                on_moved(orders_[live], live);
+                ++live;
+            }
+            orders_.resize(live);
+            head_ = 0;
+
+            slot_quantity_.reset(0);
+            slot_orders_.reset(0);
+            for (const auto& order : orders_) {
+                slot_quantity_.push_back(order->open_quantity());
+                slot_orders_.push_back(1);
+            }
         }
         
         // Fill orders at this price level up to specified quantity
@@ -88,10 +183,11 @@ namespace OrderEngine {
         // Main order matching logic
         Quantity fill_quantity(Quantity max_quantity) {
             Quantity filled = 0; // track how much we've filled so far
-            auto it = orders_.begin(); // get first order 
+            size_t slot = head_; // get first order 
             
-            while (it != orders_.end() && filled < max_quantity) {
-                auto order = *it;
+            while (slot < orders_.size() && filled < max_quantity) {
+                auto order = orders_[slot];
+                if (!order) { ++slot; continue; }
                 Quantity available = order->open_quantity(); // shares available
                 Quantity fill_qty = std::min(available, max_quantity - filled); // how many we can fill from current order
                 order->set_open_quantity(available - fill_qty); // reduce open quantity
@@ -101,13 +197,14 @@ namespace OrderEngine {
                 if (order->open_quantity() == 0) {
                     // Order completely filled, remove it
                     order->set_status(OrderStatus::FILLED);
-                    it = orders_.erase(it);
                     --order_count_;
+                    vacate(slot, fill_qty);
                 } 
                 else {
                     order->set_status(OrderStatus::PARTIALLY_FILLED);
-                    it++;
+                    slot_quantity_.add(slot, Quantity{} - fill_qty);
                 }
+                ++slot;
             }
             return filled;
         }
@@ -121,15 +218,56 @@ namespace OrderEngine {
     * price-time priority. Tracks order locations for fast access and 
     * updates, supports order matching against incoming trades, and 
     * provides quick access to the best price levels.  
+    * A LiquidityIndex (treap over the prices holding liquidity) is kept in step with
+    * every level change, answering cumulative liquidity queries in O(log n).
+    * Map nodes come from per-tracker NodePools and emptied levels are kept for
+    * reuse, so once the tracker has seen its working size (orders and levels)
+    * adding, matching and removing orders no longer touches the heap.
     */
     template<typename OrderPtr> class OrderTracker {
     public:
+        // Custom comparator for price levels based on order side
+        struct PriceComparator {
+            bool is_buy_side;
+            
+            explicit PriceComparator(bool buy_side) : is_buy_side(buy_side) {}
+            
+            // BUY SIDE (Bids) : higher prices first (best bid at top)
+            // SELL SIDE (Asks): lower prices first (best ask at top)
+            bool operator()(Price a, Price b) const {
+                return is_buy_side ? a > b : a < b;  
+            }
+        };
+
         using PriceLevelPtr = std::shared_ptr<PriceLevel<OrderPtr>>;
-        using PriceLevelMap = std::map<Price, PriceLevelPtr>;
+        using PriceLevelMap = std::map<Price, PriceLevelPtr, PriceComparator,
+                                       PoolAllocator<std::pair<const Price, PriceLevelPtr>>>;
         // Cache for efficient order lookups
-        using OrderLocationMap = std::map<OrderId, std::pair<Price, typename PriceLevel<OrderPtr>::OrderIterator>>;
+        using OrderHandle = typename PriceLevel<OrderPtr>::OrderHandle;
+        using OrderLocation = std::pair<Price, OrderHandle>;
+        using OrderLocationMap = std::map<OrderId, OrderLocation, std::less<OrderId>,
+                                          PoolAllocator<std::pair<const OrderId, OrderLocation>>>;
+
+        // Outcome of replace_order
+        enum class ReplaceResult {
+            NOT_FOUND,          // Order is not resting on this side
+            MODIFIED_IN_PLACE,  // Same price, quantity down: time priority kept
+            REQUEUED            // Price change or quantity up: moved to the back of its level
+        };
+
+        // Where a resting order sits and what is queued ahead of it
+        struct QueuePosition {
+            bool found = false;
+            Price price = 0;
+            Quantity quantity_ahead = 0;
+            size_t orders_ahead = 0;
+        };
         
     private:
+        // Node storage of the two maps below, declared first so it outlives them
+        NodePool level_nodes_;
+        NodePool location_nodes_;
+
         /**
             price_levels_[15100] = PriceLevel containing [Order A, Order B, Order C]  // $151.00
             price_levels_[15050] = PriceLevel containing [Order D, Order E]           // $150.50  
@@ -141,45 +279,103 @@ namespace OrderEngine {
             Location of order with some ID is the key.
             The value is a pair containing:
             1) The price level where the order resides (e.g., $150.00)
-            2) An iterator pointing to the order within that price level's order list.
-            order_locations_[12345] = {15000, iterator_to_order_F}  // Order 12345 is at $150.00
-            order_locations_[67890] = {15050, iterator_to_order_D}  // Order 67890 is at $150.50
+            2) The order's handle (slot) within that price level's order list.
+            order_locations_[12345] = {15000, slot_of_order_F}  // Order 12345 is at $150.00
+            order_locations_[67890] = {15050, slot_of_order_D}  // Order 67890 is at $150.50
         */
         OrderLocationMap order_locations_; 
 
+        // Emptied levels kept for reuse, so a level coming back costs no allocation
+        std::vector<PriceLevelPtr> spare_levels_;
+
         bool is_buy_side_;
-        
-        // Custom comparator for price levels based on order side
-        struct PriceComparator {
-            bool is_buy_side;
-            
-            explicit PriceComparator(bool buy_side) : is_buy_side(buy_side) {}
-            
-            // BUY SIDE (Bids) : higher prices first (best bid at top)
-            // SELL SIDE (Asks): lower prices first (best ask at top)
-            bool operator()(Price a, Price b) const {
-                return is_buy_side ? a > b : a < b;  
+
+        // Cumulative open quantity per price, updated on every level change
+        LiquidityIndex liquidity_;
+
+        // Incremental views notified on every level change (non-owning)
+        std::vector<LevelChangeListener*> level_listeners_;
+
+        void notify_level_change(Price price, Quantity old_qty, Quantity new_qty,
+                                size_t old_count, size_t new_count) {
+            liquidity_.apply(price, old_qty, new_qty);
+            for (auto* listener : level_listeners_) {
+                listener->on_level_change(is_buy_side_, price, old_qty, new_qty, old_count, new_count);
             }
-        };
+        }
+        // Empty level for `price`, recycled when no one outside the tracker still holds the spare
+        PriceLevelPtr make_level(Price price) {
+            if (!spare_levels_.empty() && spare_levels_.back().use_count() == 1) {
+                PriceLevelPtr level = std::move(spare_levels_.back());
+                spare_levels_.pop_back();
+                level->reset(price);
+                return level;
+            }
+            return std::make_shared<PriceLevel<OrderPtr>>(price);
+        }
+
+        // Erase an emptied level from the map and keep it as a spare
+        void retire_level(typename PriceLevelMap::iterator level_it) {
+            spare_levels_.push_back(std::move(level_it->second));
+            price_levels_.erase(level_it);
+        }
+
+        // Drop vacated slots of a level and refresh the cached handles of its orders
+        void compact_level(PriceLevel<OrderPtr>& level) {
+            level.compact([this](const OrderPtr& order, OrderHandle handle) {
+                auto location_it = order_locations_.find(order->order_id());
+                if (location_it != order_locations_.end()) location_it->second.second = handle;
+            });
+        }
     public:
-        explicit OrderTracker(bool is_buy_side) : is_buy_side_(is_buy_side) {}
+        /**
+         * @param is_buy_side True for the bid side (best = highest price).
+         * @param tick_size Price units per LiquidityIndex slot (1 = exact per paisa).
+         */
+        explicit OrderTracker(bool is_buy_side, Price tick_size = 1) 
+            : price_levels_(PriceComparator(is_buy_side), typename PriceLevelMap::allocator_type(&level_nodes_)),
+              order_locations_(std::less<OrderId>(), typename OrderLocationMap::allocator_type(&location_nodes_)),
+              is_buy_side_(is_buy_side), liquidity_(tick_size) {}
+
+        // The maps point into this tracker's node pools
+        OrderTracker(const OrderTracker&) = delete;
+        OrderTracker& operator=(const OrderTracker&) = delete;
+
+        bool is_buy_side() const { return is_buy_side_; }
+
+        /**
+         * @brief Register a listener for level aggregate changes.
+         * @param listener Non-owning pointer, must outlive this tracker or be removed first.
+         */
+        void add_level_listener(LevelChangeListener* listener) {
+            level_listeners_.push_back(listener);
+        }
+
+        void remove_level_listener(LevelChangeListener* listener) {
+            level_listeners_.erase(std::remove(level_listeners_.begin(), level_listeners_.end(), listener),
+                                   level_listeners_.end());
+        }
         
-        // Add order to tracker
+        // Add order to tracker, refusing an id that is already tracked
         bool addOrder(const OrderPtr& order) {
+            if (order_locations_.count(order->order_id())) return false;
             Price price = order->price();
             
             // Find or create price level
             auto level_it = price_levels_.find(price);
             if (level_it == price_levels_.end()) {
-                auto new_level = std::make_shared<PriceLevel<OrderPtr>>(price);
-                level_it = price_levels_.emplace(price, new_level).first;
+                level_it = price_levels_.emplace(price, make_level(price)).first;
             }
             
             // Add order to price level
-            auto order_it = level_it->second->add_order(order);
+            auto& level = level_it->second;
+            Quantity old_qty = level->total_quantity();
+            size_t old_count = level->order_count();
+            auto handle = level->add_order(order);
+            notify_level_change(price, old_qty, level->total_quantity(), old_count, level->order_count());
             
             // Track order location for fast lookup
-            order_locations_[order->order_id()] = std::make_pair(price, order_it);
+            order_locations_[order->order_id()] = OrderLocation(price, handle);
             
             return true;
         }
@@ -192,16 +388,23 @@ namespace OrderEngine {
             }
             
             Price price = location_it->second.first;
-            auto order_it = location_it->second.second;
+            auto handle = location_it->second.second;
             
             // Remove from price level
             auto level_it = price_levels_.find(price);
             if (level_it != price_levels_.end()) {
-                level_it->second->remove_order(order_it);
+                auto& level = level_it->second;
+                Quantity old_qty = level->total_quantity();
+                size_t old_count = level->order_count();
+                level->remove_order(handle);
+                notify_level_change(price, old_qty, level->total_quantity(), old_count, level->order_count());
                 
                 // Remove empty price level
                 if (level_it->second->empty()) {
-                    price_levels_.erase(level_it);
+                    retire_level(level_it);
+                }
+                else if (level->needs_compaction()) {
+                    compact_level(*level);
                 }
             }
             else{
@@ -222,13 +425,114 @@ namespace OrderEngine {
                 Price price = location_it->second.first;
                 auto level_it = price_levels_.find(price);
                 if (level_it != price_levels_.end()) {
+                    auto& level = level_it->second;
                     Quantity old_qty = order->open_quantity();
+                    Quantity old_level_qty = level->total_quantity();
                     order->set_open_quantity(new_qty);
-                    level_it->second->update_quantity(order, old_qty, new_qty);
+                    level->update_quantity(location_it->second.second, old_qty, new_qty);
+                    notify_level_change(price, old_level_qty, level->total_quantity(),
+                                        level->order_count(), level->order_count());
                 }
             }
         }
         
+        /**
+         * @brief Atomically change the price and/or open quantity of a resting order.
+         * @param order Resting order on this side.
+         * @param new_price Price after the replace (may equal the current price).
+         * @param new_open_qty Open quantity after the replace, must be > 0.
+         * @details
+         * One location lookup for the whole operation and no map node churn:
+         * - same price, quantity down (or equal): the slot is resized in place and the
+         *   order keeps its time priority; a single level delta is raised.
+         * - same price, quantity up: the order moves to the back of the same level;
+         *   still a single level delta since the order count does not change.
+         * - new price: removed from the old level and appended to the new one, the
+         *   cached location is rewritten in place.
+         * The caller is responsible for making sure a new price does not cross the book.
+         */
+        ReplaceResult replace_order(const OrderPtr& order, Price new_price, Quantity new_open_qty) {
+            auto location_it = order_locations_.find(order->order_id());
+            if (location_it == order_locations_.end()) return ReplaceResult::NOT_FOUND;
+
+            Price old_price = location_it->second.first;
+            auto level_it = price_levels_.find(old_price);
+            if (level_it == price_levels_.end()) return ReplaceResult::NOT_FOUND;
+
+            // No copy of the pointer: a level retired below can be reused for the new price
+            auto& level = *level_it->second;
+            Quantity old_level_qty = level.total_quantity();
+            size_t old_count = level.order_count();
+            Quantity old_open_qty = order->open_quantity();
+
+            if (new_price == old_price) {
+                if (new_open_qty <= old_open_qty) {
+                    order->set_open_quantity(new_open_qty);
+                    level.update_quantity(location_it->second.second, old_open_qty, new_open_qty);
+                    notify_level_change(old_price, old_level_qty, level.total_quantity(), old_count, old_count);
+                    return ReplaceResult::MODIFIED_IN_PLACE;
+                }
+                level.remove_order(location_it->second.second);
+                order->set_open_quantity(new_open_qty);
+                location_it->second.second = level.add_order(order);
+                notify_level_change(old_price, old_level_qty, level.total_quantity(), old_count, old_count);
+                if (level.needs_compaction()) compact_level(level);
+                return ReplaceResult::REQUEUED;
+            }
+
+            level.remove_order(location_it->second.second);
+            notify_level_change(old_price, old_level_qty, level.total_quantity(), old_count, level.order_count());
+            if (level.empty()) {
+                retire_level(level_it);
+            }
+            else if (level.needs_compaction()) {
+                compact_level(level);
+            }
+
+            order->set_price(new_price);
+            order->set_open_quantity(new_open_qty);
+            auto new_level_it = price_levels_.find(new_price);
+            if (new_level_it == price_levels_.end()) {
+                new_level_it = price_levels_.emplace(new_price, make_level(new_price)).first;
+            }
+            auto& new_level = new_level_it->second;
+            Quantity new_level_old_qty = new_level->total_quantity();
+            size_t new_level_old_count = new_level->order_count();
+            location_it->second = std::make_pair(new_price, new_level->add_order(order));
+            notify_level_change(new_price, new_level_old_qty, new_level->total_quantity(),
+                                new_level_old_count, new_level->order_count());
+            return ReplaceResult::REQUEUED;
+        }
+
+        // Resting order with `order_id`, or an empty pointer if it is not on this side
+        OrderPtr find_order(OrderId order_id) const {
+            auto location_it = order_locations_.find(order_id);
+            if (location_it == order_locations_.end()) return OrderPtr{};
+            auto level_it = price_levels_.find(location_it->second.first);
+            if (level_it == price_levels_.end()) return OrderPtr{};
+            return level_it->second->orders()[location_it->second.second];
+        }
+
+        /**
+         * @brief Quantity and number of orders ahead of `order_id` in its level's queue.
+         * @details O(log n) location lookup plus O(log k) prefix sums within the level.
+         */
+        QueuePosition queue_position(OrderId order_id) const {
+            QueuePosition position;
+            auto location_it = order_locations_.find(order_id);
+            if (location_it == order_locations_.end()) return position;
+            
+            auto level_it = price_levels_.find(location_it->second.first);
+            if (level_it == price_levels_.end()) return position;
+            
+            auto ahead = level_it->second->queue_position(location_it->second.second);
+            position.found = true;
+            position.price = location_it->second.first;
+            position.quantity_ahead = ahead.quantity_ahead;
+            position.orders_ahead = ahead.orders_ahead;
+            return position;
+        }
+        
         // Get best price (top of book)
         Price best_price() const {
             if (price_levels_.empty()) return 0;
@@ -258,11 +562,56 @@ namespace OrderEngine {
             return level ? level->total_quantity() : 0;
         }
         
+        // ========== Cumulative Liquidity (O(log n)) ==========
+
+        /**
+         * @brief Open quantity from the best price through `limit_price` inclusive.
+         * @details 
+         * Bids count prices >= limit_price, asks count prices <= limit_price, i.e.
+         * what an opposite order limited at `limit_price` could execute against.
+         */
+        Quantity quantity_through_price(Price limit_price) const {
+            return is_buy_side_ ? liquidity_.quantity_at_or_above(limit_price)
+                                : liquidity_.quantity_at_or_below(limit_price);
+        }
+
+        /**
+         * @brief Worst price that has to be reached to accumulate `quantity`.
+         * @return The price, or 0 if this side holds less than `quantity` in total.
+         */
+        Price price_for_quantity(Quantity quantity) const {
+            return is_buy_side_ ? liquidity_.highest_price_covering(quantity)
+                                : liquidity_.lowest_price_covering(quantity);
+        }
+
+        // Total open quantity on this side
+        Quantity total_quantity() const { return liquidity_.total_quantity(); }
+
+        // Open quantity of the best `levels` price levels, O(log n)
+        Quantity quantity_of_best_levels(size_t levels) const {
+            return is_buy_side_ ? liquidity_.quantity_of_highest_levels(levels)
+                                : liquidity_.quantity_of_lowest_levels(levels);
+        }
+
+        /**
+         * @brief Price a hypothetical order of `quantity` sweeping this side from the best price.
+         * @details Does not touch any level; O(log n) from the liquidity index.
+         */
+        SweepEstimate estimate_sweep(Quantity quantity) const {
+            return is_buy_side_ ? liquidity_.sweep_descending(quantity)
+                                : liquidity_.sweep_ascending(quantity);
+        }
+
+        const LiquidityIndex& liquidity_index() const { return liquidity_; }
+        
         // Get all price levels (sorted by priority)
         const PriceLevelMap& price_levels() const { return price_levels_; }
         
         // Clear all orders
         void clear() {
+            for (const auto& [price, level] : price_levels_) {
+                notify_level_change(price, level->total_quantity(), 0, level->order_count(), 0);
+            }
             price_levels_.clear();
             order_locations_.clear();
         }
@@ -270,11 +619,39 @@ namespace OrderEngine {
         // Statistics
         size_t total_orders() const { return order_locations_.size(); }
         size_t total_price_levels() const { return price_levels_.size(); }
+
+        /**
+         * @brief Heap bytes held by this side: orders, levels, location index, liquidity index.
+         * @details O(levels). Map nodes are counted from the node pools, so blocks
+         * freed back to a pool still count; a level is charged its shared_ptr
+         * control block on top of memory_bytes().
+         */
+        MemoryFootprint memory_footprint() const {
+            constexpr size_t LEVEL_CONTROL_BLOCK = sizeof(void*) + 2 * sizeof(int);
+            MemoryFootprint footprint;
+            footprint.orders = order_locations_.size() * PointeeFootprint<OrderPtr>::bytes;
+            footprint.price_levels = level_nodes_.bytes_reserved() + spare_levels_.capacity() * sizeof(PriceLevelPtr) +
+                                     sizeof(LevelChangeListener*) * level_listeners_.capacity();
+            for (const auto& [price, level] : price_levels_) {
+                footprint.price_levels += LEVEL_CONTROL_BLOCK + level->memory_bytes();
+                footprint.order_slots += level->orders().size();
+            }
+            for (const auto& level : spare_levels_) {
+                footprint.price_levels += LEVEL_CONTROL_BLOCK + level->memory_bytes();
+            }
+            footprint.order_index = location_nodes_.bytes_reserved();
+            footprint.liquidity_index = liquidity_.memory_bytes();
+            footprint.resting_orders = order_locations_.size();
+            footprint.levels = price_levels_.size();
+            footprint.spare_levels = spare_levels_.size();
+            footprint.index_nodes = liquidity_.slot_count();
+            return footprint;
+        }
         
         bool empty() const { return price_levels_.empty(); }
         
         // Match against incoming order (for crossing trades)
-        std::vector<std::pair<OrderPtr, Quantity>> matchQuantity(Price limit_price, Quantity max_quantity) {
+        std::vector<std::pair<OrderPtr, Quantity>> matchQuantity(Price limit_price, Quantity max_quantity) const {
             std::vector<std::pair<OrderPtr, Quantity>> matches;
             Quantity remaining = max_quantity;
             
@@ -286,20 +663,14 @@ namespace OrderEngine {
                 bool can_match = is_buy_side_ ? (level_price >= limit_price) : (level_price <= limit_price);
                 if (!can_match) break;
                 
-                auto level = it->second;
-                auto& orders = level->orders();
-                auto order_it = orders.begin();
-                
-                while (order_it != orders.end() && remaining > 0) {
-                    auto order = *order_it;
+                it->second->for_each_order([&](const OrderPtr& order) {
+                    if (remaining == 0) return;
                     Quantity available = order->open_quantity();
                     Quantity match_qty = std::min(available, remaining);
                     
                     matches.emplace_back(order, match_qty);
                     remaining -= match_qty;
-                    
-                    ++order_it;
-                }
+                });
                 
                 ++it;
             }
@@ -13,6 +13,7 @@ namespace OrderEngine {
     using Quantity = uint64_t;      // Order quantity
     using OrderId = uint64_t;       // Unique order identifier
     using Symbol = std::string;     // Trading symbol
+    using ParticipantId = uint64_t; // Firm / market maker submitting quotes
     using Timestamp = std::chrono::high_resolution_clock::time_point;
 
     /* Special price values
@@ -58,7 +59,9 @@ namespace OrderEngine {
 
     /* Bitmask flags representing special order conditions. Multiple conditions can be combined
      * - NO_CONDITIONS      : Default, no special execution constraints. (DEFAULT)
-     * - ALL_OR_NONE        : Order must be filled completely or not at all.
+     * - ALL_OR_NONE        : Order must be filled completely or not at all. Valid alone only on
+     *                        market orders, which never rest; a limit order must add
+     *                        IMMEDIATE_OR_CANCEL (i.e. FOK), otherwise it is rejected.
      * - IMMEDIATE_OR_CANCEL: Order must execute immediately; unfilled portion is cancelled.
      * - FILL_OR_KILL (FOK) : Combination of ALL_OR_NONE and IMMEDIATE_OR_CANCEL — 
      *                        must be fully filled immediately, otherwise cancelled.
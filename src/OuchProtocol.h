@@ -0,0 +1,296 @@
+#pragma once
+#ifndef OUCH_PROTOCOL_H
+#define OUCH_PROTOCOL_H
+
+#include "OrderTypes.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+namespace OrderEngine {
+namespace Ouch {
+
+    /**
+     * Binary order entry protocol, modelled on NASDAQ OUCH 4.2.
+     *
+     * Every message is fixed width, big-endian, and framed on the TCP stream by
+     * a 2-byte big-endian length as in SoupBinTCP (without its session layer).
+     * The first payload byte is the message type. Orders are named by a client
+     * token, unique among the session's live orders; prices are paisa.
+     *
+     * Client -> gateway             Gateway -> client
+     * 'O' Enter Order        27     'A' Accepted    42
+     * 'X' Cancel Order        9     'E' Executed    33
+     * 'U' Replace Order      17     'C' Cancelled   22
+     * 'M' Mass Cancel         9     'U' Replaced    25
+     *                               'J' Rejected    18
+     *
+     * Decoding works in place like Itch: views wrap a pointer into the receive
+     * buffer. Encoding appends a framed message to a byte vector.
+     */
+
+    constexpr size_t FRAME_HEADER = 2;
+    constexpr size_t STOCK_LENGTH = 8;             // Space padded; longer symbols cannot be addressed
+    constexpr uint32_t MARKET = 0x7FFFFFFF;        // Enter Order price of a market order
+
+    enum class CancelReason : char {
+        USER_REQUESTED = 'U',   // Cancel Order
+        MASS_CANCEL = 'M',      // Mass Cancel
+        IMMEDIATE = 'I'         // Unfilled remainder of a market, IOC or FOK order
+    };
+
+    enum class RejectReason : char {
+        UNKNOWN_SYMBOL = 'S',
+        DUPLICATE_TOKEN = 'D',  // Token already names a live order of the session
+        UNKNOWN_TOKEN = 'T',    // Cancel / replace of an order that is not live
+        INVALID_ORDER = 'O',    // Bad side, time in force, size or price
+        REPLACE_REJECTED = 'R'  // Replace refused by the book; the order stays as it was
+    };
+
+    // ========== Field Access ==========
+
+    inline uint32_t readU32(const uint8_t* p) {
+        return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+               (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+    }
+
+    inline uint64_t readU64(const uint8_t* p) {
+        return (static_cast<uint64_t>(readU32(p)) << 32) | readU32(p + 4);
+    }
+
+    inline void writeU32(uint8_t* p, uint32_t value) {
+        p[0] = static_cast<uint8_t>(value >> 24);
+        p[1] = static_cast<uint8_t>(value >> 16);
+        p[2] = static_cast<uint8_t>(value >> 8);
+        p[3] = static_cast<uint8_t>(value);
+    }
+
+    inline void writeU64(uint8_t* p, uint64_t value) {
+        writeU32(p, static_cast<uint32_t>(value >> 32));
+        writeU32(p + 4, static_cast<uint32_t>(value));
+    }
+
+    inline std::string_view readStock(const uint8_t* p) {
+        size_t width = STOCK_LENGTH;
+        while (width > 0 && p[width - 1] == ' ') --width;
+        return std::string_view(reinterpret_cast<const char*>(p), width);
+    }
+
+    inline void writeStock(uint8_t* p, std::string_view stock) {
+        size_t length = stock.size() < STOCK_LENGTH ? stock.size() : STOCK_LENGTH;
+        std::memcpy(p, stock.data(), length);
+        std::memset(p + length, ' ', STOCK_LENGTH - length);
+    }
+
+    // Quantities and prices above 32 bits are clamped on the wire
+    inline uint32_t clamp32(uint64_t value) { return value > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(value); }
+
+    // Append the frame header and `length` zeroed payload bytes starting with `type`; returns the payload
+    inline uint8_t* appendFrame(std::vector<uint8_t>& out, char type, size_t length) {
+        size_t at = out.size();
+        out.resize(at + FRAME_HEADER + length);
+        uint8_t* frame = out.data() + at;
+        frame[0] = static_cast<uint8_t>(length >> 8);
+        frame[1] = static_cast<uint8_t>(length);
+        frame[FRAME_HEADER] = static_cast<uint8_t>(type);
+        return frame + FRAME_HEADER;
+    }
+
+    // ========== Client -> Gateway ==========
+
+    struct MessageView {
+        const uint8_t* data;
+        char type() const { return static_cast<char>(data[0]); }
+    };
+
+    // 'O' Enter Order; side 'B' / 'S', time in force as TimeInForce ('G', 'I', 'F', 'D')
+    struct EnterOrder : MessageView {
+        static constexpr char TYPE = 'O';
+        static constexpr size_t LENGTH = 27;
+        uint64_t token() const { return readU64(data + 1); }
+        char side() const { return static_cast<char>(data[9]); }
+        uint32_t shares() const { return readU32(data + 10); }
+        std::string_view stock() const { return readStock(data + 14); }
+        uint32_t price() const { return readU32(data + 22); }
+        char time_in_force() const { return static_cast<char>(data[26]); }
+    };
+
+    // 'X' Cancel Order
+    struct CancelOrder : MessageView {
+        static constexpr char TYPE = 'X';
+        static constexpr size_t LENGTH = 9;
+        uint64_t token() const { return readU64(data + 1); }
+    };
+
+    // 'U' Replace Order; shares is the new total quantity, 0 keeps size or price unchanged
+    struct ReplaceOrder : MessageView {
+        static constexpr char TYPE = 'U';
+        static constexpr size_t LENGTH = 17;
+        uint64_t token() const { return readU64(data + 1); }
+        uint32_t shares() const { return readU32(data + 9); }
+        uint32_t price() const { return readU32(data + 13); }
+    };
+
+    // 'M' Mass Cancel of the session's orders in one book, or in every book if the stock is blank
+    struct MassCancel : MessageView {
+        static constexpr char TYPE = 'M';
+        static constexpr size_t LENGTH = 9;
+        std::string_view stock() const { return readStock(data + 1); }
+    };
+
+    inline void appendEnterOrder(std::vector<uint8_t>& out, uint64_t token, OrderSide side, uint32_t shares,
+                                 std::string_view stock, uint32_t price,
+                                 TimeInForce tif = TimeInForce::GOOD_TILL_CANCELLED) {
+        uint8_t* p = appendFrame(out, EnterOrder::TYPE, EnterOrder::LENGTH);
+        writeU64(p + 1, token);
+        p[9] = static_cast<uint8_t>(side);
+        writeU32(p + 10, shares);
+        writeStock(p + 14, stock);
+        writeU32(p + 22, price);
+        p[26] = static_cast<uint8_t>(tif);
+    }
+
+    inline void appendCancelOrder(std::vector<uint8_t>& out, uint64_t token) {
+        writeU64(appendFrame(out, CancelOrder::TYPE, CancelOrder::LENGTH) + 1, token);
+    }
+
+    inline void appendReplaceOrder(std::vector<uint8_t>& out, uint64_t token, uint32_t shares, uint32_t price) {
+        uint8_t* p = appendFrame(out, ReplaceOrder::TYPE, ReplaceOrder::LENGTH);
+        writeU64(p + 1, token);
+        writeU32(p + 9, shares);
+        writeU32(p + 13, price);
+    }
+
+    inline void appendMassCancel(std::vector<uint8_t>& out, std::string_view stock = {}) {
+        writeStock(appendFrame(out, MassCancel::TYPE, MassCancel::LENGTH) + 1, stock);
+    }
+
+    // Longest client message, a larger frame length means a broken stream
+    constexpr size_t MAX_INBOUND_LENGTH = EnterOrder::LENGTH;
+
+    // ========== Gateway -> Client ==========
+
+    // Fields common to every response: type(1) timestamp(8, ns) token(8)
+    struct ResponseView : MessageView {
+        uint64_t timestamp_ns() const { return readU64(data + 1); }
+        uint64_t token() const { return readU64(data + 9); }
+    };
+
+    // 'A' Accepted; order_reference is the engine's OrderId
+    struct Accepted : ResponseView {
+        static constexpr char TYPE = 'A';
+        static constexpr size_t LENGTH = 42;
+        uint64_t order_reference() const { return readU64(data + 17); }
+        char side() const { return static_cast<char>(data[25]); }
+        uint32_t shares() const { return readU32(data + 26); }
+        std::string_view stock() const { return readStock(data + 30); }
+        uint32_t price() const { return readU32(data + 38); }
+    };
+
+    // 'E' Executed; both sides of a trade carry the same match number
+    struct Executed : ResponseView {
+        static constexpr char TYPE = 'E';
+        static constexpr size_t LENGTH = 33;
+        uint32_t shares() const { return readU32(data + 17); }
+        uint32_t price() const { return readU32(data + 21); }
+        uint64_t match_number() const { return readU64(data + 25); }
+    };
+
+    // 'C' Cancelled; the order is no longer live
+    struct Cancelled : ResponseView {
+        static constexpr char TYPE = 'C';
+        static constexpr size_t LENGTH = 22;
+        uint32_t shares() const { return readU32(data + 17); }     // Quantity taken off
+        CancelReason reason() const { return static_cast<CancelReason>(data[21]); }
+    };
+
+    // 'U' Replaced; shares is the open quantity after the replace
+    struct Replaced : ResponseView {
+        static constexpr char TYPE = 'U';
+        static constexpr size_t LENGTH = 25;
+        uint32_t shares() const { return readU32(data + 17); }
+        uint32_t price() const { return readU32(data + 21); }
+    };
+
+    // 'J' Rejected; token 0 for a Mass Cancel naming an unknown stock
+    struct Rejected : ResponseView {
+        static constexpr char TYPE = 'J';
+        static constexpr size_t LENGTH = 18;
+        RejectReason reason() const { return static_cast<RejectReason>(data[17]); }
+    };
+
+    inline uint8_t* appendResponse(std::vector<uint8_t>& out, char type, size_t length, uint64_t timestamp,
+                                   uint64_t token) {
+        uint8_t* p = appendFrame(out, type, length);
+        writeU64(p + 1, timestamp);
+        writeU64(p + 9, token);
+        return p;
+    }
+
+    inline void appendAccepted(std::vector<uint8_t>& out, uint64_t timestamp, uint64_t token, OrderId reference,
+                               OrderSide side, Quantity shares, std::string_view stock, uint32_t price) {
+        uint8_t* p = appendResponse(out, Accepted::TYPE, Accepted::LENGTH, timestamp, token);
+        writeU64(p + 17, reference);
+        p[25] = static_cast<uint8_t>(side);
+        writeU32(p + 26, clamp32(shares));
+        writeStock(p + 30, stock);
+        writeU32(p + 38, price);
+    }
+
+    inline void appendExecuted(std::vector<uint8_t>& out, uint64_t timestamp, uint64_t token, Quantity shares,
+                               Price price, uint64_t match) {
+        uint8_t* p = appendResponse(out, Executed::TYPE, Executed::LENGTH, timestamp, token);
+        writeU32(p + 17, clamp32(shares));
+        writeU32(p + 21, clamp32(static_cast<uint64_t>(price)));
+        writeU64(p + 25, match);
+    }
+
+    inline void appendCancelled(std::vector<uint8_t>& out, uint64_t timestamp, uint64_t token, Quantity shares,
+                                CancelReason reason) {
+        uint8_t* p = appendResponse(out, Cancelled::TYPE, Cancelled::LENGTH, timestamp, token);
+        writeU32(p + 17, clamp32(shares));
+        p[21] = static_cast<uint8_t>(reason);
+    }
+
+    inline void appendReplaced(std::vector<uint8_t>& out, uint64_t timestamp, uint64_t token, Quantity shares,
+                               Price price) {
+        uint8_t* p = appendResponse(out, Replaced::TYPE, Replaced::LENGTH, timestamp, token);
+        writeU32(p + 17, clamp32(shares));
+        writeU32(p + 21, clamp32(static_cast<uint64_t>(price)));
+    }
+
+    inline void appendRejected(std::vector<uint8_t>& out, uint64_t timestamp, uint64_t token, RejectReason reason) {
+        appendResponse(out, Rejected::TYPE, Rejected::LENGTH, timestamp, token)[17] = static_cast<uint8_t>(reason);
+    }
+
+    // ========== Framing ==========
+
+    /**
+     * @brief Hand every complete frame of `data` to `handler(payload, length)`.
+     * @details Stops before a truncated trailing frame, or at a frame longer than
+     * `max_length` (payload lengths of 0 are reported as such).
+     * @return Bytes consumed; with `broken` set if a frame exceeded max_length.
+     */
+    template<typename Handler> size_t forEachFrame(const uint8_t* data, size_t size, Handler&& handler,
+                                                   size_t max_length, bool& broken) {
+        size_t offset = 0;
+        broken = false;
+        while (size - offset >= FRAME_HEADER) {
+            size_t length = (static_cast<size_t>(data[offset]) << 8) | data[offset + 1];
+            if (length > max_length) {
+                broken = true;
+                break;
+            }
+            if (size - offset - FRAME_HEADER < length) break;
+            handler(data + offset + FRAME_HEADER, length);
+            offset += FRAME_HEADER + length;
+        }
+        return offset;
+    }
+
+} // namespace Ouch
+} // namespace OrderEngine
+
+#endif // OUCH_PROTOCOL_H
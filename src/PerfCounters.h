@@ -0,0 +1,299 @@
+#pragma once
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <utility>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace OrderEngine {
+
+    /**
+     * Hardware performance counters through Linux perf_event_open.
+     *
+     * A PerfCounterGroup counts user-space events of the thread that opened it,
+     * read together in one read() as a perf group so the values are consistent
+     * with each other. Events the CPU, VM or kernel policy does not provide
+     * (perf_event_paranoid, no PMU in the guest) are simply unavailable and
+     * reported as n/a; task-clock is a software event and nearly always works.
+     * A read is a syscall (~0.3-1 us), so sampling every operation is a
+     * diagnostic mode, not something to leave on in production.
+     */
+
+    enum class PerfEvent : size_t {
+        CYCLES,
+        INSTRUCTIONS,
+        L1D_MISSES,         // L1 data cache read misses
+        LLC_MISSES,         // Last-level cache misses
+        BRANCH_MISSES,
+        TASK_CLOCK,         // Nanoseconds on CPU (software)
+        COUNT
+    };
+
+    constexpr size_t PERF_EVENT_COUNT = static_cast<size_t>(PerfEvent::COUNT);
+
+    inline const char* perfEventName(PerfEvent event) {
+        switch (event) {
+            case PerfEvent::CYCLES: return "cycles";
+            case PerfEvent::INSTRUCTIONS: return "instructions";
+            case PerfEvent::L1D_MISSES: return "L1d-misses";
+            case PerfEvent::LLC_MISSES: return "LLC-misses";
+            case PerfEvent::BRANCH_MISSES: return "branch-misses";
+            case PerfEvent::TASK_CLOCK: return "task-clock-ns";
+            default: return "?";
+        }
+    }
+
+    struct PerfSample {
+        uint64_t values[PERF_EVENT_COUNT] = {};
+
+        uint64_t operator[](PerfEvent event) const { return values[static_cast<size_t>(event)]; }
+    };
+
+    class PerfCounterGroup {
+    private:
+        int fds_[PERF_EVENT_COUNT];
+        int slot_[PERF_EVENT_COUNT];    // Position in the group read, -1 if unavailable
+        int leader_ = -1;
+        size_t opened_ = 0;
+        std::string error_;
+
+#if defined(__linux__)
+        static bool describe(PerfEvent event, perf_event_attr& attr) {
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            switch (event) {
+                case PerfEvent::CYCLES: attr.config = PERF_COUNT_HW_CPU_CYCLES; break;
+                case PerfEvent::INSTRUCTIONS: attr.config = PERF_COUNT_HW_INSTRUCTIONS; break;
+                case PerfEvent::L1D_MISSES:
+                    attr.type = PERF_TYPE_HW_CACHE;
+                    attr.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+                    break;
+                case PerfEvent::LLC_MISSES: attr.config = PERF_COUNT_HW_CACHE_MISSES; break;
+                case PerfEvent::BRANCH_MISSES: attr.config = PERF_COUNT_HW_BRANCH_MISSES; break;
+                case PerfEvent::TASK_CLOCK:
+                    attr.type = PERF_TYPE_SOFTWARE;
+                    attr.config = PERF_COUNT_SW_TASK_CLOCK;
+                    break;
+                default: return false;
+            }
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            return true;
+        }
+#endif
+
+    public:
+        // Opens every event for the calling thread; check available() per event
+        PerfCounterGroup() {
+            for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+                fds_[i] = -1;
+                slot_[i] = -1;
+            }
+#if defined(__linux__)
+            for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+                perf_event_attr attr;
+                if (!describe(static_cast<PerfEvent>(i), attr)) continue;
+                int fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, leader_, 0));
+                if (fd < 0) {
+                    if (!error_.empty()) error_ += ", ";
+                    error_ += std::string(perfEventName(static_cast<PerfEvent>(i))) + ": " + std::strerror(errno);
+                    continue;
+                }
+                if (leader_ < 0) leader_ = fd;
+                fds_[i] = fd;
+                slot_[i] = static_cast<int>(opened_++);
+            }
+#else
+            error_ = "perf_event_open is Linux only";
+#endif
+        }
+
+        ~PerfCounterGroup() {
+#if defined(__linux__)
+            for (int fd : fds_) {
+                if (fd >= 0) ::close(fd);
+            }
+#endif
+        }
+
+        PerfCounterGroup(const PerfCounterGroup&) = delete;
+        PerfCounterGroup& operator=(const PerfCounterGroup&) = delete;
+
+        bool available(PerfEvent event) const { return slot_[static_cast<size_t>(event)] >= 0; }
+        bool any_available() const { return opened_ > 0; }
+        // Why events are unavailable, empty if all opened
+        const std::string& error() const { return error_; }
+
+        /**
+         * @brief Current counts since the group was opened (unavailable events read 0).
+         * @details Scaled up by enabled/running time if the kernel multiplexed the group.
+         */
+        bool read(PerfSample& out) const {
+#if defined(__linux__)
+            if (leader_ < 0) return false;
+            uint64_t buffer[3 + PERF_EVENT_COUNT];
+            ssize_t size = ::read(leader_, buffer, sizeof(buffer));
+            if (size < static_cast<ssize_t>(3 * sizeof(uint64_t))) return false;
+            uint64_t enabled = buffer[1], running = buffer[2];
+            double scale = running > 0 && running < enabled ? static_cast<double>(enabled) / static_cast<double>(running) : 1.0;
+            for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+                if (slot_[i] < 0 || static_cast<uint64_t>(slot_[i]) >= buffer[0]) {
+                    out.values[i] = 0;
+                    continue;
+                }
+                uint64_t raw = buffer[3 + slot_[i]];
+                out.values[i] = scale == 1.0 ? raw : static_cast<uint64_t>(static_cast<double>(raw) * scale);
+            }
+            return true;
+#else
+            (void)out;
+            return false;
+#endif
+        }
+
+        // The calling thread's group, opened on first use and kept for the thread's lifetime
+        static PerfCounterGroup& forThisThread() {
+            thread_local PerfCounterGroup group;
+            return group;
+        }
+    };
+
+    /**
+     * @brief Counter deltas summed over a number of operations.
+     * @details Written by whoever holds the owning book's lock (one writer at a time),
+     * read from anywhere; same relaxed load/store scheme as LatencyHistogram.
+     */
+    class PerfTotals {
+    private:
+        std::atomic<uint64_t> operations_{0};
+        std::atomic<uint64_t> sums_[PERF_EVENT_COUNT] = {};
+
+        static void bump(std::atomic<uint64_t>& counter, uint64_t by) {
+            counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+        }
+
+    public:
+        void add(const PerfSample& begin, const PerfSample& end) {
+            bump(operations_, 1);
+            for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+                if (end.values[i] > begin.values[i]) bump(sums_[i], end.values[i] - begin.values[i]);
+            }
+        }
+
+        void merge(const PerfTotals& other) {
+            bump(operations_, other.operations());
+            for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) bump(sums_[i], other.sums_[i].load(std::memory_order_relaxed));
+        }
+
+        void reset() {
+            operations_.store(0, std::memory_order_relaxed);
+            for (auto& sum : sums_) sum.store(0, std::memory_order_relaxed);
+        }
+
+        uint64_t operations() const { return operations_.load(std::memory_order_relaxed); }
+        uint64_t total(PerfEvent event) const { return sums_[static_cast<size_t>(event)].load(std::memory_order_relaxed); }
+        double per_operation(PerfEvent event) const {
+            return operations() ? static_cast<double>(total(event)) / static_cast<double>(operations()) : 0.0;
+        }
+    };
+
+    /**
+     * @brief Samples the calling thread's counters around one scope into a PerfTotals.
+     * @details A null target costs one branch.
+     */
+    class ScopedPerfSample {
+    private:
+        PerfTotals* totals_;
+        PerfCounterGroup* group_ = nullptr;
+        PerfSample begin_;
+
+    public:
+        explicit ScopedPerfSample(PerfTotals* totals) : totals_(totals) {
+            if (!totals_) return;
+            group_ = &PerfCounterGroup::forThisThread();
+            if (!group_->read(begin_)) totals_ = nullptr;
+        }
+
+        ~ScopedPerfSample() {
+            PerfSample end;
+            if (totals_ && group_->read(end)) totals_->add(begin_, end);
+        }
+
+        ScopedPerfSample(const ScopedPerfSample&) = delete;
+        ScopedPerfSample& operator=(const ScopedPerfSample&) = delete;
+    };
+
+    /**
+     * @brief Per-operation counter totals of one OrderBook; the same split as OrderBookLatency.
+     * @details Deltas are of the thread running each operation, so books driven
+     * from several threads are attributed correctly. Nested scopes overlap:
+     * add includes its match and notify.
+     */
+    struct OrderBookPerf {
+        PerfTotals add;
+        PerfTotals cancel;
+        PerfTotals replace;
+        PerfTotals match;
+        PerfTotals notify;
+
+        void merge(const OrderBookPerf& other) {
+            add.merge(other.add);
+            cancel.merge(other.cancel);
+            replace.merge(other.replace);
+            match.merge(other.match);
+            notify.merge(other.notify);
+        }
+
+        void reset() {
+            add.reset();
+            cancel.reset();
+            replace.reset();
+            match.reset();
+            notify.reset();
+        }
+
+        // Per-operation averages, one line per operation; unavailable counters print n/a
+        void dump(std::ostream& out) const {
+            const PerfCounterGroup& group = PerfCounterGroup::forThisThread();
+            const std::pair<const char*, const PerfTotals*> rows[] = {
+                {"add", &add}, {"cancel", &cancel}, {"replace", &replace}, {"match", &match}, {"notify", &notify}};
+            char cell[32];
+            out << "op       " << "         ops";
+            for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+                std::snprintf(cell, sizeof(cell), " %14s", perfEventName(static_cast<PerfEvent>(i)));
+                out << cell;
+            }
+            out << "   (per op)\n";
+            for (const auto& row : rows) {
+                std::snprintf(cell, sizeof(cell), "%-8s %12llu", row.first,
+                              static_cast<unsigned long long>(row.second->operations()));
+                out << cell;
+                for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+                    auto event = static_cast<PerfEvent>(i);
+                    if (group.available(event)) std::snprintf(cell, sizeof(cell), " %14.1f", row.second->per_operation(event));
+                    else std::snprintf(cell, sizeof(cell), " %14s", "n/a");
+                    out << cell;
+                }
+                out << "\n";
+            }
+        }
+    };
+
+} // namespace OrderEngine
+
+#endif // PERF_COUNTERS_H
@@ -0,0 +1,70 @@
+#pragma once
+#ifndef SHARD_PLAN_H
+#define SHARD_PLAN_H
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+namespace OrderEngine {
+
+    /**
+     * @brief Assignment of order books to matcher threads (shards).
+     * @details
+     * A book is only ever touched by its owning thread, so books are the unit of
+     * parallelism and a single hot symbol bounds the achievable speedup: with
+     * Zipf(1.0) activity over 64 symbols the busiest one carries ~21% of the flow,
+     * so no plan does better than ~4.7x however many threads there are.
+     * Books are placed heaviest first on the least loaded shard (LPT), which is
+     * within 4/3 of the best possible makespan.
+     *
+     * WEIGHTS : [ 40 ][ 20 ][ 13 ][ 10 ][ 8 ]      2 SHARDS
+     * SHARD 0 : 40 + 8          = 48
+     * SHARD 1 : 20 + 13 + 10    = 43
+     */
+    class ShardPlan {
+    private:
+        std::vector<size_t> owner_;                 // Shard of every book
+        std::vector<std::vector<size_t>> books_;    // Books of every shard, heaviest first
+        std::vector<double> load_;                  // Summed weight of every shard
+
+    public:
+        /**
+         * @param weights Expected activity per book (any unit, e.g. event counts).
+         * @param shards Number of matcher threads, at least 1.
+         */
+        ShardPlan(const std::vector<double>& weights, size_t shards) {
+            shards = std::max<size_t>(shards, 1);
+            owner_.assign(weights.size(), 0);
+            books_.assign(shards, {});
+            load_.assign(shards, 0.0);
+
+            std::vector<size_t> order(weights.size());
+            std::iota(order.begin(), order.end(), size_t{0});
+            std::stable_sort(order.begin(), order.end(),
+                             [&](size_t a, size_t b) { return weights[a] > weights[b]; });
+            for (size_t book : order) {
+                size_t target = static_cast<size_t>(std::min_element(load_.begin(), load_.end()) - load_.begin());
+                owner_[book] = target;
+                books_[target].push_back(book);
+                load_[target] += weights[book];
+            }
+        }
+
+        size_t shards() const { return books_.size(); }
+        size_t owner(size_t book) const { return owner_[book]; }
+        const std::vector<size_t>& books(size_t shard) const { return books_[shard]; }
+        double load(size_t shard) const { return load_[shard]; }
+
+        // Best speedup this plan allows over one thread: total load / busiest shard
+        double max_speedup() const {
+            double total = std::accumulate(load_.begin(), load_.end(), 0.0);
+            double busiest = *std::max_element(load_.begin(), load_.end());
+            return busiest > 0.0 ? total / busiest : 1.0;
+        }
+    };
+
+} // namespace OrderEngine
+
+#endif // SHARD_PLAN_H
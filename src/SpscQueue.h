@@ -0,0 +1,85 @@
+#pragma once
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace OrderEngine {
+
+    /**
+     * @brief Bounded wait-free queue for exactly one producer and one consumer thread.
+     * @details
+     * Capacity is rounded up to a power of two. Head and tail live on their own
+     * cache lines, and each side keeps a private copy of the other side's index,
+     * so the shared line is only re-read when the cached copy says full / empty.
+     * A push or pop is then one relaxed load, one store-release and no locked
+     * instruction.
+     *
+     * SLOTS : [   ][ a ][ b ][ c ][   ][   ]
+     *               ^head           ^tail      (consumer pops at head, producer pushes at tail)
+     */
+    template<typename T> class SpscQueue {
+    private:
+        static constexpr size_t CACHE_LINE = 64;
+
+        std::vector<T> slots_;
+        size_t mask_;
+
+        alignas(CACHE_LINE) std::atomic<size_t> head_{0};   // Next slot to pop, written by the consumer
+        size_t cached_tail_ = 0;                            // Consumer's view of tail_
+
+        alignas(CACHE_LINE) std::atomic<size_t> tail_{0};   // Next slot to push, written by the producer
+        size_t cached_head_ = 0;                            // Producer's view of head_
+
+        static size_t roundUp(size_t capacity) {
+            size_t size = 2;
+            while (size < capacity) size *= 2;
+            return size;
+        }
+
+    public:
+        explicit SpscQueue(size_t capacity) : slots_(roundUp(capacity)), mask_(slots_.size() - 1) {}
+
+        SpscQueue(const SpscQueue&) = delete;
+        SpscQueue& operator=(const SpscQueue&) = delete;
+
+        size_t capacity() const { return slots_.size(); }
+        size_t memory_bytes() const { return slots_.capacity() * sizeof(T); }
+
+        // Producer only; false if the queue is full
+        bool try_push(const T& value) {
+            size_t tail = tail_.load(std::memory_order_relaxed);
+            if (tail - cached_head_ == slots_.size()) {
+                cached_head_ = head_.load(std::memory_order_acquire);
+                if (tail - cached_head_ == slots_.size()) return false;
+            }
+            slots_[tail & mask_] = value;
+            tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer only; false if the queue is empty
+        bool try_pop(T& value) {
+            size_t head = head_.load(std::memory_order_relaxed);
+            if (head == cached_tail_) {
+                cached_tail_ = tail_.load(std::memory_order_acquire);
+                if (head == cached_tail_) return false;
+            }
+            value = slots_[head & mask_];
+            head_.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Approximate from any thread, exact from either end while the other is idle
+        size_t size() const {
+            return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+        }
+
+        bool empty() const { return size() == 0; }
+    };
+
+} // namespace OrderEngine
+
+#endif // SPSC_QUEUE_H
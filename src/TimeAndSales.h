@@ -0,0 +1,160 @@
+#pragma once
+#ifndef TIME_AND_SALES_H
+#define TIME_AND_SALES_H
+
+#include "OrderTypes.h"
+#include <atomic>
+#include <memory>
+
+namespace OrderEngine {
+
+    /**
+     * @brief Compact record of one executed trade.
+     */
+    struct TradeRecord {
+        uint64_t sequence = 0;          // 1-based trade number within the book
+        int64_t timestamp_ns = 0;       // Execution time, nanoseconds since epoch
+        Price price = 0;
+        Quantity quantity = 0;
+        OrderId inbound_order_id = 0;   // Aggressor
+        OrderId resting_order_id = 0;   // Passive side
+        OrderSide aggressor_side = OrderSide::BUY;
+    };
+
+    /**
+     * @brief Fixed-capacity time-and-sales ring with wait-free readers.
+     * @details
+     * The matcher (single writer) appends every trade; any number of reader threads
+     * can fetch the most recent trades without locks and without ever delaying the
+     * writer. Each slot is guarded by its own seqlock word:
+     * - writer: version = odd (writing), store fields, version = 2 * sequence
+     * - reader: read version, copy fields, re-read version; a slot that changed or
+     *   that no longer holds the wanted sequence is skipped, never retried.
+     * Fields are stored as relaxed atomics so concurrent access is well defined.
+     * When the ring wraps, the oldest trades are overwritten.
+     */
+    class TimeAndSales {
+    public:
+        static constexpr size_t DEFAULT_CAPACITY = 1024;
+
+    private:
+        static constexpr size_t FIELD_COUNT = 6;
+
+        struct Slot {
+            std::atomic<uint64_t> version{0};
+            std::atomic<uint64_t> fields[FIELD_COUNT];
+        };
+
+        size_t capacity_;                   // Power of two
+        size_t mask_;
+        std::unique_ptr<Slot[]> slots_;
+        std::atomic<uint64_t> last_sequence_; // Sequence of the newest published trade
+
+        static size_t round_up_pow2(size_t value) {
+            size_t result = 1;
+            while (result < value) result <<= 1;
+            return result;
+        }
+
+        // Copy slot for `sequence` into `out`; false if torn, in progress or overwritten
+        bool read_slot(uint64_t sequence, TradeRecord& out) const {
+            const Slot& slot = slots_[sequence & mask_];
+            uint64_t expected = sequence << 1;
+            if (slot.version.load(std::memory_order_acquire) != expected) return false;
+
+            uint64_t fields[FIELD_COUNT];
+            for (size_t i = 0; i < FIELD_COUNT; ++i) {
+                fields[i] = slot.fields[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.version.load(std::memory_order_relaxed) != expected) return false;
+
+            out.sequence = sequence;
+            out.timestamp_ns = static_cast<int64_t>(fields[0]);
+            out.price = static_cast<Price>(fields[1]);
+            out.quantity = fields[2];
+            out.inbound_order_id = fields[3];
+            out.resting_order_id = fields[4];
+            out.aggressor_side = static_cast<OrderSide>(static_cast<char>(fields[5]));
+            return true;
+        }
+
+    public:
+        explicit TimeAndSales(size_t capacity = DEFAULT_CAPACITY)
+            : capacity_(round_up_pow2(capacity > 0 ? capacity : 1)), mask_(capacity_ - 1),
+              slots_(new Slot[capacity_]), last_sequence_(0) {
+            for (size_t i = 0; i < capacity_; ++i) {
+                for (auto& field : slots_[i].fields) field.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        size_t capacity() const { return capacity_; }
+
+        // Heap bytes of the ring, fixed at construction
+        size_t memory_bytes() const { return capacity_ * sizeof(Slot); }
+
+        // Total number of trades appended so far
+        uint64_t last_sequence() const { return last_sequence_.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Append a trade (writer thread only). O(1), never blocks.
+         * @return The sequence number assigned to the trade.
+         */
+        uint64_t append(int64_t timestamp_ns, Price price, Quantity quantity,
+                        OrderId inbound_order_id, OrderId resting_order_id, OrderSide aggressor_side) {
+            uint64_t sequence = last_sequence_.load(std::memory_order_relaxed) + 1;
+            Slot& slot = slots_[sequence & mask_];
+
+            slot.version.store((sequence << 1) | 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.fields[0].store(static_cast<uint64_t>(timestamp_ns), std::memory_order_relaxed);
+            slot.fields[1].store(static_cast<uint64_t>(price), std::memory_order_relaxed);
+            slot.fields[2].store(quantity, std::memory_order_relaxed);
+            slot.fields[3].store(inbound_order_id, std::memory_order_relaxed);
+            slot.fields[4].store(resting_order_id, std::memory_order_relaxed);
+            slot.fields[5].store(static_cast<uint64_t>(aggressor_side), std::memory_order_relaxed);
+            slot.version.store(sequence << 1, std::memory_order_release);
+
+            last_sequence_.store(sequence, std::memory_order_release);
+            return sequence;
+        }
+
+        /**
+         * @brief Copy up to `count` most recent trades into `out`, oldest first. Wait-free.
+         * @return Number of records written; may be less than requested if the ring holds
+         *         fewer trades or slots were overwritten while reading.
+         */
+        size_t last(size_t count, TradeRecord* out) const {
+            uint64_t newest = last_sequence();
+            uint64_t available = newest < capacity_ ? newest : capacity_;
+            uint64_t first = newest - (count < available ? count : available) + 1;
+            return read_range(first, newest, out);
+        }
+
+        /**
+         * @brief Copy trades with sequence > `after_sequence` (oldest first), at most `max_count`.
+         * @details For incremental polling: pass the sequence of the last record already seen.
+         * Trades that were overwritten before being read are silently skipped.
+         */
+        size_t since(uint64_t after_sequence, TradeRecord* out, size_t max_count) const {
+            uint64_t newest = last_sequence();
+            if (newest <= after_sequence || max_count == 0) return 0;
+            uint64_t oldest_kept = newest >= capacity_ ? newest - capacity_ + 1 : 1;
+            uint64_t first = after_sequence + 1 > oldest_kept ? after_sequence + 1 : oldest_kept;
+            uint64_t last = first + max_count - 1 < newest ? first + max_count - 1 : newest;
+            return read_range(first, last, out);
+        }
+
+    private:
+        size_t read_range(uint64_t first, uint64_t last, TradeRecord* out) const {
+            size_t written = 0;
+            for (uint64_t sequence = first; sequence >= 1 && sequence <= last; ++sequence) {
+                if (read_slot(sequence, out[written])) ++written;
+            }
+            return written;
+        }
+    };
+
+} // namespace OrderEngine
+
+#endif // TIME_AND_SALES_H
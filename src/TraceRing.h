@@ -0,0 +1,372 @@
+#pragma once
+#ifndef TRACE_RING_H
+#define TRACE_RING_H
+
+#include "Tsc.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace OrderEngine {
+namespace Trace {
+
+    /**
+     * Hot-path event tracing for post-mortem analysis of latency spikes.
+     *
+     * Every thread that emits events gets its own fixed-size ring of 24-byte
+     * binary records (TSC, an id, event, phase, a 48-bit argument). Recording is
+     * three relaxed stores and a release store of the ring head: no lock, no
+     * allocation, no syscall, overwriting the oldest records when full. With
+     * tracing disabled a trace point costs one relaxed load and a branch.
+     *
+     * Rings outlive their threads and are reachable from a fixed registry, so the
+     * whole process state can be written out from a signal handler (dumpOnSignal)
+     * or when an operation exceeds a latency threshold (dumpWhenSlower). The dump
+     * is a compact binary file; tools/trace2chrome converts it to Chrome trace JSON.
+     */
+
+    enum class Event : uint8_t {
+        NONE = 0,               // Overwritten while being dumped, skipped by readers
+        ADD_ORDER = 1,
+        CANCEL_ORDER = 2,
+        REPLACE_ORDER = 3,
+        MASS_QUOTE = 4,
+        MATCH_BUY = 5,          // Inbound buy matched against the asks
+        MATCH_SELL = 6,
+        EXECUTE_TRADE = 7,
+        LISTENER_DISPATCH = 8,
+        USER = 64               // First id free for application events
+    };
+
+    enum class Phase : uint8_t { BEGIN = 'B', END = 'E', INSTANT = 'i' };
+
+    inline const char* eventName(Event event) {
+        switch (event) {
+            case Event::ADD_ORDER: return "addOrder";
+            case Event::CANCEL_ORDER: return "cancelOrder";
+            case Event::REPLACE_ORDER: return "replaceOrder";
+            case Event::MASS_QUOTE: return "massQuote";
+            case Event::MATCH_BUY: return "matchBuyOrder";
+            case Event::MATCH_SELL: return "matchSellOrder";
+            case Event::EXECUTE_TRADE: return "executeTrade";
+            case Event::LISTENER_DISPATCH: return "listenerDispatch";
+            default: return "event";
+        }
+    }
+
+    struct Record {
+        uint64_t tsc = 0;
+        uint64_t id = 0;        // Order id for book events
+        uint64_t packed = 0;    // event(8) | phase(8) | argument(48)
+
+        Event event() const { return static_cast<Event>(packed >> 56); }
+        Phase phase() const { return static_cast<Phase>((packed >> 48) & 0xFF); }
+        uint64_t argument() const { return packed & ((uint64_t{1} << 48) - 1); }
+
+        static uint64_t pack(Event event, Phase phase, uint64_t argument) {
+            return (static_cast<uint64_t>(event) << 56) | (static_cast<uint64_t>(phase) << 48) |
+                   (argument & ((uint64_t{1} << 48) - 1));
+        }
+    };
+
+    /**
+     * @brief Single-writer ring of trace records; readable from any thread or a signal handler.
+     */
+    class Ring {
+    private:
+        struct Slot {
+            std::atomic<uint64_t> words[3];
+        };
+
+        uint32_t thread_index_;
+        size_t mask_;
+        std::unique_ptr<Slot[]> slots_;
+        std::atomic<uint64_t> head_{0};  // Records ever written
+
+    public:
+        // `capacity` is rounded up to a power of two
+        Ring(uint32_t thread_index, size_t capacity) : thread_index_(thread_index) {
+            size_t rounded = 1;
+            while (rounded < capacity) rounded <<= 1;
+            mask_ = rounded - 1;
+            slots_.reset(new Slot[rounded]);
+            for (size_t i = 0; i < rounded; ++i) {
+                for (auto& word : slots_[i].words) word.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        void record(Event event, Phase phase, uint64_t id, uint64_t argument) {
+            uint64_t head = head_.load(std::memory_order_relaxed);
+            Slot& slot = slots_[head & mask_];
+            slot.words[0].store(Tsc::now(), std::memory_order_relaxed);
+            slot.words[1].store(id, std::memory_order_relaxed);
+            slot.words[2].store(Record::pack(event, phase, argument), std::memory_order_relaxed);
+            head_.store(head + 1, std::memory_order_release);
+        }
+
+        uint32_t thread_index() const { return thread_index_; }
+        size_t capacity() const { return mask_ + 1; }
+        uint64_t written() const { return head_.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Oldest absolute index still intact when `head` records have been written.
+         * @details While record `head` is being stored the writer is overwriting the slot of
+         * `head - capacity`, so that one already counts as lost: a full ring yields capacity - 1.
+         */
+        uint64_t oldest_intact(uint64_t head) const {
+            return head >= capacity() ? head - capacity() + 1 : 0;
+        }
+
+        /**
+         * @brief Copy records [first, first + count) (absolute indexes) into `out`.
+         * @details Records the writer may have overwritten during the copy come back
+         * as Event::NONE. Async-signal-safe.
+         */
+        void copy(uint64_t first, size_t count, Record* out) const {
+            for (size_t i = 0; i < count; ++i) {
+                const Slot& slot = slots_[(first + i) & mask_];
+                out[i].tsc = slot.words[0].load(std::memory_order_relaxed);
+                out[i].id = slot.words[1].load(std::memory_order_relaxed);
+                out[i].packed = slot.words[2].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            uint64_t oldest = oldest_intact(written());
+            for (size_t i = 0; i < count && first + i < oldest; ++i) out[i].packed = 0;
+        }
+    };
+
+    // ========== Process-wide State ==========
+
+    constexpr size_t MAX_THREADS = 256;
+    constexpr size_t DEFAULT_RING_CAPACITY = size_t{1} << 16;
+
+    struct State {
+        std::atomic<bool> enabled{false};
+        std::atomic<size_t> ring_capacity{DEFAULT_RING_CAPACITY};
+        std::atomic<Ring*> rings[MAX_THREADS] = {};
+        std::atomic<uint32_t> ring_count{0};
+        double ticks_per_ns = 1.0;              // Cached by enable(), read by the dump
+
+        // Threshold dump (dumpWhenSlower)
+        std::atomic<uint64_t> threshold_ticks{0};   // 0 = disarmed
+        std::atomic<uint64_t> breach_dumps{0};
+        char threshold_path[256] = {};
+
+        // Signal dump (dumpOnSignal)
+        char signal_path[256] = {};
+    };
+
+    inline State& state() {
+        static State instance;
+        return instance;
+    }
+
+    inline bool enabled() { return state().enabled.load(std::memory_order_relaxed); }
+
+    // Start recording; calibrates the TSC first so dumps never have to
+    inline void enable() {
+        state().ticks_per_ns = Tsc::ticks_per_ns();
+        state().enabled.store(true, std::memory_order_relaxed);
+    }
+
+    inline void disable() { state().enabled.store(false, std::memory_order_relaxed); }
+
+    // Records per thread ring, for rings created after the call
+    inline void setRingCapacity(size_t records) { state().ring_capacity.store(records, std::memory_order_relaxed); }
+
+    /**
+     * @brief This thread's ring, created and registered on first use.
+     * @details Rings are never freed so a dump can still read threads that exited.
+     * Threads beyond MAX_THREADS get a ring that is recorded but never dumped.
+     */
+    inline Ring& threadRing() {
+        thread_local Ring* ring = [] {
+            State& s = state();
+            uint32_t index = s.ring_count.fetch_add(1, std::memory_order_relaxed);
+            auto* created = new Ring(index, s.ring_capacity.load(std::memory_order_relaxed));
+            if (index < MAX_THREADS) s.rings[index].store(created, std::memory_order_release);
+            return created;
+        }();
+        return *ring;
+    }
+
+    inline void record(Event event, Phase phase, uint64_t id = 0, uint64_t argument = 0) {
+        if (enabled()) threadRing().record(event, phase, id, argument);
+    }
+
+    // ========== Dump File ==========
+
+    /*
+     * Layout (host byte order):
+     *   header : char magic[8] = "OETRACE1", uint32 version, uint32 ring count, double ticks_per_ns
+     *   ring   : uint32 thread index, uint32 reserved, uint64 record count, then the records
+     *            (tsc, id, packed as three uint64), oldest first
+     */
+    constexpr char DUMP_MAGIC[8] = {'O', 'E', 'T', 'R', 'A', 'C', 'E', '1'};
+    constexpr uint32_t DUMP_VERSION = 1;
+
+    inline bool writeAll(int fd, const void* data, size_t size) {
+        const char* p = static_cast<const char*>(data);
+        while (size > 0) {
+            ssize_t n = ::write(fd, p, size);
+            if (n <= 0) return false;
+            p += n;
+            size -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Write every registered ring to `fd`. Async-signal-safe (no allocation, no locks).
+     */
+    inline bool dumpToFd(int fd) {
+        State& s = state();
+        uint32_t rings = static_cast<uint32_t>(std::min<size_t>(s.ring_count.load(std::memory_order_acquire), MAX_THREADS));
+        bool ok = writeAll(fd, DUMP_MAGIC, sizeof(DUMP_MAGIC)) && writeAll(fd, &DUMP_VERSION, sizeof(DUMP_VERSION)) &&
+                  writeAll(fd, &rings, sizeof(rings)) && writeAll(fd, &s.ticks_per_ns, sizeof(s.ticks_per_ns));
+        Record chunk[256];
+        for (uint32_t i = 0; i < rings && ok; ++i) {
+            const Ring* ring = s.rings[i].load(std::memory_order_acquire);
+            uint32_t header[2] = {i, 0};
+            uint64_t written = ring ? ring->written() : 0;
+            // A dump taken on the writer's own thread may interrupt record() mid-write
+            uint64_t first = ring ? ring->oldest_intact(written) : 0;
+            uint64_t count = written - first;
+            ok = writeAll(fd, header, sizeof(header)) && writeAll(fd, &count, sizeof(count));
+            for (uint64_t done = 0; done < count && ok; ) {
+                size_t n = static_cast<size_t>(std::min<uint64_t>(count - done, sizeof(chunk) / sizeof(chunk[0])));
+                ring->copy(first + done, n, chunk);
+                ok = writeAll(fd, chunk, n * sizeof(Record));
+                done += n;
+            }
+        }
+        return ok;
+    }
+
+    inline bool dump(const char* path) {
+        int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) return false;
+        bool ok = dumpToFd(fd);
+        ::close(fd);
+        return ok;
+    }
+
+    /**
+     * @brief Dump all rings to `path` whenever `signo` (e.g. SIGUSR1) is delivered.
+     */
+    inline bool dumpOnSignal(int signo, const char* path) {
+        std::snprintf(state().signal_path, sizeof(state().signal_path), "%s", path);
+        struct sigaction action;
+        std::memset(&action, 0, sizeof(action));
+        action.sa_handler = [](int) {
+            int saved = errno;
+            dump(state().signal_path);
+            errno = saved;
+        };
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_RESTART;
+        return ::sigaction(signo, &action, nullptr) == 0;
+    }
+
+    /**
+     * @brief Dump once to `path` when a traced scope takes longer than `ns`.
+     * @details The dump runs synchronously on the thread that breached, after the
+     * scope's END record, then disarms; call again to re-arm. Pass 0 to disarm.
+     */
+    inline void dumpWhenSlower(uint64_t ns, const char* path) {
+        State& s = state();
+        std::snprintf(s.threshold_path, sizeof(s.threshold_path), "%s", path ? path : "");
+        s.threshold_ticks.store(static_cast<uint64_t>(static_cast<double>(ns) * Tsc::ticks_per_ns()),
+                                std::memory_order_release);
+    }
+
+    inline uint64_t breachDumps() { return state().breach_dumps.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief BEGIN on construction, END on destruction; checks the dump threshold.
+     */
+    class Scope {
+    private:
+        Ring* ring_;
+        Event event_;
+        uint64_t id_;
+        uint64_t start_ = 0;
+
+    public:
+        Scope(Event event, uint64_t id, uint64_t argument = 0)
+            : ring_(enabled() ? &threadRing() : nullptr), event_(event), id_(id) {
+            if (!ring_) return;
+            ring_->record(event, Phase::BEGIN, id, argument);
+            start_ = Tsc::now();
+        }
+
+        ~Scope() {
+            if (!ring_) return;
+            ring_->record(event_, Phase::END, id_, 0);
+            State& s = state();
+            uint64_t threshold = s.threshold_ticks.load(std::memory_order_relaxed);
+            if (threshold && Tsc::now() - start_ > threshold &&
+                s.threshold_ticks.compare_exchange_strong(threshold, 0, std::memory_order_acq_rel)) {
+                dump(s.threshold_path);
+                s.breach_dumps.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    // ========== Reading Dumps ==========
+
+    struct ThreadTrace {
+        uint32_t thread_index = 0;
+        std::vector<Record> records;    // Oldest first, NONE records removed
+    };
+
+    struct DumpFile {
+        double ticks_per_ns = 1.0;
+        std::vector<ThreadTrace> threads;
+    };
+
+    // Parse a dump written by dump()/dumpToFd(); false on a bad or truncated file
+    inline bool readDump(const std::string& path, DumpFile& out) {
+        FILE* file = std::fopen(path.c_str(), "rb");
+        if (!file) return false;
+        auto read = [&](void* data, size_t size) { return std::fread(data, 1, size, file) == size; };
+
+        char magic[8];
+        uint32_t version = 0, rings = 0;
+        bool ok = read(magic, sizeof(magic)) && std::memcmp(magic, DUMP_MAGIC, sizeof(magic)) == 0 &&
+                  read(&version, sizeof(version)) && version == DUMP_VERSION &&
+                  read(&rings, sizeof(rings)) && read(&out.ticks_per_ns, sizeof(out.ticks_per_ns));
+        for (uint32_t i = 0; i < rings && ok; ++i) {
+            uint32_t header[2];
+            uint64_t count = 0;
+            ok = read(header, sizeof(header)) && read(&count, sizeof(count));
+            if (!ok) break;
+            ThreadTrace thread;
+            thread.thread_index = header[0];
+            thread.records.resize(static_cast<size_t>(count));
+            ok = count == 0 || read(thread.records.data(), thread.records.size() * sizeof(Record));
+            thread.records.erase(std::remove_if(thread.records.begin(), thread.records.end(),
+                                                [](const Record& r) { return r.event() == Event::NONE; }),
+                                 thread.records.end());
+            out.threads.push_back(std::move(thread));
+        }
+        std::fclose(file);
+        return ok;
+    }
+
+} // namespace Trace
+} // namespace OrderEngine
+
+#endif // TRACE_RING_H
@@ -0,0 +1,109 @@
+#include "../src/DepthTracker.h"
+#include <gtest/gtest.h>
+
+using namespace OrderEngine;
+using OrderPtr = std::shared_ptr<Order>;
+
+namespace {
+    OrderPtr makeOrder(OrderId id, OrderSide side, Quantity qty, Price price) {
+        return std::make_shared<Order>(id, "TCS", side, qty, price);
+    }
+}
+
+TEST(GroupedDepthTest, BidsRoundDownAsksRoundUp) {
+    GroupedDepth<5> grouped(50);
+    EXPECT_EQ(grouped.bucket_price(true, 15049), 15000);
+    EXPECT_EQ(grouped.bucket_price(true, 15050), 15050);
+    EXPECT_EQ(grouped.bucket_price(false, 15001), 15050);
+    EXPECT_EQ(grouped.bucket_price(false, 15050), 15050);
+}
+
+TEST(GroupedDepthTest, TracksLevelDeltasIncrementally) {
+    OrderTracker<OrderPtr> bids(true);
+    OrderTracker<OrderPtr> asks(false);
+    DepthTracker<5> depth;
+    size_t idx = depth.add_grouping(50);
+    bids.add_level_listener(&depth);
+    asks.add_level_listener(&depth);
+
+    auto b1 = makeOrder(1, OrderSide::BUY, 300, 15040);
+    auto b2 = makeOrder(2, OrderSide::BUY, 200, 15010);
+    auto b3 = makeOrder(3, OrderSide::BUY, 100, 14990);
+    auto a1 = makeOrder(4, OrderSide::SELL, 400, 15060);
+    bids.addOrder(b1);
+    bids.addOrder(b2);
+    bids.addOrder(b3);
+    asks.addOrder(a1);
+
+    const auto& grouped = depth.grouping(idx);
+    ASSERT_EQ(grouped.bid_count(), 2u);
+    EXPECT_EQ(grouped.bid_levels()[0], DepthLevel(15000, 500, 2));
+    EXPECT_EQ(grouped.bid_levels()[1], DepthLevel(14950, 100, 1));
+    ASSERT_EQ(grouped.ask_count(), 1u);
+    EXPECT_EQ(grouped.ask_levels()[0], DepthLevel(15100, 400, 1));
+
+    bids.update_order_quantity(b1, 50);
+    EXPECT_EQ(grouped.bid_levels()[0], DepthLevel(15000, 250, 2));
+
+    bids.remove_order(b1);
+    bids.remove_order(b2);
+    ASSERT_EQ(grouped.bid_count(), 1u);
+    EXPECT_EQ(grouped.bid_levels()[0], DepthLevel(14950, 100, 1));
+    EXPECT_EQ(grouped.bid_bucket_count(), 1u);
+}
+
+TEST(GroupedDepthTest, RebuildSeedsFromExistingBook) {
+    OrderTracker<OrderPtr> bids(true);
+    OrderTracker<OrderPtr> asks(false);
+    for (OrderId id = 1; id <= 10; ++id) {
+        bids.addOrder(makeOrder(id, OrderSide::BUY, 10, 10000 - static_cast<Price>(id) * 5));
+    }
+
+    DepthTracker<3> depth;
+    size_t idx = depth.add_grouping(20);
+    depth.rebuild_groupings(bids, asks);
+
+    // Levels 9995..9950 -> buckets 9980, 9960, 9940 (top 3 of 3 buckets)
+    const auto& grouped = depth.grouping(idx);
+    ASSERT_EQ(grouped.bid_count(), 3u);
+    EXPECT_EQ(grouped.bid_levels()[0], DepthLevel(9980, 40, 4));
+    EXPECT_EQ(grouped.bid_levels()[1], DepthLevel(9960, 40, 4));
+    EXPECT_EQ(grouped.bid_levels()[2], DepthLevel(9940, 20, 2));
+}
+
+TEST(GroupedDepthTest, ClearKeepsGroupingsInStepWithTrackers) {
+    OrderTracker<OrderPtr> bids(true);
+    OrderTracker<OrderPtr> asks(false);
+    DepthTracker<5> depth;
+    size_t idx = depth.add_grouping(50);
+    bids.add_level_listener(&depth);
+
+    auto order = makeOrder(1, OrderSide::BUY, 100, 15010);
+    bids.addOrder(order);
+    depth.update_from_tracker(bids, asks);
+    depth.clear();
+    EXPECT_EQ(depth.bid_count(), 0u);
+
+    // The level still rests, so its deltas must keep applying to the grouped bucket
+    const auto& grouped = depth.grouping(idx);
+    bids.update_order_quantity(order, 40);
+    ASSERT_EQ(grouped.bid_count(), 1u);
+    EXPECT_EQ(grouped.bid_levels()[0], DepthLevel(15000, 40, 1));
+    bids.remove_order(order);
+    EXPECT_EQ(grouped.bid_count(), 0u);
+    EXPECT_EQ(grouped.bid_bucket_count(), 0u);
+}
+
+TEST(DepthFormatTest, LevelToStringUsesFixedPointPrice) {
+    EXPECT_EQ(DepthLevel(15025, 300, 2).ToString(), "$150.25 | 300 shares | 2 orders");
+    EXPECT_EQ(DepthLevel(5, 1, 1).ToString(), "$0.05 | 1 shares | 1 orders");
+
+    FormatBuffer out;
+    out.append_price(-105).append(' ').append_price_padded(100, 8);
+    EXPECT_EQ(out.view(), "-1.05     1.00");
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,163 @@
+#include "../src/FixParser.h"
+#include <gtest/gtest.h>
+
+using namespace OrderEngine;
+using namespace OrderEngine::Fix;
+
+namespace {
+    template<typename Scanner = DelimiterScanner>
+    ParseStatus parseText(const std::string& text, OrderMessage& message) {
+        size_t consumed = 0;
+        return parse<Scanner>(text.data(), text.size(), message, consumed);
+    }
+
+    std::string withSoh(std::string text) {
+        for (auto& c : text) if (c == '|') c = SOH;
+        return text;
+    }
+
+    // Reframes `body` (fields after 9=, '|' for SOH) with a correct BodyLength and CheckSum
+    std::string frame(const std::string& body) {
+        std::string content = withSoh(body);
+        std::string out = std::string(BEGIN_STRING) + "9=" + std::to_string(content.size()) + SOH + content;
+        char trailer[8];
+        std::snprintf(trailer, sizeof(trailer), "10=%03u", ScalarDelimiterScanner::checksum(out.data(), out.size()));
+        return out + trailer + SOH;
+    }
+}
+
+TEST(FixParserTest, NewOrderSingleParsesInPlace) {
+    std::string text = newOrderSingle(7, 1001, "INFY", OrderSide::SELL, 250, 150125, OrderType::LIMIT, "3");
+    OrderMessage message;
+    size_t consumed = 0;
+    ASSERT_EQ(parse(text.data(), text.size(), message, consumed), ParseStatus::OK);
+    EXPECT_EQ(consumed, text.size());
+    EXPECT_EQ(message.type, MsgType::NEW_ORDER_SINGLE);
+    EXPECT_EQ(message.sender, "CLIENT");
+    EXPECT_EQ(message.seq_num, 7u);
+    EXPECT_EQ(message.order_id, 1001u);
+    EXPECT_EQ(message.side, OrderSide::SELL);
+    EXPECT_EQ(message.quantity, 250u);
+    EXPECT_EQ(message.price, 150125);
+    EXPECT_EQ(message.time_in_force, TimeInForce::IMMEDIATE_OR_CANCEL);
+    // Views point into the buffer, nothing is copied
+    EXPECT_GE(message.symbol.data(), text.data());
+    EXPECT_LT(message.symbol.data(), text.data() + text.size());
+
+    Order order = message.toOrder();
+    EXPECT_EQ(order.symbol(), "INFY");
+    EXPECT_EQ(order.price(), 150125);
+    EXPECT_EQ(order.order_type(), OrderType::LIMIT);
+}
+
+TEST(FixParserTest, CancelAndReplaceRequests) {
+    OrderMessage message;
+    ASSERT_EQ(parseText(frame("35=F|11=1002|41=1001|55=INFY|54=1|"), message), ParseStatus::OK);
+    EXPECT_EQ(message.type, MsgType::ORDER_CANCEL_REQUEST);
+    EXPECT_EQ(message.orig_order_id, 1001u);
+
+    ASSERT_EQ(parseText(frame("35=G|11=1003|41=1002|55=INFY|54=2|38=75.00|40=4|44=99.5|99=100|59=1|"), message),
+              ParseStatus::OK);
+    EXPECT_EQ(message.type, MsgType::ORDER_CANCEL_REPLACE_REQUEST);
+    EXPECT_EQ(message.order_type, OrderType::STOP_LIMIT);
+    EXPECT_EQ(message.quantity, 75u);
+    EXPECT_EQ(message.price, 9950);
+    EXPECT_EQ(message.stop_price, 10000);
+    EXPECT_EQ(message.time_in_force, TimeInForce::GOOD_TILL_CANCELLED);
+
+    EXPECT_EQ(parseText(frame("35=G|11=1003|55=INFY|54=2|38=75|40=1|"), message), ParseStatus::MISSING_FIELD);
+    EXPECT_EQ(message.error_tag, 41u);
+    EXPECT_EQ(parseText(frame("35=D|11=1|55=INFY|54=1|38=5|40=2|"), message), ParseStatus::MISSING_FIELD);
+    EXPECT_EQ(message.error_tag, 44u);
+    EXPECT_EQ(parseText(frame("35=8|11=1|"), message), ParseStatus::UNSUPPORTED_MSG_TYPE);
+}
+
+TEST(FixParserTest, PricesAndValues) {
+    const std::pair<const char*, Price> good[] = {
+        {"1501.25", 150125}, {"1501.2", 150120}, {"1501", 150100}, {"-0.50", -50}, {"1.2500", 125}, {".5", 50}};
+    for (const auto& [text, paisa] : good) {
+        Price price = 0;
+        EXPECT_TRUE(parsePrice(text, price)) << text;
+        EXPECT_EQ(price, paisa) << text;
+    }
+    Price price = 0;
+    for (const char* text : {"1.255", "", ".", "12a", "1.2.3"}) EXPECT_FALSE(parsePrice(text, price)) << text;
+
+    OrderMessage message;
+    EXPECT_EQ(parseText(frame("35=D|11=1|55=INFY|54=7|38=5|40=1|"), message), ParseStatus::BAD_VALUE);
+    EXPECT_EQ(message.error_tag, 54u);
+    EXPECT_EQ(parseText(frame("35=D|11=ABC|55=INFY|54=1|38=5|40=1|"), message), ParseStatus::BAD_VALUE);
+    EXPECT_EQ(parseText(frame("35=D|11=1|55=INFY|54=1|38=5|40=1|44=1.001|"), message), ParseStatus::BAD_VALUE);
+    EXPECT_EQ(parseText(frame("35=D|11=1|55|54=1|"), message), ParseStatus::MALFORMED_FIELD);
+    EXPECT_EQ(parseText(frame("35=D|1x=1|"), message), ParseStatus::MALFORMED_FIELD);
+}
+
+TEST(FixParserTest, FramingAndChecksum) {
+    std::string text = newOrderSingle(1, 42, "TCS", OrderSide::BUY, 10, 350000);
+    OrderMessage message;
+    size_t consumed = 0;
+    for (size_t length = 0; length < text.size(); ++length) {
+        EXPECT_EQ(parse(text.data(), length, message, consumed), ParseStatus::INCOMPLETE) << length;
+    }
+
+    std::string corrupted = text;
+    corrupted[corrupted.find("55=TCS") + 3] = 'X';
+    EXPECT_EQ(parse(corrupted.data(), corrupted.size(), message, consumed), ParseStatus::BAD_CHECKSUM);
+    EXPECT_EQ(consumed, text.size()); // Frame intact, the message can be skipped
+
+    // A BodyLength one short leaves the trailer misaligned; one long just waits for more bytes
+    const size_t at = BEGIN_STRING.size() + 2;
+    size_t digits = text.find(SOH, at) - at;
+    int body_length = std::stoi(text.substr(at, digits));
+    std::string shorter = text;
+    shorter.replace(at, digits, std::to_string(body_length - 1));
+    EXPECT_EQ(parse(shorter.data(), shorter.size(), message, consumed), ParseStatus::BAD_BODY_LENGTH);
+    EXPECT_EQ(consumed, 0u);
+    std::string longer = text;
+    longer.replace(at, digits, std::to_string(body_length + 1));
+    EXPECT_EQ(parse(longer.data(), longer.size(), message, consumed), ParseStatus::INCOMPLETE);
+
+    std::string fix42 = "8=FIX.4.2" + text.substr(9);
+    EXPECT_EQ(parse(fix42.data(), fix42.size(), message, consumed), ParseStatus::BAD_BEGIN_STRING);
+}
+
+TEST(FixParserTest, SimdAndScalarScanningAgree) {
+    // Long values and '=' inside a value push fields across 16 and 64 byte boundaries
+    std::string text = frame("35=D|49=" + std::string(70, 'S') + "|56=ENGINE|34=12|58=a=b==c|11=77|55=RELIANCE|"
+                             "54=1|38=1000|40=2|44=2450.05|59=4|" + std::string("9999=") + std::string(61, 'x') + "|");
+    OrderMessage simd, scalar;
+    ASSERT_EQ(parseText<DelimiterScanner>(text, simd), ParseStatus::OK);
+    ASSERT_EQ(parseText<ScalarDelimiterScanner>(text, scalar), ParseStatus::OK);
+    EXPECT_EQ(simd.sender, scalar.sender);
+    EXPECT_EQ(simd.sender.size(), 70u);
+    EXPECT_EQ(simd.symbol, "RELIANCE");
+    EXPECT_EQ(simd.price, 245005);
+    EXPECT_EQ(simd.time_in_force, TimeInForce::FILL_OR_KILL);
+    EXPECT_EQ(DelimiterScanner::checksum(text.data(), text.size()),
+              ScalarDelimiterScanner::checksum(text.data(), text.size()));
+}
+
+TEST(FixParserTest, StreamSkipsRejectedMessagesAndStopsAtTail) {
+    std::string stream = newOrderSingle(1, 1, "INFY", OrderSide::BUY, 10, 10000);
+    std::string bad = newOrderSingle(2, 2, "INFY", OrderSide::BUY, 10, 10000);
+    bad[bad.size() - 2] = bad[bad.size() - 2] == '0' ? '1' : '0';  // CheckSum digit
+    stream += bad;
+    stream += frame("35=F|11=3|41=1|");
+    std::string tail = newOrderSingle(4, 4, "INFY", OrderSide::SELL, 10, 10100);
+    size_t complete = stream.size();
+    stream += tail.substr(0, tail.size() / 2);
+
+    std::vector<OrderId> ids;
+    std::vector<ParseStatus> errors;
+    size_t consumed = parseStream(stream.data(), stream.size(),
+                                  [&](const OrderMessage& message) { ids.push_back(message.order_id); },
+                                  [&](ParseStatus status, const OrderMessage&) { errors.push_back(status); });
+    EXPECT_EQ(consumed, complete);
+    EXPECT_EQ(ids, (std::vector<OrderId>{1, 3}));
+    EXPECT_EQ(errors, std::vector<ParseStatus>{ParseStatus::BAD_CHECKSUM});
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
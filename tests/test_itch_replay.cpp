@@ -0,0 +1,90 @@
+#include "../src/ItchReplay.h"
+#include <gtest/gtest.h>
+
+using namespace OrderEngine;
+
+namespace {
+    struct CountingHandler : Itch::HandlerBase {
+        std::vector<char> types;
+        uint64_t lastReference = 0;
+        uint32_t lastPrice = 0;
+        std::string lastStock;
+
+        void on_message(const uint8_t* message, size_t, uint64_t) { types.push_back(static_cast<char>(message[0])); }
+        void on_add_order(const Itch::AddOrder& add) {
+            lastReference = add.order_reference();
+            lastPrice = add.price();
+            lastStock = std::string(add.stock());
+        }
+    };
+}
+
+TEST(ItchParserTest, DecodesFramedMessagesInPlace) {
+    std::vector<uint8_t> buffer;
+    Itch::Encoder encoder(buffer);
+    encoder.system_event('O');
+    encoder.stock_directory(7, "AAPL");
+    encoder.add_order(7, 0x0102030405060708ull, true, 300, "AAPL", 1895000, 0x123456789ABCull);
+    encoder.order_delete(7, 42);
+
+    CountingHandler handler;
+    auto result = Itch::parseStream(buffer.data(), buffer.size(), handler);
+    EXPECT_EQ(result.messages, 4u);
+    EXPECT_EQ(result.malformed, 0u);
+    EXPECT_EQ(result.bytes_consumed, buffer.size());
+    EXPECT_EQ(handler.types, (std::vector<char>{'S', 'R', 'A', 'D'}));
+    EXPECT_EQ(handler.lastReference, 0x0102030405060708ull);
+    EXPECT_EQ(handler.lastPrice, 1895000u);
+    EXPECT_EQ(handler.lastStock, "AAPL");
+
+    Itch::AddOrder add{{buffer.data() + 2 + 12 + 2 + 39 + 2}};
+    EXPECT_EQ(add.timestamp_ns(), 0x123456789ABCull);
+    EXPECT_EQ(add.stock_locate(), 7);
+
+    // A truncated trailing frame is left unconsumed
+    CountingHandler partial;
+    auto truncated = Itch::parseStream(buffer.data(), buffer.size() - 3, partial);
+    EXPECT_EQ(truncated.messages, 3u);
+    EXPECT_LT(truncated.bytes_consumed, buffer.size() - 3);
+}
+
+TEST(ItchReplayTest, RebuildsBooksPerLocate) {
+    std::vector<uint8_t> buffer;
+    Itch::Encoder encoder(buffer);
+    encoder.stock_directory(1, "AAPL");
+    encoder.stock_directory(2, "MSFT");
+    encoder.add_order(1, 10, true, 100, "AAPL", 1890000);
+    encoder.add_order(1, 11, true, 200, "AAPL", 1890000);
+    encoder.add_order(1, 12, false, 300, "AAPL", 1891000);
+    encoder.add_order(2, 20, false, 50, "MSFT", 4100000);
+    encoder.order_executed(1, 10, 40, 1);   // 60 left, keeps priority
+    encoder.order_cancel(1, 12, 100);       // 200 left
+    encoder.order_replace(1, 11, 13, 500, 1889000);
+    encoder.order_delete(2, 20);
+    encoder.order_delete(2, 999);           // Unknown reference
+
+    ItchBookReplayer replayer;
+    Itch::parseStream(buffer.data(), buffer.size(), replayer);
+
+    ASSERT_EQ(replayer.book_count(), 2u);
+    const auto* aapl = replayer.book_at(1);
+    ASSERT_NE(aapl, nullptr);
+    EXPECT_EQ(aapl->symbol(), "AAPL");
+    EXPECT_EQ(aapl->bids().quantity_at_price(1890000), 60u);
+    EXPECT_EQ(aapl->bids().quantity_at_price(1889000), 500u);
+    EXPECT_EQ(aapl->asks().quantity_at_price(1891000), 200u);
+    EXPECT_EQ(aapl->queue_position(10).orders_ahead, 0u);
+    EXPECT_TRUE(replayer.book_at(2)->asks().empty());
+
+    const auto& counters = replayer.counters();
+    EXPECT_EQ(counters.adds, 4u);
+    EXPECT_EQ(counters.executions, 1u);
+    EXPECT_EQ(counters.replaces, 1u);
+    EXPECT_EQ(counters.deletes, 2u);
+    EXPECT_EQ(counters.unknown_orders, 1u);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,88 @@
+#include "../src/OrderBook.h"
+#include <gtest/gtest.h>
+#include <sstream>
+
+using namespace OrderEngine;
+
+TEST(LatencyHistogramTest, PercentilesWithinBucketPrecision) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.percentile(99), 0u);
+    for (uint64_t value = 1; value <= 100000; ++value) histogram.record(value);
+
+    EXPECT_EQ(histogram.count(), 100000u);
+    EXPECT_EQ(histogram.min(), 1u);
+    EXPECT_EQ(histogram.max(), 100000u);
+    EXPECT_EQ(histogram.mean(), 50000u);
+    const std::pair<double, double> expected[] = {{50, 50000}, {90, 90000}, {99, 99000}, {99.9, 99900}};
+    for (const auto& point : expected) {
+        double reported = static_cast<double>(histogram.percentile(point.first));
+        EXPECT_GE(reported, point.second);
+        EXPECT_LE(reported, point.second * (1.0 + 1.0 / 32));
+    }
+    EXPECT_EQ(histogram.percentile(100), 100000u);
+
+    // Small values are exact, huge ones clamp into the last bucket but keep max
+    LatencyHistogram edges;
+    edges.record(7);
+    edges.record(uint64_t{1} << 50);
+    EXPECT_EQ(edges.percentile(50), 7u);
+    EXPECT_EQ(edges.percentile(100), uint64_t{1} << 50);
+}
+
+TEST(LatencyHistogramTest, MergeEqualsRecordingIntoOne) {
+    LatencyHistogram combined, left, right, merged;
+    for (uint64_t value = 1; value < 5000; value += 3) {
+        (value % 2 ? left : right).record(value * 17);
+        combined.record(value * 17);
+    }
+    merged.merge(left);
+    merged.merge(right);
+
+    EXPECT_EQ(merged.count(), combined.count());
+    EXPECT_EQ(merged.min(), combined.min());
+    EXPECT_EQ(merged.max(), combined.max());
+    EXPECT_EQ(merged.mean(), combined.mean());
+    for (double p : {1.0, 50.0, 99.0, 99.9}) EXPECT_EQ(merged.percentile(p), combined.percentile(p));
+
+    merged.reset();
+    EXPECT_EQ(merged.count(), 0u);
+    EXPECT_EQ(merged.max(), 0u);
+}
+
+TEST(LatencyHistogramTest, OrderBookRecordsEachOperation) {
+    using OrderPtr = std::shared_ptr<Order>;
+    OrderBook<OrderPtr> book("AAPL");
+    EXPECT_EQ(book.latency(), nullptr);
+
+    book.enableLatencyHistograms();
+    book.addOrder(std::make_shared<Order>(1, "AAPL", OrderSide::BUY, 100, 15000));
+    book.addOrder(std::make_shared<Order>(2, "AAPL", OrderSide::BUY, 100, 14900));
+    book.addOrder(std::make_shared<Order>(3, "AAPL", OrderSide::SELL, 50, 15000)); // Trades
+    book.replaceOrder(2, 80);
+    book.reduceOrder(1, 10);
+    book.cancelOrder(2);
+    book.cancelOrder(99); // Unknown, still timed
+
+    const OrderBookLatency* latency = book.latency();
+    ASSERT_NE(latency, nullptr);
+    EXPECT_EQ(latency->add.count(), 3u);
+    EXPECT_EQ(latency->match.count(), 1u);
+    EXPECT_EQ(latency->replace.count(), 1u);
+    EXPECT_EQ(latency->cancel.count(), 3u);
+    EXPECT_EQ(latency->notify.count(), 6u);
+
+    // Shard view: books merge into one total
+    OrderBookLatency shard;
+    shard.merge(*latency);
+    shard.merge(*latency);
+    EXPECT_EQ(shard.add.count(), 6u);
+
+    std::ostringstream out;
+    shard.dump(out);
+    EXPECT_NE(out.str().find("replace"), std::string::npos);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,66 @@
+#include "../src/LobsterLoader.h"
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace OrderEngine;
+
+TEST(LobsterLoaderTest, ParsesRowsInPlace) {
+    std::string line = "34200.017459617,1,11885113,21,2238100,1";
+    Lobster::Message message;
+    ASSERT_TRUE(Lobster::parseMessage(line.data(), line.data() + line.size(), message));
+    EXPECT_EQ(message.time_ns, 34200017459617);
+    EXPECT_EQ(message.type, Lobster::EventType::SUBMIT);
+    EXPECT_EQ(message.order_id, 11885113u);
+    EXPECT_EQ(message.size, 21u);
+    EXPECT_EQ(message.price, 2238100);
+    EXPECT_TRUE(message.is_buy());
+
+    std::string bad = "34200.1,9,1,1,1,1";
+    EXPECT_FALSE(Lobster::parseMessage(bad.data(), bad.data() + bad.size(), message));
+
+    std::string row = "2239500,100,2231800,100,9999999999,0,-9999999999,0";
+    Lobster::BookRow book;
+    ASSERT_TRUE(Lobster::parseBookRow(row.data(), row.data() + row.size(), book));
+    EXPECT_EQ(book.levels, 2u);
+    EXPECT_EQ(book.ask_price[0], 2239500);
+    EXPECT_EQ(book.bid_size[0], 100u);
+    EXPECT_EQ(book.bid_price[1], Lobster::EMPTY_BID_PRICE);
+}
+
+TEST(LobsterLoaderTest, ReplayValidatesEveryRow) {
+    // Row 1 seeds the pre-existing book; order 5 is not known to the book
+    std::string messages =
+        "34200.0,1,5,100,2239500,-1\r\n"
+        "34200.1,1,10,50,2231800,1\r\n"      // joins the seeded bid level
+        "34200.2,1,11,70,2232000,1\r\n"      // new best bid
+        "34200.3,4,5,40,2239500,-1\r\n"      // execution of a pre-existing ask
+        "34200.4,2,10,20,2231800,1\r\n"      // partial cancel
+        "34200.5,3,11,70,2232000,1\r\n"      // delete
+        "34200.6,5,0,10,2235000,1\r\n";      // hidden execution, no depth change
+    std::string orderbook =
+        "2239500,100,2231800,100\n"
+        "2239500,100,2231800,150\n"
+        "2239500,100,2232000,70\n"
+        "2239500,60,2232000,70\n"
+        "2239500,60,2232000,75\n"            // wrong on purpose: the bid is 70
+        "2239500,60,2231800,130\n"
+        "2239500,60,2231800,130\n";
+
+    Lobster::Replayer replayer("TEST");
+    ASSERT_TRUE(Lobster::replay(replayer, messages.data(), messages.size(), orderbook.data(), orderbook.size()));
+
+    const auto& counters = replayer.counters();
+    EXPECT_EQ(counters.messages, 6u);
+    EXPECT_EQ(counters.rows_validated, 6u);
+    EXPECT_EQ(counters.seed_adjustments, 1u);
+    EXPECT_EQ(counters.skipped, 1u);
+    EXPECT_EQ(counters.unknown_orders, 0u);
+    EXPECT_EQ(counters.mismatched_rows, 1u);
+    EXPECT_EQ(counters.first_mismatch, 5u);
+    EXPECT_EQ(replayer.book().bids().quantity_at_price(2231800), 130u);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,150 @@
+#include "../src/MatchingEngine.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace OrderEngine;
+
+TEST(SpscQueueTest, WrapsAroundAndKeepsOrderAcrossThreads) {
+    SpscQueue<uint64_t> queue(5);
+    EXPECT_EQ(queue.capacity(), 8u);
+    for (uint64_t i = 0; i < 8; ++i) EXPECT_TRUE(queue.try_push(i));
+    EXPECT_FALSE(queue.try_push(8)); // Full
+    uint64_t value = 0;
+    EXPECT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, 0u);
+    EXPECT_TRUE(queue.try_push(8));
+    EXPECT_EQ(queue.size(), 8u);
+
+    constexpr uint64_t COUNT = 200000;
+    std::thread producer([&] {
+        for (uint64_t i = 9; i < COUNT; ++i) {
+            while (!queue.try_push(i)) std::this_thread::yield();
+        }
+    });
+    uint64_t expected = 1;
+    while (expected < COUNT) {
+        if (!queue.try_pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        ASSERT_EQ(value, expected);
+        ++expected;
+    }
+    producer.join();
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(MatchingEngineTest, RequestsReachTheirBooksAndAreAcked) {
+    MatchingEngine engine({"INFY", "TCS", "WIPRO"}, {5, 3, 1}, 2, 16);
+    ASSERT_EQ(engine.threads(), 2u);
+    EXPECT_NE(engine.plan().owner(0), engine.plan().owner(1));
+    engine.start();
+
+    std::vector<EngineRequest> requests;
+    auto add = [&](uint32_t book, OrderId id, OrderSide side, Price price, Quantity qty) {
+        EngineRequest request;
+        request.book = book;
+        request.order_id = id;
+        request.side = side;
+        request.price = price;
+        request.quantity = qty;
+        request.tag = requests.size();
+        requests.push_back(request);
+    };
+    // More requests than the queues hold, so submit has to wait for the matchers
+    for (OrderId id = 1; id <= 40; ++id) add(id % 3, id, OrderSide::BUY, 15000 - static_cast<Price>(id), 100);
+    add(0, 100, OrderSide::SELL, 14990, 100);                            // Trades against id 3 (14997)
+    EngineRequest cancel;
+    cancel.type = RequestType::CANCEL;
+    cancel.book = 1;
+    cancel.order_id = 1;
+    cancel.tag = requests.size();
+    requests.push_back(cancel);
+    cancel.order_id = 999;                                                // Unknown: not applied
+    cancel.tag = requests.size();
+    requests.push_back(cancel);
+
+    std::vector<bool> acked(requests.size(), false);
+    size_t acks = 0, applied = 0;
+    EngineAck ack;
+    for (const auto& request : requests) {
+        while (!engine.submit(request)) {
+            if (engine.poll(ack)) { acked[ack.tag] = true; ++acks; applied += ack.applied; }
+        }
+    }
+    while (acks < requests.size()) {
+        if (!engine.poll(ack)) { std::this_thread::yield(); continue; }
+        EXPECT_FALSE(acked[ack.tag]);
+        EXPECT_EQ(ack.order_id, requests[ack.tag].order_id);
+        EXPECT_GT(ack.completed_tsc, 0u);
+        acked[ack.tag] = true;
+        ++acks;
+        applied += ack.applied;
+    }
+    engine.stop();
+
+    EXPECT_EQ(applied, requests.size() - 1);
+    EXPECT_EQ(engine.processed(0) + engine.processed(1), requests.size());
+    EXPECT_EQ(engine.book(0).stats().total_trades.load(), 1u);
+    EXPECT_EQ(engine.book(1).bids().total_orders(), 13u);                 // 14 added, 1 cancelled
+    EXPECT_EQ(engine.book(2).bids().total_orders(), 13u);
+    EXPECT_FALSE(engine.book(1).findOrder(1));
+}
+
+TEST(MatchingEngineTest, RejectedAddIsAckedAsNotApplied) {
+    MatchingEngine engine({"INFY"}, {1}, 1, 16);
+    engine.start();
+
+    EngineRequest request;
+    request.order_id = 1;
+    request.side = OrderSide::BUY;
+    request.price = 15000;
+    request.quantity = 0;                                                 // Invalid: rejected by the book
+    request.tag = 0;
+    ASSERT_TRUE(engine.submit(request));
+    request.order_id = 2;
+    request.quantity = 100;                                               // Rests
+    request.tag = 1;
+    ASSERT_TRUE(engine.submit(request));
+
+    std::vector<bool> applied(2, false);
+    size_t acks = 0;
+    EngineAck ack;
+    while (acks < applied.size()) {
+        if (!engine.poll(ack)) { std::this_thread::yield(); continue; }
+        applied[ack.tag] = ack.applied;
+        ++acks;
+    }
+    engine.stop();
+
+    EXPECT_FALSE(applied[0]);
+    EXPECT_TRUE(applied[1]);
+    EXPECT_EQ(engine.book(0).stats().total_rejected.load(), 1u);
+    EXPECT_EQ(engine.book(0).bids().total_orders(), 1u);
+}
+
+TEST(MatchingEngineTest, MarketOrderAgainstEmptySideIsAckedAsApplied) {
+    MatchingEngine engine({"INFY"}, {1}, 1, 16);
+    engine.start();
+
+    EngineRequest request;
+    request.type = RequestType::MARKET;
+    request.order_id = 1;
+    request.side = OrderSide::BUY;
+    request.quantity = 100;                                               // Nothing to trade with: cancelled
+    request.tag = 0;
+    ASSERT_TRUE(engine.submit(request));
+
+    EngineAck ack;
+    while (!engine.poll(ack)) std::this_thread::yield();
+    engine.stop();
+
+    EXPECT_TRUE(ack.applied);
+    EXPECT_EQ(engine.book(0).stats().total_rejected.load(), 0u);
+    EXPECT_EQ(engine.book(0).stats().total_orders_cancelled.load(), 1u);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,81 @@
+#include "../src/MatchingEngine.h"
+#include "../src/DepthTracker.h"
+#include <gtest/gtest.h>
+
+using namespace OrderEngine;
+using OrderPtr = std::shared_ptr<Order>;
+using Book = OrderBook<OrderPtr>;
+
+namespace {
+    OrderPtr limitOrder(const Symbol& symbol, OrderId id, OrderSide side, Price price, Quantity qty = 100) {
+        return std::make_shared<Order>(id, symbol, side, qty, price);
+    }
+}
+
+TEST(MemoryFootprintTest, TracksRestingOrdersAndKeepsPooledNodes) {
+    Book book("INFY");
+    MemoryFootprint empty = book.memoryFootprint();
+    EXPECT_EQ(empty.orders, 0u);
+    EXPECT_EQ(empty.resting_orders, 0u);
+    EXPECT_GT(empty.other, 0u);                     // Time and sales ring is there from the start
+
+    for (OrderId id = 1; id <= 200; ++id) {
+        book.addOrder(limitOrder("INFY", id, OrderSide::BUY, 15000 - static_cast<Price>(id % 20)));
+    }
+    MemoryFootprint loaded = book.memoryFootprint();
+    EXPECT_EQ(loaded.resting_orders, 200u);
+    EXPECT_EQ(loaded.levels, 20u);
+    EXPECT_EQ(loaded.order_slots, 200u);
+    EXPECT_EQ(loaded.orders, 200 * PointeeFootprint<OrderPtr>::bytes);
+    EXPECT_GE(loaded.order_index, 200 * sizeof(std::pair<const OrderId, std::pair<Price, size_t>>));
+    EXPECT_GT(loaded.price_levels, empty.price_levels);
+    EXPECT_GT(loaded.total(), empty.total());
+
+    for (OrderId id = 1; id <= 200; ++id) book.cancelOrder(id);
+    MemoryFootprint drained = book.memoryFootprint();
+    EXPECT_EQ(drained.orders, 0u);
+    EXPECT_EQ(drained.levels, 0u);
+    EXPECT_EQ(drained.spare_levels, 20u);
+    EXPECT_EQ(drained.order_index, loaded.order_index); // Freed nodes stay in the pool
+}
+
+TEST(MemoryFootprintTest, ReportSortsBooksAndPriceRangeCostsNothing) {
+    Book dense("DENSE"), wide("WIDE");
+    for (OrderId id = 1; id <= 100; ++id) {
+        dense.addOrder(limitOrder("DENSE", id, OrderSide::SELL, 20000 + static_cast<Price>(id)));
+        wide.addOrder(limitOrder("WIDE", id, OrderSide::SELL, 20000 + static_cast<Price>(id) * 5000));
+    }
+    wide.addOrder(limitOrder("WIDE", 101, OrderSide::SELL, 2000000000));  // Far stub quote
+    // The liquidity index grows with levels, not with the price range they span
+    EXPECT_EQ(wide.memoryFootprint().levels, 101u);
+    EXPECT_EQ(wide.memoryFootprint().index_nodes, 101u);
+    EXPECT_LT(wide.memoryFootprint().liquidity_index, 2 * dense.memoryFootprint().liquidity_index);
+
+    MemoryReport report;
+    report.add("DENSE", dense.memoryFootprint());
+    report.add("WIDE", wide.memoryFootprint());
+    DepthTracker<5> depth;
+    MemoryFootprint external;
+    external.depth = depth.memory_bytes();
+    report.add("DEPTH", external);
+    EXPECT_EQ(report.total_bytes(),
+              dense.memoryFootprint().total() + wide.memoryFootprint().total() + depth.memory_bytes());
+
+    std::string text = report.ToString();
+    EXPECT_LT(text.find("WIDE"), text.find("DENSE"));   // Largest first
+    EXPECT_LT(text.find("DENSE"), text.find("DEPTH"));
+    EXPECT_NE(text.find("all books"), std::string::npos);
+}
+
+TEST(MemoryFootprintTest, EngineReportCoversBooksAndQueues) {
+    MatchingEngine engine({"INFY", "TCS"}, {}, 2, 1024);
+    MemoryReport report = engine.memoryReport();
+    EXPECT_EQ(report.books(), 2u);
+    EXPECT_GE(report.shared_bytes(), 2 * 1024 * (sizeof(EngineRequest) + sizeof(EngineAck)));
+    EXPECT_EQ(report.total_bytes(), report.total().total() + report.shared_bytes());
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
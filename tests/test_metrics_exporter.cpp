@@ -0,0 +1,122 @@
+#include "../src/EngineMetrics.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+using namespace OrderEngine;
+
+namespace {
+    std::string readSocket(const std::string& path) {
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::snprintf(address.sun_path, sizeof(address.sun_path), "%s", path.c_str());
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            ::close(fd);
+            return {};
+        }
+        std::string text;
+        char buffer[4096];
+        for (ssize_t n; (n = ::read(fd, buffer, sizeof(buffer))) > 0;) text.append(buffer, static_cast<size_t>(n));
+        ::close(fd);
+        return text;
+    }
+
+    std::string readFile(const std::string& path) {
+        std::ifstream in(path);
+        std::stringstream text;
+        text << in.rdbuf();
+        return text.str();
+    }
+
+    void run(MatchingEngine& engine, const std::vector<EngineRequest>& requests) {
+        size_t acks = 0;
+        EngineAck ack;
+        for (const auto& request : requests) {
+            while (!engine.submit(request)) acks += engine.poll(ack);
+        }
+        while (acks < requests.size()) acks += engine.poll(ack);
+    }
+}
+
+TEST(MetricsExporterTest, TextFormatEscapesLabels) {
+    PrometheusText text;
+    text.family("ome_test_total", "counter", "A test counter")
+        .sample("ome_test_total", {{"book", "A\"B\\C"}}, uint64_t{42})
+        .sample("ome_test_seconds", {}, 0.25);
+    EXPECT_EQ(text.str(), "# HELP ome_test_total A test counter\n"
+                          "# TYPE ome_test_total counter\n"
+                          "ome_test_total{book=\"A\\\"B\\\\C\"} 42\n"
+                          "ome_test_seconds 0.25\n");
+}
+
+TEST(MetricsExporterTest, PublishesFileAndSocket) {
+    std::string file = "/tmp/ome_metrics_test_" + std::to_string(::getpid()) + ".prom";
+    std::string socket = "/tmp/ome_metrics_test_" + std::to_string(::getpid()) + ".sock";
+    std::atomic<int> collected{0};
+    MetricsExporter exporter([&](PrometheusText& out) {
+        out.family("ome_snapshots_total", "counter", "Snapshots taken");
+        out.sample("ome_snapshots_total", {}, static_cast<uint64_t>(++collected));
+    }, MetricsExporterConfig{file, socket, std::chrono::milliseconds(20)});
+    ASSERT_TRUE(exporter.start()) << exporter.error();
+
+    while (exporter.snapshots() < 3) std::this_thread::yield();
+    std::string served = readSocket(socket);
+    EXPECT_EQ(served.rfind("# HELP ome_snapshots_total", 0), 0u);
+    EXPECT_NE(readFile(file).find("ome_snapshots_total "), std::string::npos);
+    exporter.stop();
+
+    EXPECT_EQ(exporter.clientsServed(), 1u);
+    EXPECT_EQ(exporter.writeErrors(), 0u);
+    EXPECT_NE(::access(file.c_str(), F_OK), -1);
+    EXPECT_EQ(::access(socket.c_str(), F_OK), -1);  // Removed on stop
+    std::remove(file.c_str());
+}
+
+TEST(MetricsExporterTest, EngineMetricsReadBooksAndShards) {
+    MatchingEngine engine({"INFY", "TCS"}, {}, 2, 64);
+    EngineMetrics metrics(engine);
+    std::vector<EngineRequest> requests;
+    for (OrderId id = 1; id <= 20; ++id) {
+        EngineRequest request;
+        request.book = static_cast<uint32_t>(id % 2);
+        request.order_id = id;
+        request.side = OrderSide::BUY;
+        request.price = 15000 - static_cast<Price>(id);
+        request.quantity = 100;
+        request.tag = id;
+        requests.push_back(request);
+    }
+    engine.start();
+    run(engine, requests);
+
+    // Memory comes from the matchers while running: wait until both have published after the refresh
+    engine.requestMemoryRefresh();
+    for (size_t shard = 0; shard < engine.threads(); ++shard) {
+        while (!engine.publishedMemory(shard) || engine.publishedMemory(shard)->front().resting_orders < 10) {
+            std::this_thread::yield();
+        }
+    }
+    PrometheusText text;
+    metrics(text);
+    std::string running = text.str();
+    EXPECT_NE(running.find("ome_orders_added_total{book=\"INFY\",shard=\"0\"} 10\n"), std::string::npos);
+    EXPECT_NE(running.find("ome_book_resting_orders{book=\"TCS\",shard=\"1\"} 10\n"), std::string::npos);
+    EXPECT_NE(running.find("ome_matcher_requests_total{shard=\"1\"} 10\n"), std::string::npos);
+    EXPECT_NE(running.find("ome_matcher_service_seconds_count{shard=\"0\"} 10\n"), std::string::npos);
+    EXPECT_NE(running.find("ome_book_memory_bytes{book=\"INFY\",shard=\"0\",component=\"orders\"}"), std::string::npos);
+    EXPECT_EQ(running.find("ome_book_operation_seconds"), std::string::npos);   // Book latency not enabled
+
+    engine.stop();
+    text.clear();
+    metrics(text);
+    EXPECT_NE(text.str().find("ome_book_price_levels{book=\"INFY\",shard=\"0\"} 10\n"), std::string::npos);
+    EXPECT_NE(text.str().find("ome_matcher_requests_per_second{shard=\"0\"} 0\n"), std::string::npos);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
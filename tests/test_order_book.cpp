@@ -0,0 +1,540 @@
+#include "../src/OrderBook.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <tuple>
+
+using namespace OrderEngine;
+using OrderPtr = std::shared_ptr<Order>;
+using Book = OrderBook<OrderPtr>;
+
+namespace {
+    OrderPtr makeOrder(OrderId id, OrderSide side, Quantity qty, Price price,
+                       OrderType type = OrderType::LIMIT,
+                       TimeInForce tif = TimeInForce::GOOD_TILL_CANCELLED) {
+        return std::make_shared<Order>(id, "TCS", side, qty, price, type, tif);
+    }
+
+    struct RecordingListener : OrderListener<OrderPtr> {
+        std::vector<OrderId> accepted;
+        std::vector<std::pair<OrderId, Quantity>> cancelled;
+        Quantity filled = 0;
+
+        void on_accept(const OrderPtr& order) override { accepted.push_back(order->order_id()); }
+        void on_cancel(const OrderPtr& order, Quantity qty) override { cancelled.emplace_back(order->order_id(), qty); }
+        void on_fill(const OrderPtr&, const OrderPtr&, Quantity qty, Price) override { filled += qty; }
+    };
+
+    struct SignalListener : OrderBookListener<Book> {
+        int bboChanges = 0;
+        std::vector<MarketSignals> published;
+
+        void on_bbo_change(const Book*, Price, Price) override { ++bboChanges; }
+        void on_market_signals(const Book*, const MarketSignals& signals) override { published.push_back(signals); }
+    };
+
+    // Asks: 100 @ 15000, 200 @ 15010, 300 @ 15020
+    void seedAsks(Book& book) {
+        book.addOrder(makeOrder(1, OrderSide::SELL, 100, 15000));
+        book.addOrder(makeOrder(2, OrderSide::SELL, 200, 15010));
+        book.addOrder(makeOrder(3, OrderSide::SELL, 300, 15020));
+    }
+    struct DepthBatchListener : DepthListener<Book> {
+        std::vector<std::vector<LevelDelta>> batches;
+        int singleChanges = 0;
+
+        void on_depth_change(const Book*, bool, Price, Quantity, Quantity) override { ++singleChanges; }
+        void on_depth_update(const Book*, const std::vector<LevelDelta>& changes) override { batches.push_back(changes); }
+    };
+
+    std::vector<OrderPtr> makeQuotes(OrderId firstId, std::initializer_list<std::tuple<OrderSide, Price, Quantity>> entries) {
+        std::vector<OrderPtr> quotes;
+        for (const auto& [side, price, qty] : entries) quotes.push_back(makeOrder(firstId++, side, qty, price));
+        return quotes;
+    }
+}
+
+TEST(OrderBookTest, LimitOrdersRestAndCross) {
+    Book book("TCS");
+    seedAsks(book);
+    auto bid = makeOrder(10, OrderSide::BUY, 150, 14990);
+    EXPECT_FALSE(book.addOrder(bid));
+    EXPECT_EQ(book.bids().best_price(), 14990);
+
+    auto sell = makeOrder(11, OrderSide::SELL, 200, 14980);
+    EXPECT_TRUE(book.addOrder(sell));
+    EXPECT_EQ(bid->status(), OrderStatus::FILLED);
+    EXPECT_TRUE(book.bids().empty());
+    // Remaining 50 rests as the new best ask
+    EXPECT_EQ(book.asks().best_price(), 14980);
+    EXPECT_EQ(book.asks().quantity_at_price(14980), 50u);
+    EXPECT_EQ(book.last_trade_price(), 14990);
+}
+
+TEST(OrderBookTest, MarketBuySweepsLevelsInPriceOrder) {
+    Book book("TCS");
+    seedAsks(book);
+    auto buy = makeOrder(10, OrderSide::BUY, 250, MARKET_PRICE, OrderType::MARKET);
+    EXPECT_TRUE(book.addOrder(buy));
+    EXPECT_EQ(buy->status(), OrderStatus::FILLED);
+    EXPECT_EQ(book.asks().best_price(), 15010);
+    EXPECT_EQ(book.asks().quantity_at_price(15010), 50u);
+    EXPECT_EQ(book.asks().total_quantity(), 350u);
+    EXPECT_EQ(book.stats().total_volume.load(), 250u);
+}
+
+TEST(OrderBookTest, FillOrKillRejectedWithoutTouchingBook) {
+    Book book("TCS");
+    auto listener = std::make_shared<RecordingListener>();
+    book.addOrderListener(listener);
+    seedAsks(book);
+
+    // Only 300 available at or below 15010
+    auto fok = makeOrder(10, OrderSide::BUY, 301, 15010, OrderType::LIMIT, TimeInForce::FILL_OR_KILL);
+    EXPECT_FALSE(book.addOrder(fok));
+    EXPECT_EQ(fok->status(), OrderStatus::CANCELLED);
+    EXPECT_EQ(fok->open_quantity(), 301u);
+    EXPECT_EQ(listener->filled, 0u);
+    ASSERT_EQ(listener->cancelled.size(), 1u);
+    EXPECT_EQ(listener->cancelled[0], std::make_pair(OrderId(10), Quantity(301)));
+    EXPECT_EQ(book.asks().quantity_at_price(15000), 100u);
+    EXPECT_EQ(book.asks().total_quantity(), 600u);
+    EXPECT_TRUE(book.bids().empty());
+}
+
+TEST(OrderBookTest, FillOrKillAcceptedFillsCompletely) {
+    Book book("TCS");
+    seedAsks(book);
+    auto fok = makeOrder(10, OrderSide::BUY, 300, 15010, OrderType::LIMIT, TimeInForce::FILL_OR_KILL);
+    EXPECT_TRUE(book.addOrder(fok));
+    EXPECT_EQ(fok->status(), OrderStatus::FILLED);
+    EXPECT_EQ(book.asks().best_price(), 15020);
+    EXPECT_EQ(book.asks().total_quantity(), 300u);
+}
+
+TEST(OrderBookTest, AllOrNoneConditionOnMarketSell) {
+    Book book("TCS");
+    book.addOrder(makeOrder(1, OrderSide::BUY, 100, 15000));
+    book.addOrder(makeOrder(2, OrderSide::BUY, 100, 14990));
+
+    auto tooBig = makeOrder(10, OrderSide::SELL, 250, MARKET_PRICE, OrderType::MARKET);
+    EXPECT_FALSE(book.addOrder(tooBig, ALL_OR_NONE));
+    EXPECT_EQ(book.bids().total_quantity(), 200u);
+
+    auto fits = makeOrder(11, OrderSide::SELL, 150, MARKET_PRICE, OrderType::MARKET);
+    EXPECT_TRUE(book.addOrder(fits, ALL_OR_NONE));
+    EXPECT_EQ(book.bids().best_price(), 14990);
+    EXPECT_EQ(book.bids().total_quantity(), 50u);
+}
+
+TEST(OrderBookTest, AllOrNoneLimitWithoutImmediacyRejected) {
+    Book book("TCS");
+    seedAsks(book);
+    auto listener = std::make_shared<RecordingListener>();
+    book.addOrderListener(listener);
+
+    // Fillable or not, an all-or-none limit order could rest and is rejected up front
+    auto aon = makeOrder(10, OrderSide::BUY, 100, 15010);
+    EXPECT_FALSE(book.addOrder(aon, ALL_OR_NONE));
+    EXPECT_EQ(aon->status(), OrderStatus::REJECTED);
+    EXPECT_TRUE(listener->accepted.empty());
+    EXPECT_EQ(listener->filled, 0u);
+    EXPECT_TRUE(book.bids().empty());
+    EXPECT_EQ(book.asks().total_quantity(), 600u);
+
+    // Combined with immediate-or-cancel it is a fill-or-kill
+    auto fok = makeOrder(11, OrderSide::BUY, 100, 15010);
+    EXPECT_TRUE(book.addOrder(fok, FILL_OR_KILL));
+    EXPECT_EQ(fok->status(), OrderStatus::FILLED);
+}
+
+TEST(OrderBookTest, ImmediateOrCancelDoesNotRest) {
+    Book book("TCS");
+    seedAsks(book);
+    auto ioc = makeOrder(10, OrderSide::BUY, 150, 15000, OrderType::LIMIT, TimeInForce::IMMEDIATE_OR_CANCEL);
+    EXPECT_TRUE(book.addOrder(ioc));
+    EXPECT_EQ(ioc->status(), OrderStatus::CANCELLED);
+    EXPECT_EQ(ioc->open_quantity(), 50u);
+    EXPECT_TRUE(book.bids().empty());
+}
+
+TEST(OrderBookTest, RejectsInvalidOrders) {
+    Book book("TCS");
+    auto wrongSymbol = std::make_shared<Order>(1, "INFY", OrderSide::BUY, 10, 100);
+    EXPECT_FALSE(book.addOrder(wrongSymbol));
+    EXPECT_EQ(wrongSymbol->status(), OrderStatus::REJECTED);
+    EXPECT_EQ(book.stats().total_rejected.load(), 1u);
+}
+
+TEST(OrderBookTest, RejectsDuplicateLiveOrderId) {
+    Book book("TCS");
+    auto original = makeOrder(1, OrderSide::BUY, 100, 14990);
+    book.addOrder(original);
+
+    auto sameSide = makeOrder(1, OrderSide::BUY, 50, 14980);
+    auto otherSide = makeOrder(1, OrderSide::SELL, 50, 15010);
+    EXPECT_FALSE(book.addOrder(sameSide));
+    EXPECT_FALSE(book.addOrder(otherSide));
+    EXPECT_EQ(sameSide->status(), OrderStatus::REJECTED);
+    EXPECT_EQ(otherSide->status(), OrderStatus::REJECTED);
+    EXPECT_EQ(book.stats().total_rejected.load(), 2u);
+    EXPECT_EQ(book.bids().total_quantity(), 100u);
+    EXPECT_TRUE(book.asks().empty());
+
+    // The original keeps its place and its id is free again once it leaves the book
+    EXPECT_TRUE(book.cancelOrder(1));
+    EXPECT_TRUE(book.bids().empty());
+    auto reused = makeOrder(1, OrderSide::BUY, 30, 14980);
+    book.addOrder(reused);
+    EXPECT_EQ(reused->status(), OrderStatus::ACCEPTED);
+    EXPECT_EQ(book.bids().total_quantity(), 30u);
+}
+
+TEST(OrderBookTest, EstimateSweepBuySide) {
+    Book book("TCS");
+    seedAsks(book);
+
+    // 100 @ 15000 + 200 @ 15010 + 50 @ 15020
+    auto estimate = book.estimate_sweep(OrderSide::BUY, 350);
+    EXPECT_TRUE(estimate.fully_fillable());
+    EXPECT_EQ(estimate.best_price, 15000);
+    EXPECT_EQ(estimate.worst_price, 15020);
+    EXPECT_EQ(estimate.levels_touched, 3u);
+    EXPECT_DOUBLE_EQ(estimate.vwap, (100.0 * 15000 + 200.0 * 15010 + 50.0 * 15020) / 350.0);
+
+    auto small = book.estimate_sweep(OrderSide::BUY, 100);
+    EXPECT_EQ(small.worst_price, 15000);
+    EXPECT_EQ(small.levels_touched, 1u);
+    EXPECT_DOUBLE_EQ(small.vwap, 15000.0);
+
+    auto tooBig = book.estimate_sweep(OrderSide::BUY, 1000);
+    EXPECT_FALSE(tooBig.fully_fillable());
+    EXPECT_EQ(tooBig.fillable_quantity, 600u);
+    EXPECT_EQ(tooBig.worst_price, 15020);
+
+    // Nothing on the bid side to sell into, and the book was not touched
+    EXPECT_EQ(book.estimate_sweep(OrderSide::SELL, 10).fillable_quantity, 0u);
+    EXPECT_EQ(book.asks().total_quantity(), 600u);
+}
+
+TEST(OrderBookTest, EstimateSweepSellSideTracksBookChanges) {
+    Book book("TCS");
+    book.addOrder(makeOrder(1, OrderSide::BUY, 100, 15000));
+    book.addOrder(makeOrder(2, OrderSide::BUY, 100, 14990));
+    book.addOrder(makeOrder(3, OrderSide::BUY, 100, 14980));
+
+    auto estimate = book.estimate_sweep(OrderSide::SELL, 150);
+    EXPECT_EQ(estimate.best_price, 15000);
+    EXPECT_EQ(estimate.worst_price, 14990);
+    EXPECT_EQ(estimate.levels_touched, 2u);
+    EXPECT_DOUBLE_EQ(estimate.vwap, (100.0 * 15000 + 50.0 * 14990) / 150.0);
+
+    book.addOrder(makeOrder(4, OrderSide::SELL, 100, 15000));
+    estimate = book.estimate_sweep(OrderSide::SELL, 150);
+    EXPECT_EQ(estimate.best_price, 14990);
+    EXPECT_EQ(estimate.worst_price, 14980);
+}
+
+TEST(OrderBookTest, EstimateSweepPastSnapshotBandUsesLiveIndex) {
+    Book book("TCS");
+    const Price levels = static_cast<Price>(Book::SNAPSHOT_BAND_SLOTS) + 100;
+    for (Price i = 0; i < levels; ++i) {
+        book.addOrder(makeOrder(static_cast<OrderId>(i + 1), OrderSide::SELL, 10, 15000 + i));
+    }
+    book.addOrder(makeOrder(9999, OrderSide::SELL, 5, 150000000)); // stub quote far from the touch
+
+    // The snapshot holds the best slots only, whatever the price range
+    auto snapshot = book.liquidity_snapshot();
+    EXPECT_EQ(snapshot->asks.slot_count(), Book::SNAPSHOT_BAND_SLOTS);
+    EXPECT_FALSE(snapshot->asks.complete());
+    EXPECT_TRUE(snapshot->bids.complete());
+
+    for (Quantity quantity : {Quantity{25}, Quantity{2560}, Quantity{2561}, Quantity{3605}, Quantity{5000}}) {
+        auto estimate = book.estimate_sweep(OrderSide::BUY, quantity);
+        auto expected = book.asks().estimate_sweep(quantity);
+        EXPECT_EQ(estimate.fillable_quantity, expected.fillable_quantity);
+        EXPECT_EQ(estimate.worst_price, expected.worst_price);
+        EXPECT_EQ(estimate.levels_touched, expected.levels_touched);
+        EXPECT_DOUBLE_EQ(estimate.vwap, expected.vwap);
+    }
+    EXPECT_EQ(book.estimate_sweep(OrderSide::BUY, 3605).worst_price, 150000000);
+    EXPECT_EQ(book.estimate_sweep(OrderSide::BUY, 5000).fillable_quantity, 3565u);
+}
+
+TEST(OrderBookTest, EstimateSweepReadableWhileMatching) {
+    Book book("TCS");
+    std::atomic<bool> done{false};
+    std::thread reader([&] {
+        while (!done.load()) {
+            auto estimate = book.estimate_sweep(OrderSide::BUY, 50);
+            if (estimate.fillable_quantity > 0) {
+                ASSERT_GE(estimate.worst_price, estimate.best_price);
+                ASSERT_GE(estimate.vwap, static_cast<double>(estimate.best_price));
+            }
+        }
+    });
+    for (OrderId id = 1; id <= 5000; ++id) {
+        Price price = 15000 + static_cast<Price>(id % 17) * 5;
+        OrderSide side = id % 3 == 0 ? OrderSide::BUY : OrderSide::SELL;
+        book.addOrder(makeOrder(id, side, 10 + id % 40, price));
+    }
+    done = true;
+    reader.join();
+}
+
+TEST(OrderBookTest, MarketSignalsFollowTopOfBook) {
+    Book book("TCS");
+    auto listener = std::make_shared<SignalListener>();
+    book.addBookListener(listener);
+
+    book.addOrder(makeOrder(1, OrderSide::BUY, 300, 14990));
+    book.addOrder(makeOrder(2, OrderSide::SELL, 100, 15010));
+    book.addOrder(makeOrder(3, OrderSide::SELL, 500, 15020));
+
+    auto signals = book.market_signals();
+    EXPECT_EQ(signals.top.bid_price, 14990);
+    EXPECT_EQ(signals.top.ask_qty, 100u);
+    EXPECT_DOUBLE_EQ(signals.top_imbalance, (300.0 - 100.0) / 400.0);
+    EXPECT_DOUBLE_EQ(signals.microprice, (14990.0 * 100 + 15010.0 * 300) / 400.0);
+    EXPECT_EQ(signals.ask_depth_qty, 600u);
+    EXPECT_DOUBLE_EQ(signals.depth_imbalance, (300.0 - 600.0) / 900.0);
+
+    // Third order only changed depth: signals published, BBO unchanged
+    EXPECT_EQ(listener->bboChanges, 2);
+    EXPECT_EQ(listener->published.size(), 3u);
+}
+
+TEST(OrderBookTest, OrderFlowImbalanceAccumulates) {
+    Book book("TCS");
+    book.addOrder(makeOrder(1, OrderSide::BUY, 100, 14990));
+    book.addOrder(makeOrder(2, OrderSide::SELL, 100, 15010));
+    int64_t before = book.market_signals().cumulative_ofi;
+
+    // Bid size up at the same price: +50
+    book.addOrder(makeOrder(3, OrderSide::BUY, 50, 14990));
+    EXPECT_EQ(book.market_signals().last_ofi, 50);
+
+    // Ask lifted by 40: ask size down at the same price -> +40
+    book.addOrder(makeOrder(4, OrderSide::BUY, 40, 15010));
+    EXPECT_EQ(book.market_signals().last_ofi, 40);
+
+    // New better ask of 30 at 15005: -30
+    book.addOrder(makeOrder(5, OrderSide::SELL, 30, 15005));
+    EXPECT_EQ(book.market_signals().last_ofi, -30);
+    EXPECT_EQ(book.market_signals().cumulative_ofi - before, 60);
+}
+
+TEST(OrderBookTest, CancelRemovesRestingOrder) {
+    Book book("TCS");
+    auto listener = std::make_shared<RecordingListener>();
+    book.addOrderListener(listener);
+    seedAsks(book);
+
+    EXPECT_TRUE(book.cancelOrder(2));
+    EXPECT_FALSE(book.cancelOrder(2));
+    EXPECT_EQ(book.asks().quantity_at_price(15010), 0u);
+    EXPECT_EQ(book.asks().total_quantity(), 400u);
+    ASSERT_EQ(listener->cancelled.size(), 1u);
+    EXPECT_EQ(listener->cancelled[0], std::make_pair(OrderId{2}, Quantity{200}));
+}
+
+TEST(OrderBookTest, ReplaceQuantityDownKeepsPriority) {
+    Book book("TCS");
+    book.addOrder(makeOrder(1, OrderSide::BUY, 100, 15000));
+    book.addOrder(makeOrder(2, OrderSide::BUY, 100, 15000));
+
+    EXPECT_TRUE(book.replaceOrder(1, 40));
+    EXPECT_EQ(book.queue_position(1).orders_ahead, 0u);
+    EXPECT_EQ(book.queue_position(2).quantity_ahead, 40u);
+    EXPECT_EQ(book.bids().quantity_at_price(15000), 140u);
+    EXPECT_EQ(book.stats().total_orders_replaced.load(), 1u);
+
+    // Quantity up loses priority
+    EXPECT_TRUE(book.replaceOrder(1, 120));
+    EXPECT_EQ(book.queue_position(1).orders_ahead, 1u);
+    EXPECT_EQ(book.queue_position(2).orders_ahead, 0u);
+    EXPECT_EQ(book.bids().quantity_at_price(15000), 220u);
+}
+
+TEST(OrderBookTest, ReplacePriceRequeuesOrMatches) {
+    Book book("TCS");
+    seedAsks(book);
+    auto bid = makeOrder(10, OrderSide::BUY, 150, 14990);
+    book.addOrder(bid);
+
+    // Passive price change: moves levels, keeps the open quantity
+    EXPECT_TRUE(book.replaceOrder(10, SIZE_UNCHANGED, 14995));
+    EXPECT_EQ(book.bids().quantity_at_price(14990), 0u);
+    EXPECT_EQ(book.bids().quantity_at_price(14995), 150u);
+
+    // Crossing price change trades like an inbound limit order, the rest rests
+    EXPECT_TRUE(book.replaceOrder(10, SIZE_UNCHANGED, 15000));
+    EXPECT_EQ(book.asks().best_price(), 15010);
+    EXPECT_EQ(book.bids().quantity_at_price(15000), 50u);
+    EXPECT_EQ(bid->status(), OrderStatus::PARTIALLY_FILLED);
+
+    // New total must stay above what already traded
+    EXPECT_FALSE(book.replaceOrder(10, 100));
+    EXPECT_FALSE(book.replaceOrder(99, 10));
+}
+
+TEST(OrderBookTest, InjectedClockStampsOrdersAndTrades) {
+    auto clock = std::make_shared<ManualClock>(1000);
+    Book book("TCS", TimeAndSales::DEFAULT_CAPACITY, clock);
+    auto ask = makeOrder(1, OrderSide::SELL, 100, 15000);
+    book.addOrder(ask);
+    EXPECT_EQ(Clock::toNanoseconds(ask->timestamp()), 1000);
+
+    clock->advance(500);
+    book.addOrder(makeOrder(2, OrderSide::BUY, 40, 15000));
+    TradeRecord trade;
+    ASSERT_EQ(book.time_and_sales().last(1, &trade), 1u);
+    EXPECT_EQ(trade.timestamp_ns, 1500);
+
+    // Requeueing restamps, an in-place reduction keeps the arrival time
+    clock->advance(500);
+    book.replaceOrder(1, 80);
+    EXPECT_EQ(Clock::toNanoseconds(ask->timestamp()), 1000);
+    book.replaceOrder(1, SIZE_UNCHANGED, 15010);
+    EXPECT_EQ(Clock::toNanoseconds(ask->timestamp()), 2000);
+}
+
+TEST(OrderBookTest, MassQuoteDiffsAgainstPreviousSet) {
+    Book book("TCS");
+    const ParticipantId maker = 7;
+    auto first = book.massQuote(maker, makeQuotes(100, {
+        {OrderSide::BUY, 14990, 100}, {OrderSide::BUY, 14980, 100}, {OrderSide::SELL, 15010, 100}}));
+    EXPECT_EQ(first.added, 3u);
+    // Another participant joins behind the maker at 14990
+    book.addOrder(makeOrder(1, OrderSide::BUY, 50, 14990));
+
+    auto second = book.massQuote(maker, makeQuotes(200, {
+        {OrderSide::BUY, 14990, 60},    // size down: in place, still first in queue
+        {OrderSide::SELL, 15010, 100},  // unchanged
+        {OrderSide::SELL, 15020, 80},   // new
+        {OrderSide::SELL, 15020, 90}})); // duplicate
+    EXPECT_EQ(second.modified, 1u);
+    EXPECT_EQ(second.unchanged, 1u);
+    EXPECT_EQ(second.added, 1u);
+    EXPECT_EQ(second.cancelled, 1u);
+    EXPECT_EQ(second.rejected, 1u);
+
+    EXPECT_EQ(book.queue_position(100).orders_ahead, 0u);
+    EXPECT_EQ(book.queue_position(1).quantity_ahead, 60u);
+    EXPECT_TRUE(book.queue_position(102).found);    // original ask kept
+    EXPECT_FALSE(book.queue_position(101).found);   // 14980 pulled
+    EXPECT_EQ(book.asks().quantity_at_price(15020), 80u);
+
+    auto pulled = book.massQuote(maker, {});
+    EXPECT_EQ(pulled.cancelled, 3u);
+    EXPECT_EQ(book.bids().total_quantity(), 50u);
+    EXPECT_TRUE(book.asks().empty());
+}
+
+TEST(OrderBookTest, MassQuoteRejectedEntryDoesNotBlockItsPrice) {
+    Book book("TCS");
+    auto quotes = makeQuotes(100, {{OrderSide::BUY, 14990, 0},      // invalid size
+                                   {OrderSide::BUY, 14990, 100}});
+    auto result = book.massQuote(7, quotes);
+    EXPECT_EQ(result.rejected, 1u);
+    EXPECT_EQ(result.added, 1u);
+    EXPECT_EQ(quotes[0]->status(), OrderStatus::REJECTED);
+    EXPECT_EQ(book.bids().quantity_at_price(14990), 100u);
+}
+
+TEST(OrderBookTest, MassQuoteIgnoresOrderReusingCancelledQuoteId) {
+    Book book("TCS");
+    auto listener = std::make_shared<RecordingListener>();
+    book.addOrderListener(listener);
+    const ParticipantId maker = 7;
+    book.massQuote(maker, makeQuotes(100, {{OrderSide::BUY, 14990, 100}}));
+    ASSERT_TRUE(book.cancelOrder(100));
+
+    // Another client rests its own order under the freed id
+    auto other = makeOrder(100, OrderSide::BUY, 50, 14980);
+    book.addOrder(other);
+    listener->cancelled.clear();
+
+    auto pulled = book.massQuote(maker, {});
+    EXPECT_EQ(pulled.cancelled, 0u);
+    EXPECT_TRUE(listener->cancelled.empty());
+    EXPECT_EQ(other->status(), OrderStatus::ACCEPTED);
+    EXPECT_EQ(book.bids().quantity_at_price(14980), 50u);
+}
+
+TEST(OrderBookTest, MassQuotePublishesOneCoalescedDepthUpdate) {
+    Book book("TCS");
+    auto depth = std::make_shared<DepthBatchListener>();
+    book.addDepthListener(depth);
+
+    book.massQuote(1, makeQuotes(100, {{OrderSide::BUY, 14990, 100}, {OrderSide::SELL, 15010, 100}}));
+    book.massQuote(1, makeQuotes(200, {{OrderSide::BUY, 14990, 100}, {OrderSide::BUY, 14980, 40},
+                                       {OrderSide::SELL, 15020, 70}}));
+    ASSERT_EQ(depth->batches.size(), 2u);
+    EXPECT_EQ(depth->singleChanges, 0);
+
+    // Unchanged bid is left out, the moved ask shows as one removal and one addition
+    const auto& batch = depth->batches[1];
+    ASSERT_EQ(batch.size(), 3u);
+    Quantity asksRemoved = 0, added = 0;
+    for (const auto& change : batch) {
+        EXPECT_NE(change.price, 14990);
+        if (change.new_qty == 0) asksRemoved += change.old_qty;
+        else added += change.new_qty - change.old_qty;
+    }
+    EXPECT_EQ(asksRemoved, 100u);
+    EXPECT_EQ(added, 110u);
+}
+
+TEST(TimeAndSalesTest, KeepsMostRecentTrades) {
+    TimeAndSales ring(4);
+    for (uint64_t i = 1; i <= 6; ++i) {
+        ring.append(static_cast<int64_t>(i * 1000), 15000 + static_cast<Price>(i), i * 10, i, 100 + i, OrderSide::SELL);
+    }
+    TradeRecord records[8];
+    ASSERT_EQ(ring.last(8, records), 4u);
+    EXPECT_EQ(records[0].sequence, 3u);
+    EXPECT_EQ(records[3].sequence, 6u);
+    EXPECT_EQ(records[3].price, 15006);
+    EXPECT_EQ(records[3].resting_order_id, 106u);
+    EXPECT_EQ(records[3].aggressor_side, OrderSide::SELL);
+
+    ASSERT_EQ(ring.since(4, records, 8), 2u);
+    EXPECT_EQ(records[0].sequence, 5u);
+    EXPECT_EQ(ring.since(1, records, 1), 1u);
+    EXPECT_EQ(records[0].sequence, 3u); // 2 was already overwritten
+}
+
+TEST(TimeAndSalesTest, BookRecordsTradesForConcurrentReaders) {
+    Book book("TCS", 64);
+    std::atomic<bool> done{false};
+    std::thread reader([&] {
+        TradeRecord records[16];
+        while (!done.load()) {
+            size_t n = book.time_and_sales().last(16, records);
+            for (size_t i = 1; i < n; ++i) {
+                ASSERT_GT(records[i].sequence, records[i - 1].sequence);
+                // Every trade in this flow is 10 lots at the resting order's price
+                ASSERT_EQ(records[i].quantity, 10u);
+                ASSERT_EQ(records[i].price, 15000);
+            }
+        }
+    });
+    for (OrderId id = 1; id <= 4000; id += 2) {
+        book.addOrder(makeOrder(id, OrderSide::SELL, 10, 15000));
+        book.addOrder(makeOrder(id + 1, OrderSide::BUY, 10, 15000));
+    }
+    done = true;
+    reader.join();
+
+    TradeRecord last;
+    ASSERT_EQ(book.time_and_sales().last(1, &last), 1u);
+    EXPECT_EQ(last.sequence, 2000u);
+    EXPECT_EQ(last.inbound_order_id, 4000u);
+    EXPECT_EQ(last.resting_order_id, 3999u);
+    EXPECT_EQ(last.aggressor_side, OrderSide::BUY);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,127 @@
+#include "../src/OrderFlowGenerator.h"
+#include "../src/OrderBook.h"
+#include <gtest/gtest.h>
+
+using namespace OrderEngine;
+using OrderPtr = std::shared_ptr<Order>;
+using Book = OrderBook<OrderPtr>;
+
+namespace {
+    bool sameEvent(const FlowEvent& a, const FlowEvent& b) {
+        return a.time_ns == b.time_ns && a.symbol_index == b.symbol_index && a.type == b.type &&
+            a.order_id == b.order_id && a.side == b.side && a.price == b.price && a.quantity == b.quantity;
+    }
+}
+
+TEST(OrderFlowGeneratorTest, SameSeedSameFlow) {
+    OrderFlowConfig config;
+    config.seed = 99;
+    config.symbols = {"INFY", "TCS", "WIPRO"};
+    config.arrivals = OrderFlowConfig::Arrivals::HAWKES;
+
+    auto first = OrderFlowGenerator(config).generate(5000);
+    auto second = OrderFlowGenerator(config).generate(5000);
+    for (size_t i = 0; i < first.size(); ++i) ASSERT_TRUE(sameEvent(first[i], second[i])) << i;
+
+    config.seed = 100;
+    auto other = OrderFlowGenerator(config).generate(5000);
+    size_t same = 0;
+    for (size_t i = 0; i < first.size(); ++i) same += sameEvent(first[i], other[i]);
+    EXPECT_LT(same, first.size() / 10);
+}
+
+TEST(OrderFlowGeneratorTest, FlowHasConfiguredShape) {
+    for (auto arrivals : {OrderFlowConfig::Arrivals::POISSON, OrderFlowConfig::Arrivals::HAWKES}) {
+        OrderFlowConfig config;
+        config.symbols = {"INFY", "TCS", "WIPRO", "HDFC"};
+        config.symbol_skew = 1.0;
+        config.arrivals = arrivals;
+        OrderFlowGenerator generator(config);
+        auto events = generator.generate(200000);
+
+        // Mean rate close to event_rate
+        double seconds = static_cast<double>(events.back().time_ns) * 1e-9;
+        EXPECT_NEAR(static_cast<double>(events.size()) / seconds, config.event_rate, config.event_rate * 0.1);
+
+        size_t perSymbol[4] = {}, adds = 0, nearTouch = 0, through = 0, cancels = 0, markets = 0;
+        for (const auto& event : events) {
+            perSymbol[event.symbol_index]++;
+            if (event.type == FlowEventType::CANCEL) cancels++;
+            if (event.type == FlowEventType::MARKET) markets++;
+            if (event.type != FlowEventType::ADD) continue;
+            adds++;
+            Price ticks = std::abs(event.price - config.reference_price) / config.tick_size;
+            EXPECT_GE(ticks, 1);
+            if ((event.side == OrderSide::BUY) == (event.price > config.reference_price)) through++;
+            if (ticks <= 2) nearTouch++;
+        }
+        // Zipf(1) over 4 symbols: the first takes 12/25 of the flow
+        EXPECT_NEAR(static_cast<double>(perSymbol[0]) / events.size(), 0.48, 0.02);
+        EXPECT_GT(perSymbol[0], perSymbol[1]);
+        EXPECT_GT(perSymbol[2], perSymbol[3]);
+        // Heavy clustering around the reference (exponent 2.5: ~70% within two ticks)
+        EXPECT_GT(static_cast<double>(nearTouch) / adds, 0.6);
+        EXPECT_NEAR(static_cast<double>(through) / adds, config.marketable_fraction, 0.01);
+        EXPECT_NEAR(static_cast<double>(adds) / events.size(), 0.45, 0.02);
+        EXPECT_NEAR(static_cast<double>(cancels) / events.size(), 0.40, 0.02);
+        EXPECT_NEAR(static_cast<double>(markets) / events.size(), 0.05, 0.01);
+    }
+}
+
+TEST(OrderFlowGeneratorTest, HawkesArrivalsAreBurstier) {
+    // Fano factor (variance / mean) of event counts in 5 ms windows: 1 for Poisson,
+    // about 1 / (1 - branching)^2 for Hawkes windows much longer than the decay time
+    auto fano = [](OrderFlowConfig::Arrivals arrivals) {
+        OrderFlowConfig config;
+        config.arrivals = arrivals;
+        auto events = OrderFlowGenerator(config).generate(500000);
+        const int64_t window = 5000000;
+        std::vector<double> counts(static_cast<size_t>(events.back().time_ns / window), 0.0);
+        for (const auto& event : events) {
+            size_t index = static_cast<size_t>(event.time_ns / window);
+            if (index < counts.size()) counts[index] += 1.0;
+        }
+        double sum = 0, sumSq = 0;
+        for (double count : counts) {
+            sum += count;
+            sumSq += count * count;
+        }
+        double mean = sum / counts.size();
+        return (sumSq / counts.size() - mean * mean) / mean;
+    };
+    EXPECT_NEAR(fano(OrderFlowConfig::Arrivals::POISSON), 1.0, 0.3);
+    EXPECT_GT(fano(OrderFlowConfig::Arrivals::HAWKES), 4.0);
+}
+
+TEST(OrderFlowGeneratorTest, DrivesOrderBook) {
+    OrderFlowConfig config;
+    config.symbols = {"INFY"};
+    OrderFlowGenerator generator(config);
+    Book book("INFY");
+    for (int i = 0; i < 50000; ++i) applyFlowEvent(book, generator.next());
+
+    EXPECT_GT(book.stats().total_trades.load(), 0u);
+    EXPECT_GT(book.stats().total_orders_cancelled.load(), 0u);
+    EXPECT_GT(book.stats().total_orders_replaced.load(), 0u);
+    EXPECT_LT(book.bids().best_price(), book.asks().best_price());
+}
+
+TEST(OrderFlowGeneratorTest, MarketableLimitsTradeWithoutMarketOrders) {
+    auto trades = [](double marketable) {
+        OrderFlowConfig config;
+        config.market_weight = 0.0;
+        config.marketable_fraction = marketable;
+        OrderFlowGenerator generator(config);
+        Book book("INFY");
+        for (int i = 0; i < 20000; ++i) applyFlowEvent(book, generator.next());
+        return book.stats().total_trades.load();
+    };
+    // Passive limits around a fixed reference never cross
+    EXPECT_EQ(trades(0.0), 0u);
+    EXPECT_GT(trades(0.1), 1000u);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
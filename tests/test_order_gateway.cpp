@@ -0,0 +1,208 @@
+#include "../src/OrderGateway.h"
+#include <gtest/gtest.h>
+#include <poll.h>
+
+using namespace OrderEngine;
+
+namespace {
+    // Blocking loopback client that collects framed responses
+    class Client {
+    private:
+        int fd_ = -1;
+        std::vector<uint8_t> in_;
+
+    public:
+        explicit Client(uint16_t port) {
+            fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_port = htons(port);
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            EXPECT_EQ(::connect(fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+        }
+
+        ~Client() { disconnect(); }
+
+        void disconnect() {
+            if (fd_ >= 0) ::close(fd_);
+            fd_ = -1;
+        }
+
+        void send(const std::vector<uint8_t>& bytes) {
+            ASSERT_EQ(::send(fd_, bytes.data(), bytes.size(), 0), static_cast<ssize_t>(bytes.size()));
+        }
+
+        // Next `count` responses as payloads; fewer if none arrive for two seconds
+        std::vector<std::vector<uint8_t>> receive(size_t count) {
+            std::vector<std::vector<uint8_t>> messages;
+            for (;;) {
+                size_t offset = 0;
+                while (messages.size() < count && in_.size() - offset >= Ouch::FRAME_HEADER) {
+                    size_t length = (static_cast<size_t>(in_[offset]) << 8) | in_[offset + 1];
+                    if (in_.size() - offset - Ouch::FRAME_HEADER < length) break;
+                    const uint8_t* payload = in_.data() + offset + Ouch::FRAME_HEADER;
+                    messages.emplace_back(payload, payload + length);
+                    offset += Ouch::FRAME_HEADER + length;
+                }
+                in_.erase(in_.begin(), in_.begin() + static_cast<ptrdiff_t>(offset));
+                if (messages.size() >= count) return messages;
+                pollfd readable{fd_, POLLIN, 0};
+                if (::poll(&readable, 1, 2000) <= 0) return messages;
+                uint8_t buffer[4096];
+                ssize_t received = ::recv(fd_, buffer, sizeof(buffer), 0);
+                if (received <= 0) return messages;
+                in_.insert(in_.end(), buffer, buffer + received);
+            }
+        }
+
+        // True once the gateway has nothing more to say (200ms of silence)
+        bool quiet() {
+            pollfd readable{fd_, POLLIN, 0};
+            return in_.empty() && ::poll(&readable, 1, 200) == 0;
+        }
+    };
+
+    const uint8_t* view(const std::vector<uint8_t>& message) { return message.data(); }
+}
+
+TEST(OrderGatewayTest, TradeReachesBothSessions) {
+    OrderGateway gateway({"INFY", "TCS"});
+    ASSERT_TRUE(gateway.start()) << gateway.error();
+    Client seller(gateway.port()), buyer(gateway.port());
+
+    std::vector<uint8_t> request;
+    Ouch::appendEnterOrder(request, 11, OrderSide::SELL, 100, "INFY", 150000);
+    seller.send(request);
+    auto sold = seller.receive(1);
+    ASSERT_EQ(sold.size(), 1u);
+    Ouch::Accepted accepted{{view(sold[0])}};
+    EXPECT_EQ(accepted.type(), Ouch::Accepted::TYPE);
+    EXPECT_EQ(accepted.token(), 11u);
+    EXPECT_EQ(accepted.stock(), "INFY");
+    EXPECT_EQ(accepted.shares(), 100u);
+
+    request.clear();
+    Ouch::appendEnterOrder(request, 7, OrderSide::BUY, 150, "INFY", 150100);
+    buyer.send(request);
+    auto bought = buyer.receive(2);
+    ASSERT_EQ(bought.size(), 2u);
+    EXPECT_EQ(bought[0][0], Ouch::Accepted::TYPE);
+    Ouch::Executed buyFill{{view(bought[1])}};
+    ASSERT_EQ(buyFill.type(), Ouch::Executed::TYPE);
+    EXPECT_EQ(buyFill.token(), 7u);
+    EXPECT_EQ(buyFill.shares(), 100u);
+    EXPECT_EQ(buyFill.price(), 150000u);
+
+    auto filled = seller.receive(1);
+    ASSERT_EQ(filled.size(), 1u);
+    Ouch::Executed sellFill{{view(filled[0])}};
+    EXPECT_EQ(sellFill.token(), 11u);
+    EXPECT_EQ(sellFill.match_number(), buyFill.match_number());
+
+    // The buyer's remaining 50 rest: replace them, then cancel
+    request.clear();
+    Ouch::appendReplaceOrder(request, 7, 0, 149900);
+    Ouch::appendCancelOrder(request, 7);
+    Ouch::appendCancelOrder(request, 7);
+    buyer.send(request);
+    auto responses = buyer.receive(3);
+    ASSERT_EQ(responses.size(), 3u);
+    Ouch::Replaced replaced{{view(responses[0])}};
+    ASSERT_EQ(replaced.type(), Ouch::Replaced::TYPE);
+    EXPECT_EQ(replaced.shares(), 50u);
+    EXPECT_EQ(replaced.price(), 149900u);
+    Ouch::Cancelled cancelled{{view(responses[1])}};
+    ASSERT_EQ(cancelled.type(), Ouch::Cancelled::TYPE);
+    EXPECT_EQ(cancelled.shares(), 50u);
+    EXPECT_EQ(cancelled.reason(), Ouch::CancelReason::USER_REQUESTED);
+    Ouch::Rejected rejected{{view(responses[2])}};
+    ASSERT_EQ(rejected.type(), Ouch::Rejected::TYPE);
+    EXPECT_EQ(rejected.reason(), Ouch::RejectReason::UNKNOWN_TOKEN);
+
+    EXPECT_TRUE(seller.quiet());
+    gateway.stop();
+    EXPECT_EQ(gateway.book(0).stats().total_trades, 1u);
+    EXPECT_EQ(gateway.book(0).bids().total_orders() + gateway.book(0).asks().total_orders(), 0u);
+}
+
+TEST(OrderGatewayTest, RejectsAndMassCancel) {
+    OrderGateway gateway({"INFY", "TCS"});
+    ASSERT_TRUE(gateway.start()) << gateway.error();
+    Client client(gateway.port());
+
+    std::vector<uint8_t> request;
+    Ouch::appendEnterOrder(request, 1, OrderSide::BUY, 10, "WIPRO", 10000);        // Unknown symbol
+    Ouch::appendEnterOrder(request, 2, OrderSide::BUY, 10, "INFY", 10000);
+    Ouch::appendEnterOrder(request, 2, OrderSide::BUY, 10, "INFY", 10100);         // Token in use
+    Ouch::appendEnterOrder(request, 3, OrderSide::BUY, 0, "INFY", 10000);          // Book rejects size 0
+    Ouch::appendEnterOrder(request, 4, OrderSide::SELL, 5, "TCS", 20000);
+    Ouch::appendEnterOrder(request, 5, OrderSide::SELL, 5, "TCS", 20100);
+    Ouch::appendEnterOrder(request, 6, OrderSide::BUY, 5, "TCS", Ouch::MARKET, TimeInForce::IMMEDIATE_OR_CANCEL);
+    Ouch::appendMassCancel(request, "TCS");
+    Ouch::appendCancelOrder(request, 4);                                            // Already filled
+    client.send(request);
+
+    auto responses = client.receive(11);
+    ASSERT_EQ(responses.size(), 11u);
+    auto reason = [&](size_t i) { return Ouch::Rejected{{view(responses[i])}}.reason(); };
+    EXPECT_EQ(reason(0), Ouch::RejectReason::UNKNOWN_SYMBOL);
+    EXPECT_EQ(responses[1][0], Ouch::Accepted::TYPE);
+    EXPECT_EQ(reason(2), Ouch::RejectReason::DUPLICATE_TOKEN);
+    EXPECT_EQ(reason(3), Ouch::RejectReason::INVALID_ORDER);
+    EXPECT_EQ(responses[4][0], Ouch::Accepted::TYPE);
+    EXPECT_EQ(responses[5][0], Ouch::Accepted::TYPE);
+    Ouch::Accepted market{{view(responses[6])}};
+    EXPECT_EQ(market.price(), Ouch::MARKET);
+    // Market buy of 5 fills against its own session's best offer: two executions, one match
+    EXPECT_EQ(Ouch::Executed{{view(responses[7])}}.match_number(), Ouch::Executed{{view(responses[8])}}.match_number());
+    std::vector<uint64_t> executedTokens = {Ouch::Executed{{view(responses[7])}}.token(),
+                                            Ouch::Executed{{view(responses[8])}}.token()};
+    EXPECT_EQ(executedTokens, (std::vector<uint64_t>{6, 4}));
+    // Mass cancel in TCS takes only the offer at 201.00, INFY token 2 stays
+    Ouch::Cancelled massCancelled{{view(responses[9])}};
+    EXPECT_EQ(massCancelled.token(), 5u);
+    EXPECT_EQ(massCancelled.reason(), Ouch::CancelReason::MASS_CANCEL);
+    EXPECT_EQ(reason(10), Ouch::RejectReason::UNKNOWN_TOKEN);
+    EXPECT_TRUE(client.quiet());
+    gateway.stop();
+    EXPECT_EQ(gateway.book(0).bids().total_orders(), 1u);
+    EXPECT_EQ(gateway.book(1).asks().total_orders(), 0u);
+}
+
+TEST(OrderGatewayTest, BatchesResponsesAndCancelsOnDisconnect) {
+    OrderGateway gateway({"INFY"});
+    ASSERT_TRUE(gateway.start()) << gateway.error();
+    const size_t orders = 500;
+    {
+        Client client(gateway.port());
+        std::vector<uint8_t> request;
+        for (size_t i = 0; i < orders; ++i) {
+            Ouch::appendEnterOrder(request, i + 1, OrderSide::BUY, 10, "INFY", static_cast<uint32_t>(10000 + i));
+        }
+        client.send(request);
+        ASSERT_EQ(client.receive(orders).size(), orders);
+        EXPECT_LT(gateway.writes(), orders / 4); // One send() per read batch, not per response
+        client.disconnect();
+    }
+
+    // A malformed frame closes its session; the gateway keeps serving others
+    Client broken(gateway.port());
+    broken.send({0, 3, 'Z', 0, 0});
+    EXPECT_TRUE(broken.receive(1).empty());
+    Client next(gateway.port());
+    std::vector<uint8_t> request;
+    Ouch::appendMassCancel(request, "NSE");
+    next.send(request);
+    ASSERT_EQ(next.receive(1).size(), 1u);
+
+    gateway.stop();
+    EXPECT_EQ(gateway.protocolErrors(), 1u);
+    EXPECT_EQ(gateway.sessionsAccepted(), 3u);
+    EXPECT_EQ(gateway.book(0).bids().total_orders(), 0u); // Cancelled when the first client went away
+    EXPECT_EQ(gateway.book(0).stats().total_orders_cancelled, orders);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,237 @@
+#include "../src/OrderTracker.h"
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace OrderEngine;
+using OrderPtr = std::shared_ptr<Order>;
+
+namespace {
+    OrderPtr makeOrder(OrderId id, OrderSide side, Quantity qty, Price price) {
+        return std::make_shared<Order>(id, "TCS", side, qty, price);
+    }
+
+    // Reference answers computed by walking the levels
+    Quantity walkQuantityThrough(const OrderTracker<OrderPtr>& tracker, Price limit) {
+        Quantity total = 0;
+        for (const auto& [price, level] : tracker.price_levels()) {
+            bool inside = tracker.is_buy_side() ? price >= limit : price <= limit;
+            if (!inside) break;
+            total += level->total_quantity();
+        }
+        return total;
+    }
+
+    Price walkPriceFor(const OrderTracker<OrderPtr>& tracker, Quantity qty) {
+        Quantity total = 0;
+        for (const auto& [price, level] : tracker.price_levels()) {
+            total += level->total_quantity();
+            if (total >= qty) return price;
+        }
+        return 0;
+    }
+}
+
+TEST(OrderTrackerTest, BidsIterateBestFirst) {
+    OrderTracker<OrderPtr> bids(true);
+    bids.addOrder(makeOrder(1, OrderSide::BUY, 10, 100));
+    bids.addOrder(makeOrder(2, OrderSide::BUY, 10, 105));
+    EXPECT_EQ(bids.best_price(), 105);
+
+    OrderTracker<OrderPtr> asks(false);
+    asks.addOrder(makeOrder(3, OrderSide::SELL, 10, 110));
+    asks.addOrder(makeOrder(4, OrderSide::SELL, 10, 107));
+    EXPECT_EQ(asks.best_price(), 107);
+}
+
+TEST(FenwickTreeTest, PrefixSumsAndDescent) {
+    FenwickTree<Quantity> tree;
+    tree.build({5, 0, 3, 7});
+    EXPECT_EQ(tree.prefix_sum(0), 0u);
+    EXPECT_EQ(tree.prefix_sum(3), 8u);
+    EXPECT_EQ(tree.prefix_sum(4), 15u);
+    EXPECT_EQ(tree.max_prefix_within(4), 0u);
+    EXPECT_EQ(tree.max_prefix_within(5), 2u);
+    EXPECT_EQ(tree.max_prefix_within(100), 4u);
+
+    tree.add(1, 2);
+    EXPECT_EQ(tree.prefix_sum(2), 7u);
+}
+
+TEST(OrderTrackerTest, CumulativeLiquidityQueries) {
+    OrderTracker<OrderPtr> asks(false, 5);
+    auto a1 = makeOrder(1, OrderSide::SELL, 100, 15000);
+    auto a2 = makeOrder(2, OrderSide::SELL, 250, 15010);
+    auto a3 = makeOrder(3, OrderSide::SELL, 50, 15015);
+    asks.addOrder(a1);
+    asks.addOrder(a2);
+    asks.addOrder(a3);
+
+    EXPECT_EQ(asks.total_quantity(), 400u);
+    EXPECT_EQ(asks.quantity_through_price(14995), 0u);
+    EXPECT_EQ(asks.quantity_through_price(15005), 100u);
+    EXPECT_EQ(asks.quantity_through_price(15010), 350u);
+    EXPECT_EQ(asks.price_for_quantity(100), 15000);
+    EXPECT_EQ(asks.price_for_quantity(101), 15010);
+    EXPECT_EQ(asks.price_for_quantity(400), 15015);
+    EXPECT_EQ(asks.price_for_quantity(401), 0);
+
+    asks.update_order_quantity(a2, 10);
+    asks.remove_order(a1);
+    EXPECT_EQ(asks.quantity_through_price(15010), 10u);
+    EXPECT_EQ(asks.price_for_quantity(11), 15015);
+}
+
+TEST(OrderTrackerTest, CumulativeLiquidityMatchesLevelWalk) {
+    std::mt19937_64 rng(42);
+    for (bool buySide : {true, false}) {
+        OrderTracker<OrderPtr> tracker(buySide);
+        std::vector<OrderPtr> live;
+        for (OrderId id = 1; id <= 3000; ++id) {
+            // Wide, drifting prices insert and drop index slots all over the range
+            Price price = 50000 + static_cast<Price>(id) * (buySide ? -3 : 3) + static_cast<Price>(rng() % 4000);
+            if (!live.empty() && rng() % 3 == 0) {
+                size_t idx = rng() % live.size();
+                tracker.remove_order(live[idx]);
+                live[idx] = live.back();
+                live.pop_back();
+            }
+            auto order = makeOrder(id, buySide ? OrderSide::BUY : OrderSide::SELL, 1 + rng() % 500, price);
+            tracker.addOrder(order);
+            live.push_back(order);
+
+            Price probe = 40000 + static_cast<Price>(rng() % 25000);
+            ASSERT_EQ(tracker.quantity_through_price(probe), walkQuantityThrough(tracker, probe));
+            Quantity want = 1 + rng() % (tracker.total_quantity() + 100);
+            ASSERT_EQ(tracker.price_for_quantity(want), walkPriceFor(tracker, want));
+            size_t levels = rng() % (tracker.total_price_levels() + 2);
+            Quantity walked = 0;
+            size_t counted = 0;
+            for (const auto& [price, level] : tracker.price_levels()) {
+                if (counted++ == levels) break;
+                walked += level->total_quantity();
+            }
+            ASSERT_EQ(tracker.quantity_of_best_levels(levels), walked);
+        }
+    }
+}
+
+TEST(OrderTrackerTest, FarStubQuotesCostOneSlotEach) {
+    OrderTracker<OrderPtr> asks(false);
+    asks.addOrder(makeOrder(1, OrderSide::SELL, 100, 150000));
+    asks.addOrder(makeOrder(2, OrderSide::SELL, 5, 150000000));
+    asks.addOrder(makeOrder(3, OrderSide::SELL, 7, INT64_MAX / 2));
+
+    const LiquidityIndex& index = asks.liquidity_index();
+    EXPECT_EQ(index.slot_count(), 3u);
+    EXPECT_LT(index.memory_bytes(), 1024u);
+    EXPECT_EQ(asks.quantity_through_price(INT64_MAX), 112u);
+    EXPECT_EQ(asks.quantity_through_price(INT64_MIN), 0u);
+    EXPECT_EQ(asks.quantity_through_price(149999999), 100u);
+    EXPECT_EQ(asks.price_for_quantity(105), 150000000);
+
+    auto sweep = asks.estimate_sweep(104);
+    EXPECT_EQ(sweep.worst_price, 150000000);
+    EXPECT_EQ(sweep.levels_touched, 2u);
+
+    OrderTracker<OrderPtr> bids(true);
+    bids.addOrder(makeOrder(4, OrderSide::BUY, 10, 1));
+    bids.addOrder(makeOrder(5, OrderSide::BUY, 20, 150000));
+    EXPECT_EQ(bids.quantity_through_price(INT64_MIN), 30u);
+    EXPECT_EQ(bids.quantity_through_price(INT64_MAX), 0u);
+    EXPECT_EQ(bids.quantity_of_best_levels(1), 20u);
+    asks.remove_order(asks.find_order(2));
+    EXPECT_EQ(index.slot_count(), 2u);
+}
+
+TEST(OrderTrackerTest, BestSlotBandPricesSweepsLikeTheIndex) {
+    std::mt19937_64 rng(7);
+    for (bool buySide : {true, false}) {
+        OrderTracker<OrderPtr> tracker(buySide);
+        for (OrderId id = 1; id <= 400; ++id) {
+            Price price = 15000 + static_cast<Price>(rng() % 200) * 5;
+            tracker.addOrder(makeOrder(id, buySide ? OrderSide::BUY : OrderSide::SELL, 1 + rng() % 100, price));
+        }
+        const LiquidityIndex& index = tracker.liquidity_index();
+        for (size_t limit : {size_t{1}, size_t{16}, index.slot_count(), index.slot_count() + 10}) {
+            LiquidityBand band;
+            index.copy_best(limit, !buySide, band);
+            ASSERT_EQ(band.slot_count(), std::min(limit, index.slot_count()));
+            ASSERT_EQ(band.complete(), limit >= index.slot_count());
+
+            for (int probe = 0; probe < 200; ++probe) {
+                Quantity quantity = rng() % (tracker.total_quantity() + 50);
+                SweepEstimate fromBand;
+                if (!band.sweep(quantity, fromBand)) {
+                    ASSERT_FALSE(band.complete());
+                    ASSERT_GT(quantity, band.total_quantity());
+                    continue;
+                }
+                SweepEstimate fromIndex = tracker.estimate_sweep(quantity);
+                ASSERT_EQ(fromBand.fillable_quantity, fromIndex.fillable_quantity);
+                ASSERT_EQ(fromBand.best_price, fromIndex.best_price);
+                ASSERT_EQ(fromBand.worst_price, fromIndex.worst_price);
+                ASSERT_EQ(fromBand.levels_touched, fromIndex.levels_touched);
+                ASSERT_DOUBLE_EQ(fromBand.vwap, fromIndex.vwap);
+            }
+        }
+    }
+}
+
+TEST(OrderTrackerTest, QueuePositionCountsOrdersAhead) {
+    OrderTracker<OrderPtr> bids(true);
+    auto o1 = makeOrder(1, OrderSide::BUY, 100, 15000);
+    auto o2 = makeOrder(2, OrderSide::BUY, 250, 15000);
+    auto o3 = makeOrder(3, OrderSide::BUY, 40, 15000);
+    auto other = makeOrder(4, OrderSide::BUY, 999, 15010);
+    bids.addOrder(o1);
+    bids.addOrder(o2);
+    bids.addOrder(other);
+    bids.addOrder(o3);
+
+    auto position = bids.queue_position(3);
+    ASSERT_TRUE(position.found);
+    EXPECT_EQ(position.price, 15000);
+    EXPECT_EQ(position.quantity_ahead, 350u);
+    EXPECT_EQ(position.orders_ahead, 2u);
+
+    bids.update_order_quantity(o2, 50);
+    EXPECT_EQ(bids.queue_position(3).quantity_ahead, 150u);
+    bids.remove_order(o1);
+    EXPECT_EQ(bids.queue_position(3).quantity_ahead, 50u);
+    EXPECT_EQ(bids.queue_position(3).orders_ahead, 1u);
+    EXPECT_EQ(bids.queue_position(2).orders_ahead, 0u);
+    EXPECT_FALSE(bids.queue_position(1).found);
+}
+
+TEST(OrderTrackerTest, QueuePositionSurvivesCompaction) {
+    std::mt19937_64 rng(11);
+    OrderTracker<OrderPtr> asks(false);
+    std::vector<OrderPtr> queue; // reference FIFO at a single price
+    OrderId nextId = 1;
+    for (int step = 0; step < 5000; ++step) {
+        if (queue.empty() || rng() % 5 < 3) {
+            auto order = makeOrder(nextId++, OrderSide::SELL, 1 + rng() % 100, 20000);
+            asks.addOrder(order);
+            queue.push_back(order);
+        } else {
+            size_t idx = rng() % queue.size();
+            ASSERT_TRUE(asks.remove_order(queue[idx]));
+            queue.erase(queue.begin() + static_cast<std::ptrdiff_t>(idx));
+        }
+        if (queue.empty()) continue;
+
+        size_t probe = rng() % queue.size();
+        Quantity ahead = 0;
+        for (size_t i = 0; i < probe; ++i) ahead += queue[i]->open_quantity();
+        auto position = asks.queue_position(queue[probe]->order_id());
+        ASSERT_TRUE(position.found);
+        ASSERT_EQ(position.orders_ahead, probe);
+        ASSERT_EQ(position.quantity_ahead, ahead);
+        ASSERT_EQ(asks.best_level()->front_order(), queue.front());
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,56 @@
+#include "../src/OrderBook.h"
+#include <gtest/gtest.h>
+#include <sstream>
+
+using namespace OrderEngine;
+
+TEST(PerfCountersTest, TotalsAccumulateDeltas) {
+    PerfSample begin, end;
+    begin.values[static_cast<size_t>(PerfEvent::CYCLES)] = 100;
+    end.values[static_cast<size_t>(PerfEvent::CYCLES)] = 400;
+    end.values[static_cast<size_t>(PerfEvent::BRANCH_MISSES)] = 6;
+
+    PerfTotals totals, merged;
+    totals.add(begin, end);
+    totals.add(begin, end);
+    EXPECT_EQ(totals.operations(), 2u);
+    EXPECT_EQ(totals.total(PerfEvent::CYCLES), 600u);
+    EXPECT_DOUBLE_EQ(totals.per_operation(PerfEvent::BRANCH_MISSES), 6.0);
+
+    merged.merge(totals);
+    merged.merge(totals);
+    EXPECT_EQ(merged.operations(), 4u);
+    EXPECT_EQ(merged.total(PerfEvent::CYCLES), 1200u);
+}
+
+TEST(PerfCountersTest, OrderBookAttributesCountersToOperations) {
+    const PerfCounterGroup& group = PerfCounterGroup::forThisThread();
+    if (!group.any_available()) GTEST_SKIP() << "no perf counters: " << group.error();
+
+    using OrderPtr = std::shared_ptr<Order>;
+    OrderBook<OrderPtr> book("AAPL");
+    EXPECT_EQ(book.perfCounters(), nullptr);
+    book.enablePerfCounters();
+    for (OrderId id = 1; id <= 50; ++id) book.addOrder(std::make_shared<Order>(id, "AAPL", OrderSide::SELL, 10, 15000));
+    book.addOrder(std::make_shared<Order>(100, "AAPL", OrderSide::BUY, 200, 15000));
+    book.cancelOrder(50);
+
+    const OrderBookPerf* perf = book.perfCounters();
+    ASSERT_NE(perf, nullptr);
+    EXPECT_EQ(perf->add.operations(), 51u);
+    EXPECT_EQ(perf->match.operations(), 1u);
+    EXPECT_EQ(perf->cancel.operations(), 1u);
+    if (group.available(PerfEvent::TASK_CLOCK)) {
+        // Software counter: always counts, so the sweep must have registered time
+        EXPECT_GT(perf->match.total(PerfEvent::TASK_CLOCK), 0u);
+    }
+
+    std::ostringstream out;
+    perf->dump(out);
+    EXPECT_NE(out.str().find("match"), std::string::npos);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,36 @@
+#include "../src/ShardPlan.h"
+#include <gtest/gtest.h>
+
+using namespace OrderEngine;
+
+TEST(ShardPlanTest, HeaviestBooksSpreadFirst) {
+    ShardPlan plan({40, 20, 13, 10, 8}, 2);
+    ASSERT_EQ(plan.shards(), 2u);
+    EXPECT_EQ(plan.books(0), (std::vector<size_t>{0, 4}));
+    EXPECT_EQ(plan.books(1), (std::vector<size_t>{1, 2, 3}));
+    EXPECT_EQ(plan.owner(4), 0u);
+    EXPECT_DOUBLE_EQ(plan.load(0), 48.0);
+    EXPECT_DOUBLE_EQ(plan.load(1), 43.0);
+    EXPECT_NEAR(plan.max_speedup(), 91.0 / 48.0, 1e-12);
+}
+
+TEST(ShardPlanTest, HotBookBoundsSpeedup) {
+    // Zipf(1.0) over 64 books: the busiest carries 1 / H(64) of the load
+    std::vector<double> weights;
+    double harmonic = 0.0;
+    for (int i = 1; i <= 64; ++i) {
+        weights.push_back(1.0 / i);
+        harmonic += 1.0 / i;
+    }
+    ShardPlan wide(weights, 64);
+    EXPECT_NEAR(wide.max_speedup(), harmonic, 1e-9);
+
+    ShardPlan single(weights, 0); // Clamped to one shard
+    EXPECT_EQ(single.shards(), 1u);
+    EXPECT_DOUBLE_EQ(single.max_speedup(), 1.0);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,84 @@
+#include "../src/OrderBook.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+
+using namespace OrderEngine;
+
+TEST(TraceRingTest, KeepsMostRecentRecords) {
+    Trace::Ring ring(3, 8);
+    for (uint64_t id = 0; id < 20; ++id) ring.record(Trace::Event::USER, Trace::Phase::INSTANT, id, id * 2);
+    EXPECT_EQ(ring.written(), 20u);
+
+    Trace::Record records[8];
+    EXPECT_EQ(ring.oldest_intact(ring.written()), 13u);
+    ring.copy(13, 7, records);
+    for (uint64_t i = 0; i < 7; ++i) {
+        EXPECT_EQ(records[i].id, 13 + i);
+        EXPECT_EQ(records[i].argument(), (13 + i) * 2);
+        EXPECT_EQ(records[i].event(), Trace::Event::USER);
+        EXPECT_EQ(records[i].phase(), Trace::Phase::INSTANT);
+    }
+    EXPECT_LE(records[0].tsc, records[6].tsc);
+
+    // Slots already overwritten are reported as NONE
+    ring.copy(4, 1, records);
+    EXPECT_EQ(records[0].event(), Trace::Event::NONE);
+
+    // The slot the next record() overwrites counts as lost too: a dump may interrupt that write
+    ring.copy(12, 1, records);
+    EXPECT_EQ(records[0].event(), Trace::Event::NONE);
+}
+
+TEST(TraceRingTest, BookEventsRoundTripThroughDump) {
+    using OrderPtr = std::shared_ptr<Order>;
+    OrderBook<OrderPtr> book("AAPL");
+    book.addOrder(std::make_shared<Order>(1, "AAPL", OrderSide::SELL, 100, 15000)); // Not traced
+
+    Trace::enable();
+    book.addOrder(std::make_shared<Order>(2, "AAPL", OrderSide::BUY, 40, 15000));
+    book.cancelOrder(1);
+    Trace::disable();
+    book.cancelOrder(2);
+
+    std::string path = testing::TempDir() + "trace_ring_test.bin";
+    ASSERT_TRUE(Trace::dump(path.c_str()));
+    Trace::DumpFile dump;
+    ASSERT_TRUE(Trace::readDump(path, dump));
+    std::remove(path.c_str());
+    ASSERT_EQ(dump.threads.size(), 1u);
+    EXPECT_GT(dump.ticks_per_ns, 0.0);
+
+    std::vector<std::pair<Trace::Event, Trace::Phase>> sequence;
+    for (const auto& record : dump.threads[0].records) sequence.emplace_back(record.event(), record.phase());
+    using E = Trace::Event;
+    const auto B = Trace::Phase::BEGIN, X = Trace::Phase::END;
+    std::vector<std::pair<Trace::Event, Trace::Phase>> expected = {
+        {E::ADD_ORDER, B}, {E::MATCH_BUY, B}, {E::EXECUTE_TRADE, B},
+        {E::LISTENER_DISPATCH, B}, {E::LISTENER_DISPATCH, X}, {E::EXECUTE_TRADE, X}, {E::MATCH_BUY, X},
+        {E::LISTENER_DISPATCH, B}, {E::LISTENER_DISPATCH, X}, {E::ADD_ORDER, X},
+        {E::CANCEL_ORDER, B}, {E::LISTENER_DISPATCH, B}, {E::LISTENER_DISPATCH, X}, {E::CANCEL_ORDER, X}};
+    EXPECT_EQ(sequence, expected);
+
+    const auto& records = dump.threads[0].records;
+    EXPECT_EQ(records[0].id, 2u);
+    EXPECT_EQ(records[0].argument(), 40u);
+    EXPECT_EQ(records[2].id, 1u);           // Resting order of the trade
+    EXPECT_EQ(records[10].id, 1u);
+
+    // A breached threshold dumps once, then disarms
+    std::string breach = testing::TempDir() + "trace_ring_breach.bin";
+    Trace::enable();
+    Trace::dumpWhenSlower(1, breach.c_str());
+    book.addOrder(std::make_shared<Order>(3, "AAPL", OrderSide::BUY, 10, 14000));
+    book.addOrder(std::make_shared<Order>(4, "AAPL", OrderSide::BUY, 10, 14000));
+    Trace::disable();
+    EXPECT_EQ(Trace::breachDumps(), 1u);
+    Trace::DumpFile breached;
+    EXPECT_TRUE(Trace::readDump(breach, breached));
+    std::remove(breach.c_str());
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
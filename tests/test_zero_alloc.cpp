@@ -0,0 +1,137 @@
+#include "../src/OrderBook.h"
+#include "../src/DepthTracker.h"
+#include "../bench/AllocationCounter.h"
+#include <gtest/gtest.h>
+
+/**
+ * Steady-state allocation guarantee of the matching path.
+ *
+ * The global operator new/delete are replaced by bench/AllocationCounter.h and
+ * only heap calls of the calling thread are read, so gtest's own bookkeeping
+ * on other threads and anything outside an AllocationScope does not count.
+ *
+ * Orders are created up front: the caller owns order allocation, the book
+ * must not add any of its own once it has been warmed up to its working size.
+ */
+
+using namespace OrderEngine;
+using OrderPtr = std::shared_ptr<Order>;
+using Book = OrderBook<OrderPtr>;
+
+namespace {
+    // Heap calls made by this thread while the scope is alive
+    class AllocationScope {
+    private:
+        uint64_t allocations_ = AllocationCounter::threadAllocations();
+        uint64_t deallocations_ = AllocationCounter::threadDeallocations();
+
+    public:
+        uint64_t allocations() const { return AllocationCounter::threadAllocations() - allocations_; }
+        uint64_t deallocations() const { return AllocationCounter::threadDeallocations() - deallocations_; }
+    };
+
+    /**
+     * Deterministic add / replace / cross / cancel cycle around a fixed mid price.
+     * Every order of a batch is filled or cancelled by the end of it, so the book
+     * returns to empty and each batch creates and retires the same price levels.
+     */
+    class SteadyFlow {
+    private:
+        static constexpr Price MID = 15000;
+        static constexpr size_t LEVELS = 8;
+        static constexpr size_t CANCEL_LAG = 8;
+
+        OrderId nextId_ = 1;
+
+    public:
+        // Orders used by one batch, built outside any measured scope
+        void prepare(size_t count, std::vector<OrderPtr>& batch) {
+            batch.clear();
+            for (size_t i = 0; i < count; ++i) {
+                bool buy = i % 2 == 0;
+                Price offset = static_cast<Price>(1 + i % LEVELS);
+                Price price = buy ? MID - offset : MID + offset;
+                // Every fourth order crosses the spread and trades through the first levels
+                if (i % 4 == 3) price = buy ? MID + 2 : MID - 2;
+                batch.push_back(std::make_shared<Order>(nextId_++, "INFY", buy ? OrderSide::BUY : OrderSide::SELL,
+                                                        10 + i % 7, price));
+            }
+        }
+
+        static void run(Book& book, const std::vector<OrderPtr>& batch) {
+            for (size_t i = 0; i < batch.size(); ++i) {
+                const OrderPtr& order = batch[i];
+                book.addOrder(order);
+                if (i % 3 == 0) book.replaceOrder(order->order_id(), order->quantity() + 5);
+                if (i % 5 == 0) book.replaceOrder(order->order_id(), SIZE_UNCHANGED,
+                                                  order->is_buy() ? order->price() - 1 : order->price() + 1);
+                if (i >= CANCEL_LAG) book.cancelOrder(batch[i - CANCEL_LAG]->order_id());
+            }
+            for (size_t i = batch.size() > CANCEL_LAG ? batch.size() - CANCEL_LAG : 0; i < batch.size(); ++i) {
+                book.cancelOrder(batch[i]->order_id());
+            }
+        }
+    };
+}
+
+TEST(ZeroAllocationTest, CountsOnlyThisThread) {
+    AllocationScope scope;
+    auto p = std::make_unique<int>(7);
+    EXPECT_EQ(scope.allocations(), 1u);
+    p.reset();
+    EXPECT_EQ(scope.deallocations(), 1u);
+}
+
+TEST(ZeroAllocationTest, WarmBookMatchesWithoutHeap) {
+    Book book("INFY");
+    SteadyFlow flow;
+    std::vector<OrderPtr> batch;
+    batch.reserve(1024);
+
+    // Warm-up: grows every container to the flow's working size
+    for (int round = 0; round < 8; ++round) {
+        flow.prepare(1024, batch);
+        SteadyFlow::run(book, batch);
+    }
+    uint64_t tradesBefore = book.stats().total_trades.load();
+
+    for (int round = 0; round < 4; ++round) {
+        flow.prepare(1024, batch);
+        AllocationScope scope;
+        SteadyFlow::run(book, batch);
+        EXPECT_EQ(scope.allocations(), 0u) << "round " << round;
+        EXPECT_EQ(scope.deallocations(), 0u) << "round " << round;
+    }
+    // The flow must actually exercise matching, not just rest orders
+    EXPECT_GT(book.stats().total_trades.load(), tradesBefore);
+    EXPECT_GT(book.stats().total_orders_cancelled.load(), 0u);
+    EXPECT_GT(book.stats().total_orders_replaced.load(), 0u);
+}
+
+TEST(ZeroAllocationTest, DepthRefreshWithoutHeap) {
+    Book book("INFY");
+    for (OrderId id = 1; id <= 40; ++id) {
+        bool buy = id % 2 == 0;
+        book.addOrder(std::make_shared<Order>(id, "INFY", buy ? OrderSide::BUY : OrderSide::SELL, 100,
+                                              buy ? 15000 - static_cast<Price>(id) : 15000 + static_cast<Price>(id)));
+    }
+    DepthTracker<5> depth;
+
+    // The very first refresh reports every level as new, the most changes there can be
+    AllocationScope first;
+    depth.update_from_tracker(book.bids(), book.asks());
+    EXPECT_EQ(first.allocations(), 0u);
+    EXPECT_EQ(depth.get_changes().size(), 10u);
+
+    book.addOrder(std::make_shared<Order>(100, "INFY", OrderSide::BUY, 250, 15010));
+    book.cancelOrder(2);
+    AllocationScope scope;
+    depth.update_from_tracker(book.bids(), book.asks());
+    EXPECT_EQ(scope.allocations(), 0u);
+    EXPECT_FALSE(depth.get_changes().empty());
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
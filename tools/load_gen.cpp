@@ -0,0 +1,279 @@
+#include "../src/EngineMetrics.h"
+#include "../src/MatchingEngine.h"
+#include "../src/OrderFlowGenerator.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Open-loop latency load generator for MatchingEngine.
+ *
+ *   load_gen [--rates R1,R2,...] [--duration S] [--threads M] [--symbols K] [--skew Z]
+ *            [--seed S] [--queue N] [--json <out.json>|-]
+ *            [--metrics <file.prom>] [--metrics-socket <path>] [--metrics-interval MS]
+ *
+ * For every offered rate (orders/s, default 50k doubling up to 6.4M, stopping
+ * one step after the first saturated one) a fresh engine is started and fed a
+ * pre-generated synthetic flow on a fixed schedule: message i is due at
+ * start + i / rate, whether or not earlier messages have been acknowledged.
+ * Latency is ack time minus that intended send time, so time spent queued behind
+ * a slow matcher, or behind a generator that fell behind schedule, is counted
+ * (no coordinated omission). The "naive" column measures from the actual send
+ * instead, which is what a closed-loop driver would report.
+ * A step is saturated once the engine completes less than 95% of the offered
+ * rate or the ingress queue pushed back. The first 10% of every step is warm-up
+ * and not recorded.
+ * --metrics / --metrics-socket export the running engine's stats in Prometheus
+ * text format while each step runs (see EngineMetrics).
+ */
+
+using namespace OrderEngine;
+
+namespace {
+    struct Options {
+        std::vector<double> rates;
+        double duration = 1.0;
+        size_t threads = 1;
+        size_t symbols = 8;
+        size_t queue = 65536;
+        const char* jsonPath = nullptr;
+        MetricsExporterConfig metrics;
+    };
+
+    struct StepResult {
+        double offered = 0.0;
+        double achieved = 0.0;          // Completions per second over the whole step
+        uint64_t messages = 0;
+        uint64_t pushbacks = 0;         // submit() found the ingress queue full
+        bool saturated = false;
+        LatencyHistogram latency;       // Ack - intended send (TSC ticks)
+        LatencyHistogram naive;         // Ack - actual send
+        LatencyHistogram sendLag;       // Actual - intended send
+    };
+
+    void usage() {
+        std::fprintf(stderr, "usage: load_gen [--rates R1,R2,...] [--duration S] [--threads M] [--symbols K] "
+                             "[--skew Z] [--seed S] [--queue N] [--json <out.json>|-] [--metrics <file.prom>] "
+                             "[--metrics-socket <path>] [--metrics-interval MS]\n");
+    }
+
+    std::vector<double> parseRates(const char* text) {
+        std::vector<double> rates;
+        for (const char* p = text; *p;) {
+            char* end = nullptr;
+            double rate = std::strtod(p, &end);
+            if (end == p) break;
+            if (rate > 0.0) rates.push_back(rate);
+            p = *end == ',' ? end + 1 : end;
+        }
+        return rates;
+    }
+
+    EngineRequest toRequest(const FlowEvent& event, uint64_t sequence) {
+        EngineRequest request;
+        switch (event.type) {
+            case FlowEventType::ADD: request.type = RequestType::ADD; break;
+            case FlowEventType::MARKET: request.type = RequestType::MARKET; break;
+            case FlowEventType::CANCEL: request.type = RequestType::CANCEL; break;
+            case FlowEventType::MODIFY: request.type = RequestType::REPLACE; break;
+        }
+        request.book = static_cast<uint32_t>(event.symbol_index);
+        request.order_id = event.order_id;
+        request.side = event.side;
+        request.price = event.price;
+        request.quantity = event.quantity;
+        request.tag = sequence;
+        return request;
+    }
+
+    std::unique_ptr<StepResult> runStep(double rate, const Options& options, const OrderFlowConfig& config) {
+        auto result = std::make_unique<StepResult>();
+        result->offered = rate;
+        size_t count = std::max<size_t>(static_cast<size_t>(rate * options.duration), 1);
+        size_t warmup = count / 10;
+
+        // Flow, placement weights and schedule are all prepared before the clock starts
+        std::vector<EngineRequest> requests;
+        requests.reserve(count);
+        std::vector<double> activity(config.symbols.size(), 0.0);
+        OrderFlowGenerator generator(config);
+        for (size_t i = 0; i < count; ++i) {
+            FlowEvent event = generator.next();
+            activity[event.symbol_index] += 1.0;
+            requests.push_back(toRequest(event, i));
+        }
+        std::vector<uint64_t> sent(count, 0);
+        double ticksPerMessage = Tsc::ticks_per_ns() * 1e9 / rate;
+
+        MatchingEngine engine(config.symbols, activity, options.threads, options.queue);
+        engine.start();
+        std::unique_ptr<MetricsExporter> exporter;
+        if (!options.metrics.file_path.empty() || !options.metrics.socket_path.empty()) {
+            exporter = std::make_unique<MetricsExporter>(EngineMetrics(engine), options.metrics);
+            if (!exporter->start()) std::fprintf(stderr, "metrics: %s\n", exporter->error().c_str());
+        }
+
+        uint64_t start = Tsc::now();
+        uint64_t lastAck = start;
+        size_t acked = 0;
+        auto collect = [&] {
+            EngineAck ack;
+            bool any = false;
+            while (engine.poll(ack)) {
+                any = true;
+                ++acked;
+                lastAck = std::max(lastAck, ack.completed_tsc);
+                if (ack.tag < warmup) continue;
+                uint64_t intended = start + static_cast<uint64_t>(static_cast<double>(ack.tag) * ticksPerMessage);
+                result->latency.record(ack.completed_tsc - intended);
+                result->naive.record(ack.completed_tsc - sent[ack.tag]);
+            }
+            return any;
+        };
+
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t intended = start + static_cast<uint64_t>(static_cast<double>(i) * ticksPerMessage);
+            // Collect acks while waiting for the slot; give the CPU away only when far from it
+            for (uint64_t now = Tsc::now(); now < intended; now = Tsc::now()) {
+                if (!collect() && intended - now > 2000 * Tsc::ticks_per_ns()) std::this_thread::yield();
+            }
+            sent[i] = Tsc::now();
+            bool pushedBack = false;
+            while (!engine.submit(requests[i])) {
+                pushedBack = true;
+                if (!collect()) std::this_thread::yield();
+            }
+            if (pushedBack) {
+                ++result->pushbacks;
+                sent[i] = Tsc::now();
+            }
+            if (i >= warmup) result->sendLag.record(sent[i] - intended);
+        }
+        while (acked < count) {
+            if (!collect()) std::this_thread::yield();
+        }
+        if (exporter) exporter->stop();
+        engine.stop();
+
+        double seconds = static_cast<double>(Tsc::to_ns(lastAck - start)) * 1e-9;
+        result->messages = count;
+        result->achieved = seconds > 0.0 ? static_cast<double>(count) / seconds : 0.0;
+        result->saturated = result->achieved < 0.95 * rate || result->pushbacks > 0;
+        return result;
+    }
+
+    double us(uint64_t ticks) { return static_cast<double>(Tsc::to_ns(ticks)) / 1000.0; }
+
+    void printStep(const StepResult& step) {
+        LatencyHistogram::Summary s = step.latency.summary();
+        std::printf("%12.0f %12.0f %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f %s\n", step.offered, step.achieved,
+                    us(s.p50), us(s.p99), us(s.p999), us(s.max), us(step.naive.percentile(99)),
+                    us(step.sendLag.percentile(99)), step.saturated ? "saturated" : "");
+    }
+
+    void writeLatency(FILE* out, const char* name, const LatencyHistogram& histogram) {
+        LatencyHistogram::Summary s = histogram.summary();
+        std::fprintf(out, "\"%s\":{\"count\":%llu,\"mean\":%.3f,\"p50\":%.3f,\"p90\":%.3f,\"p99\":%.3f,\"p999\":%.3f,\"max\":%.3f}",
+                     name, static_cast<unsigned long long>(s.count), us(s.mean), us(s.p50), us(s.p90), us(s.p99),
+                     us(s.p999), us(s.max));
+    }
+
+    bool writeJson(const char* path, const Options& options, const OrderFlowConfig& config,
+                   const std::vector<std::unique_ptr<StepResult>>& steps) {
+        FILE* out = std::strcmp(path, "-") == 0 ? stdout : std::fopen(path, "w");
+        if (!out) return false;
+        std::fprintf(out, "{\"benchmark\":\"load_gen\",\"config\":{\"threads\":%zu,\"symbols\":%zu,\"skew\":%.3f,"
+                          "\"seed\":%llu,\"duration_s\":%.3f,\"queue\":%zu},\"latency_unit\":\"us\",\"steps\":[",
+                     options.threads, config.symbols.size(), config.symbol_skew,
+                     static_cast<unsigned long long>(config.seed), options.duration, options.queue);
+        for (size_t i = 0; i < steps.size(); ++i) {
+            const StepResult& step = *steps[i];
+            std::fprintf(out, "%s\n{\"offered_per_s\":%.0f,\"achieved_per_s\":%.0f,\"messages\":%llu,\"pushbacks\":%llu,"
+                              "\"saturated\":%s,",
+                         i ? "," : "", step.offered, step.achieved, static_cast<unsigned long long>(step.messages),
+                         static_cast<unsigned long long>(step.pushbacks), step.saturated ? "true" : "false");
+            writeLatency(out, "latency", step.latency);
+            std::fprintf(out, ",");
+            writeLatency(out, "naive_latency", step.naive);
+            std::fprintf(out, ",");
+            writeLatency(out, "send_lag", step.sendLag);
+            std::fprintf(out, "}");
+        }
+        std::fprintf(out, "\n]}\n");
+        return out == stdout ? std::fflush(out) == 0 : std::fclose(out) == 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    OrderFlowConfig config;
+    config.seed = 2024;
+    bool explicitRates = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (!std::strcmp(arg, "--rates") && hasValue) {
+            options.rates = parseRates(argv[++i]);
+            explicitRates = true;
+        }
+        else if (!std::strcmp(arg, "--duration") && hasValue) options.duration = std::strtod(argv[++i], nullptr);
+        else if (!std::strcmp(arg, "--threads") && hasValue) options.threads = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(arg, "--symbols") && hasValue) options.symbols = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(arg, "--skew") && hasValue) config.symbol_skew = std::strtod(argv[++i], nullptr);
+        else if (!std::strcmp(arg, "--seed") && hasValue) config.seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(arg, "--queue") && hasValue) options.queue = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(arg, "--json") && hasValue) options.jsonPath = argv[++i];
+        else if (!std::strcmp(arg, "--metrics") && hasValue) options.metrics.file_path = argv[++i];
+        else if (!std::strcmp(arg, "--metrics-socket") && hasValue) options.metrics.socket_path = argv[++i];
+        else if (!std::strcmp(arg, "--metrics-interval") && hasValue) {
+            options.metrics.interval = std::chrono::milliseconds(std::max<long long>(std::atoll(argv[++i]), 1));
+        }
+        else {
+            usage();
+            return 1;
+        }
+    }
+    if (!explicitRates) {
+        for (double rate = 50000; rate <= 6400000; rate *= 2) options.rates.push_back(rate);
+    }
+    if (options.rates.empty() || options.duration <= 0.0) {
+        usage();
+        return 1;
+    }
+
+    config.symbols.clear();
+    for (size_t i = 0; i < std::max<size_t>(options.symbols, 1); ++i) config.symbols.push_back("SYM" + std::to_string(i));
+    Tsc::ticks_per_ns(); // Calibrate before the first schedule
+
+    // A JSON document on stdout replaces the table
+    bool table = !options.jsonPath || std::strcmp(options.jsonPath, "-") != 0;
+    if (table) {
+        std::printf("open loop, %zu matcher thread(s), %zu symbols (zipf %.2f), %.1f s per step; latency in us "
+                    "from intended send\n", options.threads, config.symbols.size(), config.symbol_skew, options.duration);
+        std::printf("%12s %12s %10s %10s %10s %10s %10s %10s\n", "offered/s", "achieved/s", "p50", "p99", "p99.9",
+                    "max", "naive p99", "lag p99");
+    }
+
+    std::vector<std::unique_ptr<StepResult>> steps;
+    size_t saturatedSteps = 0;
+    for (double rate : options.rates) {
+        steps.push_back(runStep(rate, options, config));
+        if (table) {
+            printStep(*steps.back());
+            std::fflush(stdout);
+        }
+        // The default sweep only goes one step past the knee
+        if (steps.back()->saturated && ++saturatedSteps == 2 && !explicitRates) break;
+    }
+
+    if (options.jsonPath && !writeJson(options.jsonPath, options, config, steps)) {
+        std::fprintf(stderr, "cannot write %s\n", options.jsonPath);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,220 @@
+#include "../src/LobsterLoader.h"
+#include "../src/MappedFile.h"
+#include "../src/OrderFlowGenerator.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * LOBSTER book reconstruction driver and parser/book throughput benchmark.
+ *
+ *   lobster_replay <message.csv> [<orderbook.csv>]
+ *       Memory-maps the files and times three passes: parse only, parse + book,
+ *       and (with an orderbook file) parse + book + DepthTracker validation of
+ *       every row, reporting rows/sec and the first mismatching row.
+ *
+ *   lobster_replay --synthesize <message.csv> <orderbook.csv> [--events N] [--seed S] [--levels L]
+ *       Writes a synthetic message/orderbook pair from OrderFlowGenerator flow
+ *       (adds -> 1, cancels -> 3, modifies -> one-lot 2; market orders dropped),
+ *       with orderbook rows taken from an OrderBook driven by the same messages.
+ */
+
+using namespace OrderEngine;
+
+namespace {
+    using SteadyClock = std::chrono::steady_clock;
+
+    double secondsSince(SteadyClock::time_point start) {
+        return std::chrono::duration<double>(SteadyClock::now() - start).count();
+    }
+
+    const char* chars(const MappedFile& file) { return reinterpret_cast<const char*>(file.data()); }
+
+    void report(const char* pass, uint64_t rows, double seconds) {
+        std::printf("%-22s %llu rows in %.3f s, %.0f rows/s\n", pass,
+                    static_cast<unsigned long long>(rows), seconds, rows / seconds);
+    }
+
+    bool writeFile(const char* path, const std::string& text) {
+        FILE* file = std::fopen(path, "wb");
+        bool ok = file && std::fwrite(text.data(), 1, text.size(), file) == text.size();
+        if (file) std::fclose(file);
+        if (!ok) std::fprintf(stderr, "cannot write %s\n", path);
+        return ok;
+    }
+
+    int synthesize(const char* messagePath, const char* orderbookPath, size_t events, uint64_t seed, size_t levels) {
+        levels = std::min(std::max<size_t>(levels, 1), Lobster::MAX_LEVELS);
+        OrderFlowConfig config;
+        config.seed = seed;
+        config.symbols = {"LOBSTER"};
+        config.reference_price = 1500000; // $150.0000 in LOBSTER units
+        config.tick_size = 100;
+        config.market_weight = 0.0;
+        config.marketable_fraction = 0.0;   // Adds never cross, trades are not encoded
+
+        OrderFlowGenerator generator(config);
+        Lobster::Replayer::Book book("LOBSTER");
+        Lobster::Replayer::Depth depth;
+        std::string messages, orderbook;
+        messages.reserve(events * 40);
+        orderbook.reserve(events * levels * 32);
+        char line[64];
+
+        for (size_t i = 0; i < events; ++i) {
+            FlowEvent event = generator.next();
+            int type = 0;
+            Quantity size = event.quantity;
+            switch (event.type) {
+                case FlowEventType::ADD: type = 1; break;
+                case FlowEventType::CANCEL: type = 3; break;
+                case FlowEventType::MODIFY: type = 2; size = config.lot_size; break;
+                case FlowEventType::MARKET: continue;
+            }
+            // Cancels and modifies carry the resting order's size, price and side
+            if (event.type != FlowEventType::ADD) {
+                auto order = book.findOrder(event.order_id);
+                if (!order) continue;
+                event.price = order->price();
+                event.side = order->side();
+                if (type == 3) size = order->open_quantity();
+                if (type == 2 && size >= order->open_quantity()) continue;
+            }
+            Lobster::Message message;
+            message.type = static_cast<Lobster::EventType>(type);
+            message.order_id = event.order_id;
+            message.size = size;
+            message.price = event.price;
+            message.direction = event.side == OrderSide::BUY ? 1 : -1;
+
+            // Flow starts at midnight; shift it to the 09:30 open as LOBSTER samples do
+            int64_t ns = 34200 * int64_t{1000000000} + event.time_ns;
+            std::snprintf(line, sizeof(line), "%lld.%09lld,%d,%llu,%llu,%lld,%d\n",
+                          static_cast<long long>(ns / 1000000000), static_cast<long long>(ns % 1000000000), type,
+                          static_cast<unsigned long long>(message.order_id), static_cast<unsigned long long>(size),
+                          static_cast<long long>(message.price), message.direction);
+            messages += line;
+
+            switch (message.type) {
+                case Lobster::EventType::SUBMIT:
+                    book.addOrder(std::make_shared<Order>(message.order_id, book.symbol(), event.side,
+                                                          message.size, message.price));
+                    break;
+                case Lobster::EventType::PARTIAL_CANCEL: book.reduceOrder(message.order_id, message.size); break;
+                default: book.cancelOrder(message.order_id); break;
+            }
+
+            depth.update_from_tracker(book.bids(), book.asks());
+            for (size_t level = 0; level < levels; ++level) {
+                const DepthLevel& ask = depth.get_ask_level(level);
+                const DepthLevel& bid = depth.get_bid_level(level);
+                std::snprintf(line, sizeof(line), "%s%lld,%llu,%lld,%llu", level ? "," : "",
+                              static_cast<long long>(ask.quantity ? ask.price : Lobster::EMPTY_ASK_PRICE),
+                              static_cast<unsigned long long>(ask.quantity),
+                              static_cast<long long>(bid.quantity ? bid.price : Lobster::EMPTY_BID_PRICE),
+                              static_cast<unsigned long long>(bid.quantity));
+                orderbook += line;
+            }
+            orderbook += '\n';
+        }
+
+        if (!writeFile(messagePath, messages) || !writeFile(orderbookPath, orderbook)) return 1;
+        std::printf("wrote %s (%zu bytes) and %s (%zu bytes)\n", messagePath, messages.size(),
+                    orderbookPath, orderbook.size());
+        return 0;
+    }
+
+    void usage() {
+        std::fprintf(stderr, "usage: lobster_replay <message.csv> [<orderbook.csv>]\n"
+                             "       lobster_replay --synthesize <message.csv> <orderbook.csv> "
+                             "[--events N] [--seed S] [--levels L]\n");
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* paths[2] = {nullptr, nullptr};
+    size_t pathCount = 0;
+    bool synthesizeMode = false;
+    size_t events = 1000000, levels = 10;
+    uint64_t seed = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (!std::strcmp(arg, "--synthesize")) synthesizeMode = true;
+        else if (!std::strcmp(arg, "--events") && hasValue) events = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(arg, "--seed") && hasValue) seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(arg, "--levels") && hasValue) levels = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg[0] != '-' && pathCount < 2) paths[pathCount++] = arg;
+        else {
+            usage();
+            return 1;
+        }
+    }
+    if (pathCount == 0 || (synthesizeMode && pathCount != 2)) {
+        usage();
+        return 1;
+    }
+    if (synthesizeMode) return synthesize(paths[0], paths[1], events, seed, levels);
+
+    MappedFile messageFile(paths[0]);
+    if (!messageFile.is_open()) {
+        std::fprintf(stderr, "%s\n", messageFile.error().c_str());
+        return 1;
+    }
+    MappedFile orderbookFile(paths[1] ? paths[1] : "");
+    if (paths[1] && !orderbookFile.is_open()) {
+        std::fprintf(stderr, "%s\n", orderbookFile.error().c_str());
+        return 1;
+    }
+    messageFile.prefault();
+    if (paths[1]) orderbookFile.prefault();
+
+    // Parse only: the checksum keeps the parsed fields alive
+    auto start = SteadyClock::now();
+    Lobster::LineCursor cursor(chars(messageFile), messageFile.size());
+    Lobster::Message message;
+    const char* begin;
+    const char* stop;
+    uint64_t rows = 0, checksum = 0, malformed = 0;
+    while (cursor.next(begin, stop)) {
+        if (!Lobster::parseMessage(begin, stop, message)) {
+            ++malformed;
+            continue;
+        }
+        checksum += message.order_id ^ static_cast<uint64_t>(message.price) ^ message.size;
+        ++rows;
+    }
+    report("parse", rows, secondsSince(start));
+    std::printf("%-22s %llu malformed, checksum %llu\n", "",
+                static_cast<unsigned long long>(malformed), static_cast<unsigned long long>(checksum));
+
+    start = SteadyClock::now();
+    Lobster::Replayer replayer;
+    bool parsed = Lobster::replay(replayer, chars(messageFile), messageFile.size());
+    report("parse + book", replayer.counters().messages, secondsSince(start));
+
+    if (paths[1]) {
+        start = SteadyClock::now();
+        Lobster::Replayer validator;
+        parsed = Lobster::replay(validator, chars(messageFile), messageFile.size(),
+                                 chars(orderbookFile), orderbookFile.size()) && parsed;
+        report("parse + book + verify", validator.counters().rows_validated, secondsSince(start));
+
+        const auto& counters = validator.counters();
+        std::printf("validation             %llu of %llu rows mismatched, first at row %llu\n",
+                    static_cast<unsigned long long>(counters.mismatched_rows),
+                    static_cast<unsigned long long>(counters.rows_validated),
+                    static_cast<unsigned long long>(counters.first_mismatch));
+        std::printf("other                  %llu skipped, %llu seed adjustments, %llu unknown order references\n",
+                    static_cast<unsigned long long>(counters.skipped),
+                    static_cast<unsigned long long>(counters.seed_adjustments),
+                    static_cast<unsigned long long>(counters.unknown_orders));
+    }
+    if (!parsed) {
+        std::fprintf(stderr, "replay stopped at a malformed row\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include "../src/MemoryFootprint.h"
+#include "../src/OrderBook.h"
+#include "../src/OrderFlowGenerator.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+/**
+ * Standalone synthetic order-flow tool.
+ *
+ *   order_flow_gen [--events N] [--seed S] [--symbols K] [--skew Z] [--rate R]
+ *                  [--hawkes] [--marketable F] [--print] [--perf] [--memory] [--trace <dump> [--trace-slower NS]]
+ *
+ * Default: drives one OrderBook per symbol as fast as possible and reports
+ * throughput and book statistics. --marketable sets the share of limit prices that
+ * cross the reference (OrderFlowConfig::marketable_fraction). --print writes the events as CSV instead
+ * (time_ns,symbol,type,order_id,side,price,quantity) for replay elsewhere.
+ * --perf attributes hardware counters to book operations and prints them per op.
+ * --memory prints the memory footprint of every book (largest first) at the end.
+ * --trace records hot-path trace events and dumps the ring to <dump> at the end
+ * (or, with --trace-slower, on the first operation slower than NS; SIGUSR1 dumps
+ * at any time); convert it with trace2chrome.
+ */
+
+using namespace OrderEngine;
+using OrderPtr = std::shared_ptr<Order>;
+using Book = OrderBook<OrderPtr>;
+
+namespace {
+    void usage() {
+        std::fprintf(stderr, "usage: order_flow_gen [--events N] [--seed S] [--symbols K] [--skew Z] "
+                             "[--rate R] [--hawkes] [--marketable F] [--print] [--perf] [--memory] [--trace <dump> [--trace-slower NS]]\n");
+    }
+}
+
+int main(int argc, char** argv) {
+    OrderFlowConfig config;
+    size_t events = 1000000;
+    size_t symbols = 1;
+    bool print = false, perf = false, memory = false;
+    const char* tracePath = nullptr;
+    uint64_t traceSlowerNs = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (!std::strcmp(arg, "--events") && hasValue) events = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(arg, "--seed") && hasValue) config.seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(arg, "--symbols") && hasValue) symbols = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(arg, "--skew") && hasValue) config.symbol_skew = std::strtod(argv[++i], nullptr);
+        else if (!std::strcmp(arg, "--rate") && hasValue) config.event_rate = std::strtod(argv[++i], nullptr);
+        else if (!std::strcmp(arg, "--hawkes")) config.arrivals = OrderFlowConfig::Arrivals::HAWKES;
+        else if (!std::strcmp(arg, "--marketable") && hasValue) config.marketable_fraction = std::strtod(argv[++i], nullptr);
+        else if (!std::strcmp(arg, "--print")) print = true;
+        else if (!std::strcmp(arg, "--perf")) perf = true;
+        else if (!std::strcmp(arg, "--memory")) memory = true;
+        else if (!std::strcmp(arg, "--trace") && hasValue) tracePath = argv[++i];
+        else if (!std::strcmp(arg, "--trace-slower") && hasValue) traceSlowerNs = std::strtoull(argv[++i], nullptr, 10);
+        else {
+            usage();
+            return 1;
+        }
+    }
+
+    config.symbols.clear();
+    for (size_t i = 0; i < std::max<size_t>(symbols, 1); ++i) config.symbols.push_back("SYM" + std::to_string(i));
+    OrderFlowGenerator generator(config);
+
+    if (print) {
+        std::printf("time_ns,symbol,type,order_id,side,price,quantity\n");
+        for (size_t i = 0; i < events; ++i) {
+            FlowEvent event = generator.next();
+            std::printf("%lld,%s,%c,%llu,%c,%lld,%llu\n", static_cast<long long>(event.time_ns),
+                        config.symbols[event.symbol_index].c_str(), static_cast<char>(event.type),
+                        static_cast<unsigned long long>(event.order_id), static_cast<char>(event.side),
+                        static_cast<long long>(event.price), static_cast<unsigned long long>(event.quantity));
+        }
+        return 0;
+    }
+
+    std::vector<std::unique_ptr<Book>> books;
+    for (const auto& symbol : config.symbols) {
+        books.push_back(std::make_unique<Book>(symbol));
+        if (perf) books.back()->enablePerfCounters();
+    }
+
+    if (tracePath) {
+        Trace::enable();
+        Trace::dumpOnSignal(SIGUSR1, tracePath);
+        if (traceSlowerNs) Trace::dumpWhenSlower(traceSlowerNs, tracePath);
+    }
+
+    int64_t lastEventNs = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < events; ++i) {
+        FlowEvent event = generator.next();
+        applyFlowEvent(*books[event.symbol_index], event);
+        lastEventNs = event.time_ns;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    uint64_t trades = 0, volume = 0, cancels = 0, replaces = 0;
+    for (const auto& book : books) {
+        trades += book->stats().total_trades.load();
+        volume += book->stats().total_volume.load();
+        cancels += book->stats().total_orders_cancelled.load();
+        replaces += book->stats().total_orders_replaced.load();
+    }
+    std::printf("events        %zu (%zu symbols, %s arrivals, seed %llu)\n", events, config.symbols.size(),
+                config.arrivals == OrderFlowConfig::Arrivals::HAWKES ? "hawkes" : "poisson",
+                static_cast<unsigned long long>(config.seed));
+    std::printf("wall time     %.3f s, %.0f events/s (generation included)\n", seconds, events / seconds);
+    std::printf("trades        %llu, volume %llu\n", static_cast<unsigned long long>(trades),
+                static_cast<unsigned long long>(volume));
+    std::printf("cancels       %llu, replaces %llu\n", static_cast<unsigned long long>(cancels),
+                static_cast<unsigned long long>(replaces));
+    std::printf("flow duration %.3f s of simulated time\n", static_cast<double>(lastEventNs) * 1e-9);
+    if (perf) {
+        OrderBookPerf total;
+        for (const auto& book : books) total.merge(*book->perfCounters());
+        const auto& group = PerfCounterGroup::forThisThread();
+        std::printf("perf counters%s%s\n", group.error().empty() ? "" : ", unavailable: ", group.error().c_str());
+        std::fflush(stdout);
+        total.dump(std::cout);
+    }
+    if (memory) {
+        MemoryReport report;
+        for (const auto& book : books) report.add(book->symbol(), book->memoryFootprint());
+        std::printf("memory        %zu KB over %zu books\n", (report.total_bytes() + 1023) / 1024, report.books());
+        std::fputs(report.ToString(20).c_str(), stdout);
+    }
+    if (tracePath) {
+        if (!traceSlowerNs && !Trace::dump(tracePath)) {
+            std::fprintf(stderr, "cannot write %s\n", tracePath);
+            return 1;
+        }
+        std::printf("trace         %s%s\n", tracePath,
+                    traceSlowerNs && !Trace::breachDumps() ? " (threshold never breached, nothing written)" : "");
+    }
+    return 0;
+}
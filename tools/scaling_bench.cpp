@@ -0,0 +1,310 @@
+#include "../src/OrderBook.h"
+#include "../src/OrderFlowGenerator.h"
+#include "../src/ShardPlan.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <thread>
+#include <vector>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/**
+ * Multi-symbol, multi-thread throughput and scaling benchmark.
+ *
+ *   scaling_bench [--events N] [--symbols K] [--skew Z] [--seed S] [--hawkes]
+ *                 [--threads 1,2,4] [--no-pin] [--json <out.json>|-]
+ *
+ * One synthetic flow over K symbols (Zipf(Z) activity) is generated up front,
+ * then replayed once per matcher thread count M (default 1, 2, 4, ... up to all
+ * cores). Books are spread over the M threads by ShardPlan on their event
+ * counts; each thread builds and exclusively drives its own books, so nothing
+ * is shared but the start signal. Per run it reports aggregate orders/s (every
+ * order message: add, market, cancel, modify), speedup over the first run,
+ * per-thread utilisation (thread CPU time / wall time of the run: below 100%
+ * once its books are done, or when threads outnumber cores) and the
+ * per-message service time distribution, timed with RDTSC around each
+ * message (~20 ns of overhead included).
+ * --json writes the same results machine-readably for trend tracking.
+ */
+
+using namespace OrderEngine;
+using OrderPtr = std::shared_ptr<Order>;
+using Book = OrderBook<OrderPtr>;
+using SteadyClock = std::chrono::steady_clock;
+
+namespace {
+    struct Options {
+        size_t events = 2000000;
+        size_t symbols = 64;
+        std::vector<size_t> threads;
+        bool pin = true;
+        const char* jsonPath = nullptr;
+    };
+
+    // One matcher thread of a run
+    struct Worker {
+        std::vector<size_t> books;      // Symbol indexes owned by this thread
+        std::vector<uint32_t> events;   // Indexes into the flow, in arrival order
+        double activeSeconds = 0.0;     // Wall time from the start signal to its last message
+        double cpuSeconds = 0.0;        // CPU time of the thread over the same span
+        SteadyClock::time_point finished;
+        LatencyHistogram latency;       // TSC ticks per message
+    };
+
+    struct RunResult {
+        size_t threads = 0;
+        double wallSeconds = 0.0;
+        double planSpeedup = 1.0;
+        std::vector<std::unique_ptr<Worker>> workers;
+        LatencyHistogram latency;
+    };
+
+    void usage() {
+        std::fprintf(stderr, "usage: scaling_bench [--events N] [--symbols K] [--skew Z] [--seed S] [--hawkes] "
+                             "[--threads 1,2,4] [--no-pin] [--json <out.json>|-]\n");
+    }
+
+    std::vector<size_t> parseList(const char* text) {
+        std::vector<size_t> values;
+        for (const char* p = text; *p;) {
+            char* end = nullptr;
+            size_t value = std::strtoull(p, &end, 10);
+            if (end == p) break;
+            if (value > 0) values.push_back(value);
+            p = *end == ',' ? end + 1 : end;
+        }
+        return values;
+    }
+
+    // CPUs this process may run on, in order (pinning targets)
+    std::vector<int> usableCpus() {
+        std::vector<int> cpus;
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+            }
+        }
+#endif
+        if (cpus.empty()) {
+            for (unsigned i = 0; i < std::max(1u, std::thread::hardware_concurrency()); ++i) cpus.push_back(static_cast<int>(i));
+        }
+        return cpus;
+    }
+
+    void pinTo(int cpu) {
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+        (void)cpu;
+#endif
+    }
+
+    double threadCpuSeconds() {
+        timespec now{};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+        return static_cast<double>(now.tv_sec) + static_cast<double>(now.tv_nsec) * 1e-9;
+    }
+
+    void runWorker(Worker& worker, const OrderFlowConfig& config, const std::vector<FlowEvent>& flow,
+                   std::atomic<size_t>& ready, const std::atomic<bool>& go, int cpu) {
+        if (cpu >= 0) pinTo(cpu);
+        // Built here so book memory is first touched by the thread (and node) that uses it
+        std::vector<std::unique_ptr<Book>> books(config.symbols.size());
+        for (size_t symbol : worker.books) books[symbol] = std::make_unique<Book>(config.symbols[symbol]);
+
+        ready.fetch_add(1, std::memory_order_release);
+        while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+
+        auto start = SteadyClock::now();
+        double cpuStart = threadCpuSeconds();
+        for (uint32_t index : worker.events) {
+            const FlowEvent& event = flow[index];
+            uint64_t begin = Tsc::now();
+            applyFlowEvent(*books[event.symbol_index], event);
+            worker.latency.record(Tsc::now() - begin);
+        }
+        worker.finished = SteadyClock::now();
+        worker.cpuSeconds = threadCpuSeconds() - cpuStart;
+        worker.activeSeconds = std::chrono::duration<double>(worker.finished - start).count();
+    }
+
+    std::unique_ptr<RunResult> run(size_t threads, const OrderFlowConfig& config, const std::vector<FlowEvent>& flow,
+                                   const std::vector<double>& activity, const std::vector<int>& cpus, bool pin) {
+        auto result = std::make_unique<RunResult>();
+        result->threads = threads;
+        ShardPlan plan(activity, threads);
+        result->planSpeedup = plan.max_speedup();
+        for (size_t t = 0; t < threads; ++t) {
+            result->workers.push_back(std::make_unique<Worker>());
+            result->workers.back()->books = plan.books(t);
+            result->workers.back()->events.reserve(static_cast<size_t>(plan.load(t)));
+        }
+        for (size_t i = 0; i < flow.size(); ++i) {
+            result->workers[plan.owner(flow[i].symbol_index)]->events.push_back(static_cast<uint32_t>(i));
+        }
+
+        std::atomic<size_t> ready{0};
+        std::atomic<bool> go{false};
+        std::vector<std::thread> pool;
+        for (size_t t = 0; t < threads; ++t) {
+            int cpu = pin ? cpus[t % cpus.size()] : -1;
+            pool.emplace_back(runWorker, std::ref(*result->workers[t]), std::cref(config), std::cref(flow),
+                              std::ref(ready), std::cref(go), cpu);
+        }
+        while (ready.load(std::memory_order_acquire) < threads) std::this_thread::yield();
+        auto start = SteadyClock::now();
+        go.store(true, std::memory_order_release);
+        for (auto& thread : pool) thread.join();
+
+        SteadyClock::time_point end = start;
+        for (const auto& worker : result->workers) {
+            end = std::max(end, worker->finished);
+            result->latency.merge(worker->latency);
+        }
+        result->wallSeconds = std::chrono::duration<double>(end - start).count();
+        return result;
+    }
+
+    double ratePerSecond(size_t count, double seconds) {
+        return seconds > 0.0 ? static_cast<double>(count) / seconds : 0.0;
+    }
+
+    void printRun(const RunResult& result, size_t events, double baseRate) {
+        double rate = ratePerSecond(events, result.wallSeconds);
+        LatencyHistogram::Summary s = result.latency.summary();
+        std::printf("%7zu %12.0f %8.2fx %8.2fx %9llu %9llu %9llu %9llu\n", result.threads, rate,
+                    baseRate > 0.0 ? rate / baseRate : 1.0, result.planSpeedup,
+                    static_cast<unsigned long long>(Tsc::to_ns(s.p50)), static_cast<unsigned long long>(Tsc::to_ns(s.p99)),
+                    static_cast<unsigned long long>(Tsc::to_ns(s.p999)), static_cast<unsigned long long>(Tsc::to_ns(s.max)));
+        for (size_t t = 0; t < result.workers.size(); ++t) {
+            const Worker& worker = *result.workers[t];
+            std::printf("        thread %-3zu %4zu books %10zu msgs  active %7.3f s  cpu %7.3f s  util %5.1f%%\n", t,
+                        worker.books.size(), worker.events.size(), worker.activeSeconds, worker.cpuSeconds,
+                        result.wallSeconds > 0.0 ? 100.0 * worker.cpuSeconds / result.wallSeconds : 0.0);
+        }
+    }
+
+    void writeLatency(FILE* out, const LatencyHistogram& histogram) {
+        LatencyHistogram::Summary s = histogram.summary();
+        std::fprintf(out, "{\"count\":%llu,\"mean\":%llu,\"p50\":%llu,\"p90\":%llu,\"p99\":%llu,\"p999\":%llu,\"max\":%llu}",
+                     static_cast<unsigned long long>(s.count), static_cast<unsigned long long>(Tsc::to_ns(s.mean)),
+                     static_cast<unsigned long long>(Tsc::to_ns(s.p50)), static_cast<unsigned long long>(Tsc::to_ns(s.p90)),
+                     static_cast<unsigned long long>(Tsc::to_ns(s.p99)), static_cast<unsigned long long>(Tsc::to_ns(s.p999)),
+                     static_cast<unsigned long long>(Tsc::to_ns(s.max)));
+    }
+
+    bool writeJson(const char* path, const OrderFlowConfig& config, size_t events, size_t cores,
+                   const std::vector<std::unique_ptr<RunResult>>& runs) {
+        FILE* out = std::strcmp(path, "-") == 0 ? stdout : std::fopen(path, "w");
+        if (!out) return false;
+        std::fprintf(out, "{\"benchmark\":\"scaling_bench\",\"config\":{\"events\":%zu,\"symbols\":%zu,\"skew\":%.3f,"
+                          "\"arrivals\":\"%s\",\"seed\":%llu,\"cores\":%zu},\"latency_unit\":\"ns\",\"runs\":[",
+                     events, config.symbols.size(), config.symbol_skew,
+                     config.arrivals == OrderFlowConfig::Arrivals::HAWKES ? "hawkes" : "poisson",
+                     static_cast<unsigned long long>(config.seed), cores);
+        double baseRate = runs.empty() ? 0.0 : ratePerSecond(events, runs.front()->wallSeconds);
+        for (size_t r = 0; r < runs.size(); ++r) {
+            const RunResult& result = *runs[r];
+            double rate = ratePerSecond(events, result.wallSeconds);
+            std::fprintf(out, "%s\n{\"threads\":%zu,\"wall_s\":%.6f,\"orders_per_s\":%.0f,\"speedup\":%.4f,"
+                              "\"plan_max_speedup\":%.4f,\"latency\":",
+                         r ? "," : "", result.threads, result.wallSeconds, rate,
+                         baseRate > 0.0 ? rate / baseRate : 1.0, result.planSpeedup);
+            writeLatency(out, result.latency);
+            std::fprintf(out, ",\"per_thread\":[");
+            for (size_t t = 0; t < result.workers.size(); ++t) {
+                const Worker& worker = *result.workers[t];
+                std::fprintf(out, "%s{\"books\":%zu,\"orders\":%zu,\"active_s\":%.6f,\"cpu_s\":%.6f,\"utilisation\":%.4f,"
+                                  "\"orders_per_cpu_s\":%.0f,\"latency\":",
+                             t ? "," : "", worker.books.size(), worker.events.size(), worker.activeSeconds, worker.cpuSeconds,
+                             result.wallSeconds > 0.0 ? worker.cpuSeconds / result.wallSeconds : 0.0,
+                             ratePerSecond(worker.events.size(), worker.cpuSeconds));
+                writeLatency(out, worker.latency);
+                std::fprintf(out, "}");
+            }
+            std::fprintf(out, "]}");
+        }
+        std::fprintf(out, "\n]}\n");
+        return out == stdout ? std::fflush(out) == 0 : std::fclose(out) == 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    OrderFlowConfig config;
+    config.seed = 2024;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (!std::strcmp(arg, "--events") && hasValue) options.events = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(arg, "--symbols") && hasValue) options.symbols = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(arg, "--skew") && hasValue) config.symbol_skew = std::strtod(argv[++i], nullptr);
+        else if (!std::strcmp(arg, "--seed") && hasValue) config.seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(arg, "--hawkes")) config.arrivals = OrderFlowConfig::Arrivals::HAWKES;
+        else if (!std::strcmp(arg, "--threads") && hasValue) options.threads = parseList(argv[++i]);
+        else if (!std::strcmp(arg, "--no-pin")) options.pin = false;
+        else if (!std::strcmp(arg, "--json") && hasValue) options.jsonPath = argv[++i];
+        else {
+            usage();
+            return 1;
+        }
+    }
+    if (options.events == 0 || options.events > UINT32_MAX) {
+        std::fprintf(stderr, "--events must be between 1 and %u\n", UINT32_MAX);
+        return 1;
+    }
+
+    std::vector<int> cpus = usableCpus();
+    if (options.threads.empty()) {
+        for (size_t m = 1; m < cpus.size(); m *= 2) options.threads.push_back(m);
+        options.threads.push_back(cpus.size());
+    }
+
+    config.symbols.clear();
+    for (size_t i = 0; i < std::max<size_t>(options.symbols, 1); ++i) config.symbols.push_back("SYM" + std::to_string(i));
+    std::vector<FlowEvent> flow = OrderFlowGenerator(config).generate(options.events);
+    std::vector<double> activity(config.symbols.size(), 0.0);
+    for (const auto& event : flow) activity[event.symbol_index] += 1.0;
+    Tsc::ticks_per_ns(); // Calibrate before any timed run
+
+    // A JSON document on stdout replaces the table
+    bool table = !options.jsonPath || std::strcmp(options.jsonPath, "-") != 0;
+    if (table) {
+        std::printf("%zu order messages over %zu symbols (zipf %.2f, %s), %zu usable cores%s\n", flow.size(),
+                    config.symbols.size(), config.symbol_skew,
+                    config.arrivals == OrderFlowConfig::Arrivals::HAWKES ? "hawkes" : "poisson", cpus.size(),
+                    options.pin ? ", pinned" : "");
+        std::printf("%7s %12s %9s %9s %9s %9s %9s %9s\n", "threads", "orders/s", "speedup", "plan max",
+                    "p50 ns", "p99 ns", "p99.9 ns", "max ns");
+    }
+
+    std::vector<std::unique_ptr<RunResult>> runs;
+    for (size_t threads : options.threads) {
+        runs.push_back(run(threads, config, flow, activity, cpus, options.pin));
+        if (table) {
+            printRun(*runs.back(), flow.size(), ratePerSecond(flow.size(), runs.front()->wallSeconds));
+            std::fflush(stdout);
+        }
+    }
+
+    if (options.jsonPath && !writeJson(options.jsonPath, config, flow.size(), cpus.size(), runs)) {
+        std::fprintf(stderr, "cannot write %s\n", options.jsonPath);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include "../src/TraceRing.h"
+#include <cinttypes>
+#include <cstdio>
+
+/**
+ * Trace dump to Chrome trace JSON.
+ *
+ *   trace2chrome <dump> [<out.json>]
+ *       Reads a dump written by Trace::dump / dumpOnSignal / dumpWhenSlower and
+ *       writes the Trace Event Format (open in chrome://tracing or Perfetto),
+ *       one track per traced thread. Timestamps are microseconds since the
+ *       oldest record. END records whose BEGIN was overwritten by the ring are
+ *       dropped; scopes still open at dump time are left unterminated.
+ */
+
+using namespace OrderEngine;
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        std::fprintf(stderr, "usage: trace2chrome <dump> [<out.json>]\n");
+        return 1;
+    }
+    Trace::DumpFile dump;
+    if (!Trace::readDump(argv[1], dump)) {
+        std::fprintf(stderr, "cannot read trace dump %s\n", argv[1]);
+        return 1;
+    }
+    FILE* out = argc == 3 ? std::fopen(argv[2], "w") : stdout;
+    if (!out) {
+        std::fprintf(stderr, "cannot write %s\n", argv[2]);
+        return 1;
+    }
+
+    uint64_t origin = UINT64_MAX;
+    for (const auto& thread : dump.threads) {
+        if (!thread.records.empty()) origin = std::min(origin, thread.records.front().tsc);
+    }
+
+    uint64_t events = 0;
+    bool first = true;
+    std::fprintf(out, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    for (const auto& thread : dump.threads) {
+        std::fprintf(out, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"trace thread %u\"}}",
+                     first ? "" : ",\n", thread.thread_index, thread.thread_index);
+        first = false;
+        size_t open = 0;
+        for (const auto& record : thread.records) {
+            if (record.phase() == Trace::Phase::END) {
+                if (open == 0) continue;
+                --open;
+            }
+            else if (record.phase() == Trace::Phase::BEGIN) {
+                ++open;
+            }
+            double us = static_cast<double>(record.tsc - origin) / dump.ticks_per_ns / 1000.0;
+            std::fprintf(out, ",\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%u",
+                         Trace::eventName(record.event()), static_cast<char>(record.phase()), us, thread.thread_index);
+            if (record.phase() == Trace::Phase::INSTANT) std::fprintf(out, ",\"s\":\"t\"");
+            if (record.phase() != Trace::Phase::END) {
+                std::fprintf(out, ",\"args\":{\"event\":%u,\"id\":%" PRIu64 ",\"arg\":%" PRIu64 "}",
+                             static_cast<unsigned>(record.event()), record.id, record.argument());
+            }
+            std::fprintf(out, "}");
+            ++events;
+        }
+    }
+    std::fprintf(out, "\n]}\n");
+    if (out != stdout) {
+        std::fclose(out);
+        std::fprintf(stderr, "wrote %" PRIu64 " events from %zu threads to %s\n", events, dump.threads.size(), argv[2]);
+    }
+    return 0;
+}